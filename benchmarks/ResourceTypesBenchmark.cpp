@@ -0,0 +1,102 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "../src/core/NetworkManager.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QVector>
+
+using namespace Otter;
+
+int main(int argc, char *argv[])
+{
+	const QString corpusPath((argc > 1) ? QString::fromLocal8Bit(argv[1]) : QLatin1String(OTTER_BENCHMARK_CORPUS));
+	const int passes((argc > 2) ? QByteArray(argv[2]).toInt() : 10000);
+	QFile file(corpusPath);
+
+	if (passes <= 0 || !file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		QTextStream(stderr) << "Usage: " << argv[0] << " [corpus] [passes]\n";
+
+		return 1;
+	}
+
+	QVector<QByteArray> acceptHeaders;
+	QVector<QString> paths;
+
+	while (!file.atEnd())
+	{
+		const QByteArray line(file.readLine().trimmed());
+
+		if (line.isEmpty() || line.startsWith('#'))
+		{
+			continue;
+		}
+
+		const int separatorPosition(line.indexOf('\t'));
+
+		acceptHeaders.append((separatorPosition < 0) ? line : line.left(separatorPosition));
+		paths.append((separatorPosition < 0) ? QString() : QString::fromUtf8(line.mid(separatorPosition + 1)));
+	}
+
+	if (acceptHeaders.isEmpty())
+	{
+		QTextStream(stderr) << "No requests found in " << corpusPath << '\n';
+
+		return 1;
+	}
+
+	const qint64 calls(static_cast<qint64>(passes) * acceptHeaders.count());
+	QElapsedTimer timer;
+	qint64 checksum(0);
+
+	timer.start();
+
+	for (int i = 0; i < passes; ++i)
+	{
+		for (int j = 0; j < acceptHeaders.count(); ++j)
+		{
+			checksum += NetworkManager::getAcceptResourceType(acceptHeaders.at(j));
+		}
+	}
+
+	const qint64 acceptDuration(timer.nsecsElapsed());
+
+	timer.restart();
+
+	for (int i = 0; i < passes; ++i)
+	{
+		for (int j = 0; j < paths.count(); ++j)
+		{
+			checksum += NetworkManager::getPathResourceType(paths.at(j));
+		}
+	}
+
+	const qint64 pathDuration(timer.nsecsElapsed());
+	QTextStream stream(stdout);
+	stream << "Corpus: " << corpusPath << " (" << acceptHeaders.count() << " requests)\n";
+	stream << "Calls: " << calls << '\n';
+	stream << "getAcceptResourceType(): " << (static_cast<double>(acceptDuration) / calls) << " ns per call\n";
+	stream << "getPathResourceType(): " << (static_cast<double>(pathDuration) / calls) << " ns per call\n";
+	stream << "Checksum: " << checksum << '\n';
+
+	return 0;
+}
@@ -38,7 +38,6 @@ QHash<QString, AdblockContentFiltersProfile::RuleOption> AdblockContentFiltersPr
 QHash<NetworkManager::ResourceType, AdblockContentFiltersProfile::RuleOption> AdblockContentFiltersProfile::m_resourceTypes({{NetworkManager::ImageType, ImageOption}, {NetworkManager::ScriptType, ScriptOption}, {NetworkManager::StyleSheetType, StyleSheetOption}, {NetworkManager::ObjectType, ObjectOption}, {NetworkManager::XmlHttpRequestType, XmlHttpRequestOption}, {NetworkManager::SubFrameType, SubDocumentOption},{NetworkManager::PopupType, PopupOption}, {NetworkManager::ObjectSubrequestType, ObjectSubRequestOption}, {NetworkManager::WebSocketType, WebSocketOption}});
 
 AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, const QDateTime &lastUpdate, const QStringList &languages, int updateInterval, const ProfileCategory &category, const ProfileFlags &flags, QObject *parent) : ContentFiltersProfile(parent),
-	m_root(nullptr),
 	m_dataFetchJob(nullptr),
 	m_name(name),
 	m_title(title),
@@ -66,6 +65,24 @@ AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QString &name,
 	loadHeader();
 }
 
+AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QString &name) : ContentFiltersProfile(),
+	m_root(new Node(), [](Node *node)
+	{
+		QtConcurrent::run(&AdblockContentFiltersProfile::deleteNode, node, false);
+	}),
+	m_dataFetchJob(nullptr),
+	m_name(name),
+	m_domainExpression(QLatin1String("[:\?&/=]")),
+	m_category(OtherCategory),
+	m_error(NoError),
+	m_flags(NoFlags),
+	m_updateInterval(0),
+	m_isEmpty(false),
+	m_wasLoaded(true)
+{
+	m_domainExpression.optimize();
+}
+
 void AdblockContentFiltersProfile::clear()
 {
 	if (!m_wasLoaded)
@@ -73,10 +90,7 @@ void AdblockContentFiltersProfile::clear()
 		return;
 	}
 
-	if (m_root)
-	{
-		QtConcurrent::run(this, &AdblockContentFiltersProfile::deleteNode, m_root);
-	}
+	m_root.clear();
 
 	m_cosmeticFiltersRules.clear();
 	m_cosmeticFiltersDomainExceptions.clear();
@@ -285,7 +299,7 @@ void AdblockContentFiltersProfile::parseStyleSheetRule(const QStringList &line,
 
 void AdblockContentFiltersProfile::addRule(ContentBlockingRule *rule, const QString &ruleString) const
 {
-	Node *node(m_root);
+	Node *node(m_root.data());
 
 	for (int i = 0; i < ruleString.length(); ++i)
 	{
@@ -327,19 +341,40 @@ void AdblockContentFiltersProfile::addRule(ContentBlockingRule *rule, const QStr
 	node->rules.append(rule);
 }
 
-void AdblockContentFiltersProfile::deleteNode(Node *node) const
+void AdblockContentFiltersProfile::shareRules(const Node *node, const QString &ruleString, int profile, QHash<QString, ContentBlockingRule*> *rules)
 {
-	for (int i = 0; i < node->children.count(); ++i)
+	for (int i = 0; i < node->rules.count(); ++i)
 	{
-		deleteNode(node->children.at(i));
+		ContentBlockingRule *rule(node->rules.at(i));
+
+		if (!rule)
+		{
+			continue;
+		}
+
+		const ContentBlockingRule *sharedRule(rules->value(rule->rule));
+
+		if (sharedRule)
+		{
+			if (!sharedRule->isException)
+			{
+				m_ruleProfiles[sharedRule] = profile;
+			}
+
+			continue;
+		}
+
+		rules->insert(rule->rule, rule);
+
+		m_ruleProfiles[rule] = profile;
+
+		addRule(rule, ruleString);
 	}
 
-	for (int i = 0; i < node->rules.count(); ++i)
+	for (int i = 0; i < node->children.count(); ++i)
 	{
-		delete node->rules.at(i);
+		shareRules(node->children.at(i), (ruleString + node->children.at(i)->value), profile, rules);
 	}
-
-	delete node;
 }
 
 ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstring(const Node *node, const QString &subString, QString currentRule, NetworkManager::ResourceType resourceType)
@@ -354,13 +389,9 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstri
 
 		currentResult = evaluateRulesInNode(node, currentRule, resourceType);
 
-		if (currentResult.isBlocked)
-		{
-			result = currentResult;
-		}
-		else if (currentResult.isException)
+		if (mergeResult(&result, currentResult))
 		{
-			return currentResult;
+			return result;
 		}
 
 		for (int j = 0; j < node->children.count(); ++j)
@@ -375,13 +406,9 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstri
 				{
 					currentResult = checkUrlSubstring(nextNode, wildcardSubString.right(wildcardSubString.length() - k), (currentRule + wildcardSubString.left(k)), resourceType);
 
-					if (currentResult.isBlocked)
-					{
-						result = currentResult;
-					}
-					else if (currentResult.isException)
+					if (mergeResult(&result, currentResult))
 					{
-						return currentResult;
+						return result;
 					}
 				}
 			}
@@ -390,13 +417,9 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstri
 			{
 				currentResult = checkUrlSubstring(nextNode, subString.mid(i), currentRule, resourceType);
 
-				if (currentResult.isBlocked)
+				if (mergeResult(&result, currentResult))
 				{
-					result = currentResult;
-				}
-				else if (currentResult.isException)
-				{
-					return currentResult;
+					return result;
 				}
 			}
 
@@ -420,13 +443,9 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstri
 
 	currentResult = evaluateRulesInNode(node, currentRule, resourceType);
 
-	if (currentResult.isBlocked)
-	{
-		result = currentResult;
-	}
-	else if (currentResult.isException)
+	if (mergeResult(&result, currentResult))
 	{
-		return currentResult;
+		return result;
 	}
 
 	for (int i = 0; i < node->children.count(); ++i)
@@ -435,13 +454,9 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrlSubstri
 		{
 			currentResult = evaluateRulesInNode(node, currentRule, resourceType);
 
-			if (currentResult.isBlocked)
+			if (mergeResult(&result, currentResult))
 			{
-				result = currentResult;
-			}
-			else if (currentResult.isException)
-			{
-				return currentResult;
+				return result;
 			}
 		}
 	}
@@ -552,6 +567,7 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkRuleMatch(
 	{
 		ContentFiltersManager::CheckResult result;
 		result.rule = rule->rule;
+		result.profile = m_ruleProfiles.value(rule, -1);
 
 		if (rule->isException)
 		{
@@ -664,6 +680,7 @@ void AdblockContentFiltersProfile::handleJobFinished(bool isSuccess)
 		loadRules();
 	}
 
+	emit rulesModified();
 	emit profileModified();
 }
 
@@ -734,6 +751,42 @@ QUrl AdblockContentFiltersProfile::getUpdateUrl() const
 	return m_updateUrl;
 }
 
+QFuture<AdblockContentFiltersProfile*> AdblockContentFiltersProfile::createCombinedProfile(const QVector<QPair<int, AdblockContentFiltersProfile*> > &profiles)
+{
+	QStringList names;
+	names.reserve(profiles.count());
+
+	QVector<QPair<int, QSharedPointer<Node> > > roots;
+	roots.reserve(profiles.count());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		AdblockContentFiltersProfile *profile(profiles.at(i).second);
+
+		names.append(profile->getName());
+
+		if ((profile->m_wasLoaded || profile->loadRules()) && profile->m_root)
+		{
+			roots.append({profiles.at(i).first, profile->m_root});
+		}
+	}
+
+	AdblockContentFiltersProfile *combinedProfile(new AdblockContentFiltersProfile(names.join(QLatin1Char('+'))));
+
+	return QtConcurrent::run([=]() -> AdblockContentFiltersProfile*
+	{
+		QHash<QString, ContentBlockingRule*> rules;
+
+		for (int i = 0; i < roots.count(); ++i)
+		{
+			combinedProfile->m_sharedRoots.append(roots.at(i).second);
+			combinedProfile->shareRules(roots.at(i).second.data(), {}, roots.at(i).first, &rules);
+		}
+
+		return combinedProfile;
+	});
+}
+
 ContentFiltersManager::CheckResult AdblockContentFiltersProfile::evaluateRulesInNode(const Node *node, const QString &currentRule, NetworkManager::ResourceType resourceType) const
 {
 	ContentFiltersManager::CheckResult result;
@@ -742,15 +795,11 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::evaluateRulesIn
 	{
 		if (node->rules.at(i))
 		{
-			ContentFiltersManager::CheckResult currentResult(checkRuleMatch(node->rules.at(i), currentRule, resourceType));
+			const ContentFiltersManager::CheckResult currentResult(checkRuleMatch(node->rules.at(i), currentRule, resourceType));
 
-			if (currentResult.isBlocked)
-			{
-				result = currentResult;
-			}
-			else if (currentResult.isException)
+			if (mergeResult(&result, currentResult))
 			{
-				return currentResult;
+				return result;
 			}
 		}
 	}
@@ -778,15 +827,11 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkUrl(const
 
 	for (int i = 0; i < m_requestUrl.length(); ++i)
 	{
-		const ContentFiltersManager::CheckResult currentResult(checkUrlSubstring(m_root, m_requestUrl.right(m_requestUrl.length() - i), {}, resourceType));
+		const ContentFiltersManager::CheckResult currentResult(checkUrlSubstring(m_root.data(), m_requestUrl.right(m_requestUrl.length() - i), {}, resourceType));
 
-		if (currentResult.isBlocked)
-		{
-			result = currentResult;
-		}
-		else if (currentResult.isException)
+		if (mergeResult(&result, currentResult))
 		{
-			return currentResult;
+			return result;
 		}
 	}
 
@@ -871,7 +916,10 @@ bool AdblockContentFiltersProfile::loadRules()
 	QTextStream stream(&file);
 	stream.readLine(); // header
 
-	m_root = new Node();
+	m_root = QSharedPointer<Node>(new Node(), [](Node *node)
+	{
+		QtConcurrent::run(&AdblockContentFiltersProfile::deleteNode, node, true);
+	});
 
 	while (!stream.atEnd())
 	{
@@ -948,6 +996,44 @@ bool AdblockContentFiltersProfile::resolveDomainExceptions(const QString &url, c
 	return false;
 }
 
+void AdblockContentFiltersProfile::deleteNode(Node *node, bool deleteRules)
+{
+	for (int i = 0; i < node->children.count(); ++i)
+	{
+		deleteNode(node->children.at(i), deleteRules);
+	}
+
+	if (deleteRules)
+	{
+		for (int i = 0; i < node->rules.count(); ++i)
+		{
+			delete node->rules.at(i);
+		}
+	}
+
+	delete node;
+}
+
+bool AdblockContentFiltersProfile::mergeResult(ContentFiltersManager::CheckResult *result, const ContentFiltersManager::CheckResult &currentResult)
+{
+	if (currentResult.isException)
+	{
+		if (!result->isException || currentResult.profile < result->profile)
+		{
+			*result = currentResult;
+		}
+
+		return (result->profile <= 0);
+	}
+
+	if (currentResult.isBlocked && !result->isException && currentResult.profile >= result->profile)
+	{
+		*result = currentResult;
+	}
+
+	return false;
+}
+
 bool AdblockContentFiltersProfile::isUpdating() const
 {
 	return (m_dataFetchJob != nullptr);
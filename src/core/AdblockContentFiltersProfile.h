@@ -24,6 +24,7 @@
 
 #include "ContentFiltersManager.h"
 
+#include <QtCore/QFuture>
 #include <QtCore/QRegularExpression>
 
 namespace Otter
@@ -59,6 +60,8 @@ public:
 	bool remove() override;
 	bool isUpdating() const override;
 
+	static QFuture<AdblockContentFiltersProfile*> createCombinedProfile(const QVector<QPair<int, AdblockContentFiltersProfile*> > &profiles);
+
 protected:
 	enum RuleOption : quint32
 	{
@@ -117,24 +120,28 @@ protected:
 		QVarLengthArray<ContentBlockingRule*, 1> rules;
 	};
 
+	explicit AdblockContentFiltersProfile(const QString &name);
+
 	QString getPath() const;
 	void loadHeader();
 	void parseRuleLine(const QString &rule);
 	void parseStyleSheetRule(const QStringList &line, QMultiHash<QString, QString> &list) const;
 	void addRule(ContentBlockingRule *rule, const QString &ruleString) const;
-	void deleteNode(Node *node) const;
+	void shareRules(const Node *node, const QString &ruleString, int profile, QHash<QString, ContentBlockingRule*> *rules);
 	ContentFiltersManager::CheckResult checkUrlSubstring(const Node *node, const QString &subString, QString currentRule, NetworkManager::ResourceType resourceType);
 	ContentFiltersManager::CheckResult checkRuleMatch(const ContentBlockingRule *rule, const QString &currentRule, NetworkManager::ResourceType resourceType) const;
 	ContentFiltersManager::CheckResult evaluateRulesInNode(const Node *node, const QString &currentRule, NetworkManager::ResourceType resourceType) const;
 	bool loadRules();
 	bool resolveDomainExceptions(const QString &url, const QStringList &ruleList) const;
+	static void deleteNode(Node *node, bool deleteRules);
+	static bool mergeResult(ContentFiltersManager::CheckResult *result, const ContentFiltersManager::CheckResult &currentResult);
 
 protected slots:
 	void raiseError(const QString &message, ProfileError error);
 	void handleJobFinished(bool isSuccess);
 
 private:
-	Node *m_root;
+	QSharedPointer<Node> m_root;
 	DataFetchJob *m_dataFetchJob;
 	QString m_requestUrl;
 	QString m_requestHost;
@@ -146,6 +153,8 @@ private:
 	QRegularExpression m_domainExpression;
 	QStringList m_cosmeticFiltersRules;
 	QVector<QLocale::Language> m_languages;
+	QVector<QSharedPointer<Node> > m_sharedRoots;
+	QHash<const ContentBlockingRule*, int> m_ruleProfiles;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainRules;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainExceptions;
 	ProfileCategory m_category;
@@ -26,6 +26,7 @@
 #include "GesturesManager.h"
 #include "HandlersManager.h"
 #include "HistoryManager.h"
+#include "Job.h"
 #include "LongTermTimer.h"
 #include "Migrator.h"
 #include "NetworkManagerFactory.h"
@@ -34,8 +35,10 @@
 #include "PasswordsManager.h"
 #include "PlatformIntegration.h"
 #include "SearchEnginesManager.h"
+#include "SearchSuggester.h"
 #include "SettingsManager.h"
 #include "SpellCheckManager.h"
+#include "StartupManager.h"
 #include "ToolBarsManager.h"
 #include "ThemesManager.h"
 #include "TransfersManager.h"
@@ -61,6 +64,7 @@
 #include "../ui/Window.h"
 
 #include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -69,9 +73,9 @@
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtGui/QDesktopServices>
-#include <QtNetwork/QLocalSocket>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QPushButton>
@@ -105,6 +109,8 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 
 	m_instance = this;
 
+	StartupManager::createInstance();
+
 	QString profilePath(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + QLatin1String("/otter"));
 	QString cachePath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
 
@@ -136,6 +142,7 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("new-private-window"), translate("main", "Loads URL in new private window")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("readonly"), translate("main", "Tells application to avoid writing data to disk")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("report"), translate("main", "Prints out diagnostic report and exits application")));
+	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("startup-timeline"), translate("main", "Prints out startup timeline once application finished loading")));
 
 	QStringList arguments(this->arguments());
 	QString argumentsPath(QDir::current().filePath(QLatin1String("arguments.txt")));
@@ -254,6 +261,11 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 			{
 				reportOptions |= SettingsReport;
 			}
+
+			if (rawReportOptions.contains(QLatin1String("network")))
+			{
+				reportOptions |= NetworkReport;
+			}
 		}
 
 		if (rawReportOptions.contains(QLatin1String("dialog")))
@@ -280,24 +292,27 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 
 	if (socket.waitForConnected(500))
 	{
-		const QStringList decodedArguments(arguments);
-		QStringList encodedArguments;
-		encodedArguments.reserve(decodedArguments.count());
-
 #ifdef Q_OS_WIN
 		AllowSetForegroundWindow(ASFW_ANY);
 #endif
 
-		for (int i = 0; i < decodedArguments.count(); ++i)
+		QByteArray payload;
+		QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+		payloadStream.setVersion(QDataStream::Qt_5_6);
+		payloadStream << arguments;
+
+		QDataStream stream(&socket);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << payload;
+
+		socket.flush();
+
+		if (socket.waitForBytesWritten(1000))
 		{
-			encodedArguments.append(decodedArguments.at(i).toUtf8().toBase64());
+			socket.waitForReadyRead(1000);
 		}
 
-		QTextStream stream(&socket);
-		stream << encodedArguments.join(QLatin1Char(' ')).toUtf8().toBase64();
-		stream.flush();
-
-		socket.waitForBytesWritten();
+		socket.disconnectFromServer();
 
 		return;
 	}
@@ -403,37 +418,38 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 		return;
 	}
 
-	ThemesManager::createInstance();
+	StartupManager::markMilestone(QLatin1String("Profile ready"));
 
-	ActionsManager::createInstance();
-
-	AddonsManager::createInstance();
+	BookmarksModel::preloadBookmarks(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
+	StartupManager::preloadFile(SessionsManager::getWritableDataPath(QLatin1String("browsingHistory.json")));
+	StartupManager::preloadFile(SessionsManager::getWritableDataPath(QLatin1String("typedHistory.json")));
+	StartupManager::preloadFile(SessionsManager::getWritableDataPath(QLatin1String("feeds.json")));
+	StartupManager::preloadFile(SessionsManager::getWritableDataPath(QLatin1String("feeds.opml")));
 
-	BookmarksManager::createInstance();
+	const QStringList searchEngines(SettingsManager::getOption(SettingsManager::Search_SearchEnginesOrderOption).toStringList());
 
-	FeedsManager::createInstance();
-
-	GesturesManager::createInstance();
-
-	HandlersManager::createInstance();
-
-	HistoryManager::createInstance();
-
-	NetworkManagerFactory::createInstance();
-
-	NotesManager::createInstance();
-
-	NotificationsManager::createInstance();
-
-	PasswordsManager::createInstance();
-
-	SearchEnginesManager::createInstance();
-
-	SpellCheckManager::createInstance();
-
-	ToolBarsManager::createInstance();
+	for (int i = 0; i < searchEngines.count(); ++i)
+	{
+		StartupManager::preloadFile(SessionsManager::getReadableDataPath(QLatin1String("searchEngines/") + searchEngines.at(i) + QLatin1String(".xml")));
+	}
 
-	TransfersManager::createInstance();
+	StartupManager::addTask(QLatin1String("ThemesManager"), &ThemesManager::createInstance);
+	StartupManager::addTask(QLatin1String("ActionsManager"), &ActionsManager::createInstance);
+	StartupManager::addTask(QLatin1String("AddonsManager"), &AddonsManager::createInstance, {QLatin1String("ThemesManager")});
+	StartupManager::addTask(QLatin1String("BookmarksManager"), &BookmarksManager::createInstance);
+	StartupManager::addTask(QLatin1String("FeedsManager"), &FeedsManager::createInstance);
+	StartupManager::addTask(QLatin1String("GesturesManager"), &GesturesManager::createInstance, {QLatin1String("ActionsManager")});
+	StartupManager::addTask(QLatin1String("HistoryManager"), &HistoryManager::createInstance);
+	StartupManager::addTask(QLatin1String("NetworkManagerFactory"), &NetworkManagerFactory::createInstance);
+	StartupManager::addTask(QLatin1String("NotificationsManager"), &NotificationsManager::createInstance);
+	StartupManager::addTask(QLatin1String("PasswordsManager"), &PasswordsManager::createInstance);
+	StartupManager::addTask(QLatin1String("SearchEnginesManager"), &SearchEnginesManager::createInstance, {QLatin1String("ThemesManager")});
+	StartupManager::addTask(QLatin1String("ToolBarsManager"), &ToolBarsManager::createInstance);
+	StartupManager::addTask(QLatin1String("TransfersManager"), &TransfersManager::createInstance);
+	StartupManager::addTask(QLatin1String("HandlersManager"), &HandlersManager::createInstance, {}, StartupManager::DeferredTask);
+	StartupManager::addTask(QLatin1String("NotesManager"), &NotesManager::createInstance, {}, StartupManager::DeferredTask);
+	StartupManager::addTask(QLatin1String("SpellCheckManager"), &SpellCheckManager::createInstance, {}, StartupManager::DeferredTask);
+	StartupManager::runTasks();
 
 	setLocale(SettingsManager::getOption(SettingsManager::Browser_LocaleOption).toString());
 	setQuitOnLastWindowClosed(true);
@@ -979,29 +995,128 @@ void Application::handleAboutToQuit()
 
 void Application::handleNewConnection()
 {
-	QLocalSocket *socket(m_localServer->nextPendingConnection());
+	while (m_localServer->hasPendingConnections())
+	{
+		QLocalSocket *socket(m_localServer->nextPendingConnection());
+
+		if (!socket)
+		{
+			return;
+		}
+
+		connect(socket, &QLocalSocket::readyRead, this, [=]()
+		{
+			readCommands(socket);
+		});
+		connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+
+		readCommands(socket);
+	}
+}
+
+void Application::readCommands(QLocalSocket *socket)
+{
+	const qint64 headerSize(static_cast<qint64>(sizeof(quint32)));
+	int amount(0);
 
-	if (!socket)
+	while (socket->bytesAvailable() >= headerSize)
 	{
-		return;
+		QDataStream headerStream(socket->peek(headerSize));
+		headerStream.setVersion(QDataStream::Qt_5_6);
+
+		quint32 size(0);
+
+		headerStream >> size;
+
+		if (size > 1048576)
+		{
+			socket->abort();
+
+			return;
+		}
+
+		if (socket->bytesAvailable() < (headerSize + size))
+		{
+			break;
+		}
+
+		socket->read(headerSize);
+
+		QDataStream payloadStream(socket->read(size));
+		payloadStream.setVersion(QDataStream::Qt_5_6);
+
+		QStringList arguments;
+
+		payloadStream >> arguments;
+
+		if (payloadStream.status() == QDataStream::Ok && !arguments.isEmpty())
+		{
+			if (m_pendingCommands.isEmpty())
+			{
+				QTimer::singleShot(0, this, &Application::handlePendingCommands);
+			}
+
+			m_pendingCommands.append(arguments);
+
+			++amount;
+		}
 	}
 
-	socket->waitForReadyRead(1000);
+	if (amount > 0)
+	{
+		QDataStream stream(socket);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << static_cast<quint32>(amount);
+
+		socket->flush();
+	}
+}
+
+void Application::handlePendingCommands()
+{
+	const QVector<QStringList> commands(m_pendingCommands);
+	QStringList batchedArguments;
+	QStringList batchedOptions;
+
+	m_pendingCommands.clear();
 
-	QString data;
-	QTextStream stream(socket);
-	stream >> data;
+	for (int i = 0; i < commands.count(); ++i)
+	{
+		m_commandLineParser.parse(commands.at(i));
+
+		const QStringList urls(m_commandLineParser.positionalArguments());
+		QStringList options(commands.at(i).mid(1));
+
+		for (int j = (urls.count() - 1); j >= 0; --j)
+		{
+			options.removeAt(options.lastIndexOf(urls.at(j)));
+		}
+
+		if (!batchedArguments.isEmpty() && options == batchedOptions && !m_commandLineParser.isSet(QLatin1String("session")))
+		{
+			batchedArguments.append(urls);
+
+			continue;
+		}
+
+		if (!batchedArguments.isEmpty())
+		{
+			executeCommand(batchedArguments);
+		}
 
-	const QStringList encodedArguments(QString(QByteArray::fromBase64(data.toUtf8())).split(QLatin1Char(' ')));
-	QStringList decodedArguments;
-	decodedArguments.reserve(encodedArguments.count());
+		batchedArguments = commands.at(i);
+		batchedOptions = options;
+	}
 
-	for (int i = 0; i < encodedArguments.count(); ++i)
+	if (!batchedArguments.isEmpty())
 	{
-		decodedArguments.append(QString(QByteArray::fromBase64(encodedArguments.at(i).toUtf8())));
+		executeCommand(batchedArguments);
 	}
+}
 
-	m_commandLineParser.parse(decodedArguments);
+void Application::executeCommand(const QStringList &arguments)
+{
+	m_commandLineParser.parse(arguments);
 
 	const QString session(m_commandLineParser.value(QLatin1String("session")));
 	const bool isPrivate(m_commandLineParser.isSet(QLatin1String("private-session")));
@@ -1043,8 +1158,6 @@ void Application::handleNewConnection()
 	}
 
 	handlePositionalArguments(&m_commandLineParser, true);
-
-	delete socket;
 }
 
 void Application::handlePositionalArguments(QCommandLineParser *parser, bool forceOpen)
@@ -1450,6 +1563,17 @@ QString Application::createReport(ReportOptions options)
 		stream << QLatin1String("\n\n");
 	}
 
+	if (options.testFlag(NetworkReport))
+	{
+		stream << FetchJob::createReport();
+		stream << SearchSuggester::createReport();
+
+		if (webBackend)
+		{
+			stream << webBackend->createReport();
+		}
+	}
+
 	if (options.testFlag(SettingsReport))
 	{
 		stream << SettingsManager::createReport();
@@ -28,6 +28,7 @@
 #include <QtCore/QUrl>
 #include <QtWidgets/QApplication>
 #include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
 
 namespace Otter
 {
@@ -51,8 +52,9 @@ public:
 		KeyboardShortcutsReport = 2,
 		PathsReport = 4,
 		SettingsReport = 8,
-		StandardReport = (EnvironmentReport | PathsReport | SettingsReport),
-		FullReport = (EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport)
+		NetworkReport = 16,
+		StandardReport = (EnvironmentReport | PathsReport | SettingsReport | NetworkReport),
+		FullReport = (EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport | NetworkReport)
 	};
 
 	Q_DECLARE_FLAGS(ReportOptions, ReportOption)
@@ -90,6 +92,8 @@ public slots:
 	void triggerAction(int identifier, const QVariantMap &parameters = {}, ActionsManager::TriggerType trigger = ActionsManager::UnknownTrigger) override;
 
 protected:
+	void readCommands(QLocalSocket *socket);
+	void executeCommand(const QStringList &arguments);
 	static void setLocale(const QString &locale);
 
 protected slots:
@@ -98,10 +102,12 @@ protected slots:
 	void handleOptionChanged(int identifier, const QVariant &value);
 	void handleAboutToQuit();
 	void handleNewConnection();
+	void handlePendingCommands();
 	void handleUpdateCheckResult(const QVector<UpdateChecker::UpdateInformation> &availableUpdates, int latestVersionIndex);
 
 private:
 	LongTermTimer *m_updateCheckTimer;
+	QVector<QStringList> m_pendingCommands;
 
 	static Application *m_instance;
 	static PlatformIntegration *m_platformIntegration;
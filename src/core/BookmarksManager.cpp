@@ -71,6 +71,7 @@ void BookmarksManager::ensureInitialized()
 		m_model = new BookmarksModel(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")), BookmarksModel::BookmarksMode, m_instance);
 
 		connect(m_model, &BookmarksModel::modelModified, m_instance, &BookmarksManager::scheduleSave);
+		connect(m_model, &BookmarksModel::saveFinished, m_instance, &BookmarksManager::handleSaveFinished);
 	}
 }
 
@@ -82,6 +83,16 @@ void BookmarksManager::scheduleSave()
 	}
 }
 
+void BookmarksManager::handleSaveFinished(const QString &path, bool isSuccess)
+{
+	Q_UNUSED(path)
+
+	if (!isSuccess && m_saveTimer == 0)
+	{
+		m_saveTimer = startTimer(30000);
+	}
+}
+
 void BookmarksManager::updateVisits(const QUrl &url)
 {
 	ensureInitialized();
@@ -56,6 +56,7 @@ protected:
 
 protected slots:
 	void scheduleSave();
+	void handleSaveFinished(const QString &path, bool isSuccess);
 
 private:
 	int m_saveTimer;
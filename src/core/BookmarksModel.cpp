@@ -26,15 +26,24 @@
 #include "ThemesManager.h"
 #include "Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeData>
 #include <QtCore/QSaveFile>
 #include <QtWidgets/QMessageBox>
 
+#include <limits>
+
 namespace Otter
 {
 
+QHash<QString, QFuture<BookmarksModel::LoadResult> > BookmarksModel::m_preloadedBookmarks;
+QHash<QString, quint64> BookmarksModel::m_savedGenerations;
+QMutex BookmarksModel::m_saveMutex;
+quint64 BookmarksModel::m_saveGeneration(0);
+
 BookmarksModel::Bookmark::Bookmark() : QStandardItem()
 {
 }
@@ -338,7 +347,9 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 	m_rootItem(new Bookmark()),
 	m_trashItem(new Bookmark()),
 	m_importTargetItem(nullptr),
-	m_mode(mode)
+	m_mode(mode),
+	m_bulkEditDepth(0),
+	m_isBulkModified(false)
 {
 	m_rootItem->setData(RootBookmark, TypeRole);
 	m_rootItem->setDragEnabled(false);
@@ -355,49 +366,32 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 		return;
 	}
 
-	QFile file(path);
+	const LoadResult result(m_preloadedBookmarks.contains(path) ? m_preloadedBookmarks.take(path).result() : loadBookmarks(path));
 
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	if (result.hasFailedOpening)
 	{
-		Console::addMessage(((mode == NotesMode) ? tr("Failed to open notes file: %1") : tr("Failed to open bookmarks file: %1")).arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+		Console::addMessage(((mode == NotesMode) ? tr("Failed to open notes file: %1") : tr("Failed to open bookmarks file: %1")).arg(result.errorString), Console::OtherCategory, Console::ErrorLevel, path);
 
 		return;
 	}
 
-	QXmlStreamReader reader(&file);
-
-	if (reader.readNextStartElement() && reader.name() == QLatin1String("xbel") && reader.attributes().value(QLatin1String("version")).toString() == QLatin1String("1.0"))
+	if (result.hasFailedParsing)
 	{
-		while (reader.readNextStartElement())
-		{
-			if (reader.name() == QLatin1String("folder") || reader.name() == QLatin1String("bookmark") || reader.name() == QLatin1String("separator"))
-			{
-				readBookmark(&reader, m_rootItem);
-			}
-			else
-			{
-				reader.skipCurrentElement();
-			}
+		Console::addMessage(((m_mode == NotesMode) ? tr("Failed to load notes file: %1") : tr("Failed to load bookmarks file: %1")).arg(result.errorString), Console::OtherCategory, Console::ErrorLevel, path);
 
-			if (reader.hasError())
-			{
-				m_rootItem->removeRows(0, m_rootItem->rowCount());
-
-				Console::addMessage(((m_mode == NotesMode) ? tr("Failed to load notes file: %1") : tr("Failed to load bookmarks file: %1")).arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+		QMessageBox::warning(nullptr, tr("Error"), ((m_mode == NotesMode) ? tr("Failed to load notes file.") : tr("Failed to load bookmarks file.")), QMessageBox::Close);
 
-				QMessageBox::warning(nullptr, tr("Error"), ((m_mode == NotesMode) ? tr("Failed to load notes file.") : tr("Failed to load bookmarks file.")), QMessageBox::Close);
-
-				return;
-			}
-		}
+		return;
 	}
 
-	connect(this, &BookmarksModel::itemChanged, this, &BookmarksModel::modelModified);
-	connect(this, &BookmarksModel::rowsInserted, this, &BookmarksModel::modelModified);
+	attachBookmarks(result.nodes);
+
+	connect(this, &BookmarksModel::itemChanged, this, &BookmarksModel::markModelModified);
+	connect(this, &BookmarksModel::rowsInserted, this, &BookmarksModel::markModelModified);
 	connect(this, &BookmarksModel::rowsInserted, this, &BookmarksModel::notifyBookmarkModified);
-	connect(this, &BookmarksModel::rowsRemoved, this, &BookmarksModel::modelModified);
+	connect(this, &BookmarksModel::rowsRemoved, this, &BookmarksModel::markModelModified);
 	connect(this, &BookmarksModel::rowsRemoved, this, &BookmarksModel::notifyBookmarkModified);
-	connect(this, &BookmarksModel::rowsMoved, this, &BookmarksModel::modelModified);
+	connect(this, &BookmarksModel::rowsMoved, this, &BookmarksModel::markModelModified);
 }
 
 void BookmarksModel::beginImport(Bookmark *target, int estimatedUrlsAmount, int estimatedKeywordsAmount)
@@ -436,6 +430,42 @@ void BookmarksModel::endImport()
 	emit modelModified();
 }
 
+void BookmarksModel::beginBulkEdit()
+{
+	++m_bulkEditDepth;
+}
+
+void BookmarksModel::endBulkEdit()
+{
+	if (m_bulkEditDepth == 0 || --m_bulkEditDepth > 0)
+	{
+		return;
+	}
+
+	const QSet<quint64> identifiers(m_bulkModifiedBookmarks);
+	const bool isModified(m_isBulkModified);
+
+	m_bulkModifiedBookmarks.clear();
+	m_isBulkModified = false;
+
+	QSet<quint64>::const_iterator iterator;
+
+	for (iterator = identifiers.constBegin(); iterator != identifiers.constEnd(); ++iterator)
+	{
+		Bookmark *bookmark(getBookmark(*iterator));
+
+		if (bookmark)
+		{
+			emit bookmarkModified(bookmark);
+		}
+	}
+
+	if (isModified || !identifiers.isEmpty())
+	{
+		emit modelModified();
+	}
+}
+
 void BookmarksModel::trashBookmark(Bookmark *bookmark)
 {
 	if (!bookmark)
@@ -462,9 +492,11 @@ void BookmarksModel::trashBookmark(Bookmark *bookmark)
 
 			removeBookmarkUrl(bookmark);
 
-			emit bookmarkModified(bookmark);
+			markBookmarkModified(bookmark);
+
 			emit bookmarkTrashed(bookmark, previousParent);
-			emit modelModified();
+
+			markModelModified();
 		}
 	}
 }
@@ -498,9 +530,14 @@ void BookmarksModel::restoreBookmark(Bookmark *bookmark)
 
 	m_trashItem->setEnabled(m_trashItem->rowCount() > 0);
 
-	emit bookmarkModified(bookmark);
-	emit bookmarkRestored(bookmark);
-	emit modelModified();
+	markBookmarkModified(bookmark);
+
+	if (m_bulkEditDepth == 0)
+	{
+		emit bookmarkRestored(bookmark);
+	}
+
+	markModelModified();
 }
 
 void BookmarksModel::removeBookmark(Bookmark *bookmark)
@@ -511,270 +548,203 @@ void BookmarksModel::removeBookmark(Bookmark *bookmark)
 	}
 
 	removeBookmarkUrl(bookmark);
+	removeBookmarkIndexes(bookmark);
 
-	const quint64 identifier(bookmark->data(IdentifierRole).toULongLong());
+	emit bookmarkRemoved(bookmark, static_cast<Bookmark*>(bookmark->parent()));
+
+	bookmark->parent()->removeRow(bookmark->row());
 
-	if (identifier > 0 && m_identifiers.contains(identifier))
+	markModelModified();
+}
+
+void BookmarksModel::preloadBookmarks(const QString &path)
+{
+	if (!m_preloadedBookmarks.contains(path) && QFile::exists(path))
 	{
-		m_identifiers.remove(identifier);
+		m_preloadedBookmarks[path] = QtConcurrent::run(&BookmarksModel::loadBookmarks, path);
 	}
+}
+
+void BookmarksModel::readBookmarkNode(QXmlStreamReader *reader, int parent, QVector<BookmarkNode> *nodes)
+{
+	BookmarkNode node;
+	node.parent = parent;
 
-	if (!bookmark->data(KeywordRole).toString().isEmpty() && m_keywords.contains(bookmark->data(KeywordRole).toString()))
+	if (reader->name() == QLatin1String("separator"))
 	{
-		m_keywords.remove(bookmark->data(KeywordRole).toString());
+		node.type = SeparatorBookmark;
+
+		nodes->append(node);
+
+		reader->readNext();
+
+		return;
 	}
 
-	emit bookmarkRemoved(bookmark, static_cast<Bookmark*>(bookmark->parent()));
+	const QString elementName(reader->name().toString());
+	const bool isFolder(elementName == QLatin1String("folder"));
 
-	bookmark->parent()->removeRow(bookmark->row());
+	if (!isFolder && elementName != QLatin1String("bookmark"))
+	{
+		return;
+	}
 
-	emit modelModified();
-}
+	const QXmlStreamAttributes attributes(reader->attributes());
 
-void BookmarksModel::readBookmark(QXmlStreamReader *reader, Bookmark *parent)
-{
-	Bookmark *bookmark(nullptr);
+	node.identifier = attributes.value(QLatin1String("id")).toULongLong();
+	node.timeAdded = readDateTime(attributes.value(QLatin1String("added")));
+	node.timeModified = readDateTime(attributes.value(QLatin1String("modified")));
 
-	if (reader->name() == QLatin1String("folder"))
+	if (isFolder)
+	{
+		node.type = FolderBookmark;
+	}
+	else
 	{
-		bookmark = addBookmark(FolderBookmark, {{IdentifierRole, reader->attributes().value(QLatin1String("id")).toULongLong()}, {TimeAddedRole, readDateTime(reader, QLatin1String("added"))}, {TimeModifiedRole, readDateTime(reader, QLatin1String("modified"))}}, parent);
+		node.type = (attributes.hasAttribute(QLatin1String("feed")) ? FeedBookmark : UrlBookmark);
+		node.url = attributes.value(QLatin1String("href")).toString();
+		node.normalizedUrl = Utils::normalizeUrl(QUrl(node.url));
+		node.timeVisited = readDateTime(attributes.value(QLatin1String("visited")));
+	}
+
+	const int index(nodes->count());
 
-		while (reader->readNext())
+	nodes->append(node);
+
+	while (reader->readNext())
+	{
+		if (reader->isStartElement())
 		{
-			if (reader->isStartElement())
+			if (reader->name() == QLatin1String("title"))
 			{
-				if (reader->name() == QLatin1String("title"))
-				{
-					bookmark->setItemData(reader->readElementText().trimmed(), TitleRole);
-				}
-				else if (reader->name() == QLatin1String("desc"))
-				{
-					bookmark->setItemData(reader->readElementText().trimmed(), DescriptionRole);
-				}
-				else if (reader->name() == QLatin1String("folder") || reader->name() == QLatin1String("bookmark") || reader->name() == QLatin1String("separator"))
-				{
-					readBookmark(reader, bookmark);
-				}
-				else if (reader->name() == QLatin1String("info"))
-				{
-					while (reader->readNext())
-					{
-						if (reader->isStartElement())
-						{
-							if (reader->name() == QLatin1String("metadata") && reader->attributes().value(QLatin1String("owner")).toString().startsWith(QLatin1String("http://otter-browser.org/")))
-							{
-								while (reader->readNext())
-								{
-									if (reader->isStartElement())
-									{
-										if (reader->name() == QLatin1String("keyword"))
-										{
-											const QString keyword(reader->readElementText().trimmed());
-
-											if (!keyword.isEmpty())
-											{
-												bookmark->setItemData(keyword, KeywordRole);
-
-												handleKeywordChanged(bookmark, keyword);
-											}
-										}
-										else
-										{
-											reader->skipCurrentElement();
-										}
-									}
-									else if (reader->isEndElement() && reader->name() == QLatin1String("metadata"))
-									{
-										break;
-									}
-								}
-							}
-							else
-							{
-								reader->skipCurrentElement();
-							}
-						}
-						else if (reader->isEndElement() && reader->name() == QLatin1String("info"))
-						{
-							break;
-						}
-					}
-				}
-				else
-				{
-					reader->skipCurrentElement();
-				}
+				(*nodes)[index].title = reader->readElementText().trimmed();
 			}
-			else if (reader->isEndElement() && reader->name() == QLatin1String("folder"))
+			else if (reader->name() == QLatin1String("desc"))
 			{
-				break;
+				(*nodes)[index].description = reader->readElementText().trimmed();
 			}
-			else if (reader->hasError())
+			else if (isFolder && (reader->name() == QLatin1String("folder") || reader->name() == QLatin1String("bookmark") || reader->name() == QLatin1String("separator")))
 			{
-				return;
+				readBookmarkNode(reader, index, nodes);
 			}
-		}
-	}
-	else if (reader->name() == QLatin1String("bookmark"))
-	{
-		const bool isFeed(reader->attributes().hasAttribute(QLatin1String("feed")));
-
-		bookmark = addBookmark((isFeed ? FeedBookmark : UrlBookmark), {{IdentifierRole, reader->attributes().value(QLatin1String("id")).toULongLong()}, {UrlRole, reader->attributes().value(QLatin1String("href")).toString()}, {TimeAddedRole, readDateTime(reader, QLatin1String("added"))}, {TimeModifiedRole, readDateTime(reader, QLatin1String("modified"))}, {TimeVisitedRole, readDateTime(reader, QLatin1String("visited"))}}, parent);
-
-		while (reader->readNext())
-		{
-			if (reader->isStartElement())
+			else if (reader->name() == QLatin1String("info"))
 			{
-				if (reader->name() == QLatin1String("title"))
-				{
-					bookmark->setItemData(reader->readElementText().trimmed(), TitleRole);
-				}
-				else if (reader->name() == QLatin1String("desc"))
+				while (reader->readNext())
 				{
-					bookmark->setItemData(reader->readElementText().trimmed(), DescriptionRole);
-				}
-				else if (reader->name() == QLatin1String("info"))
-				{
-					while (reader->readNext())
+					if (reader->isStartElement())
 					{
-						if (reader->isStartElement())
+						if (reader->name() == QLatin1String("metadata") && reader->attributes().value(QLatin1String("owner")).startsWith(QLatin1String("http://otter-browser.org/")))
 						{
-							if (reader->name() == QLatin1String("metadata") && reader->attributes().value(QLatin1String("owner")).toString().startsWith(QLatin1String("http://otter-browser.org/")))
+							while (reader->readNext())
 							{
-								while (reader->readNext())
+								if (reader->isStartElement())
 								{
-									if (reader->isStartElement())
+									if (reader->name() == QLatin1String("keyword"))
+									{
+										(*nodes)[index].keyword = reader->readElementText().trimmed();
+									}
+									else if (!isFolder && reader->name() == QLatin1String("visits"))
 									{
-										if (reader->name() == QLatin1String("keyword"))
-										{
-											const QString keyword(reader->readElementText().trimmed());
-
-											if (!keyword.isEmpty())
-											{
-												bookmark->setItemData(keyword, KeywordRole);
-
-												handleKeywordChanged(bookmark, keyword);
-											}
-										}
-										else if (reader->name() == QLatin1String("visits"))
-										{
-											bookmark->setItemData(reader->readElementText().toInt(), VisitsRole);
-										}
-										else
-										{
-											reader->skipCurrentElement();
-										}
+										(*nodes)[index].visits = reader->readElementText().toInt();
 									}
-									else if (reader->isEndElement() && reader->name() == QLatin1String("metadata"))
+									else
 									{
-										break;
+										reader->skipCurrentElement();
 									}
 								}
-							}
-							else
-							{
-								reader->skipCurrentElement();
+								else if ((reader->isEndElement() && reader->name() == QLatin1String("metadata")) || reader->hasError())
+								{
+									break;
+								}
 							}
 						}
-						else if (reader->isEndElement() && reader->name() == QLatin1String("info"))
+						else
 						{
-							break;
+							reader->skipCurrentElement();
 						}
 					}
-				}
-				else
-				{
-					reader->skipCurrentElement();
+					else if ((reader->isEndElement() && reader->name() == QLatin1String("info")) || reader->hasError())
+					{
+						break;
+					}
 				}
 			}
-			else if (reader->isEndElement() && reader->name() == QLatin1String("bookmark"))
-			{
-				break;
-			}
-			else if (reader->hasError())
+			else
 			{
-				return;
+				reader->skipCurrentElement();
 			}
 		}
-
-		if (isFeed)
+		else if (reader->isEndElement() && reader->name() == elementName)
 		{
-			setupFeed(bookmark);
+			break;
+		}
+		else if (reader->hasError())
+		{
+			return;
 		}
-	}
-	else if (reader->name() == QLatin1String("separator"))
-	{
-		addBookmark(SeparatorBookmark, {}, parent);
-
-		reader->readNext();
 	}
 }
 
-void BookmarksModel::writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark) const
+void BookmarksModel::writeBookmarkNode(QXmlStreamWriter *writer, const QVector<BookmarkNode> &nodes, const QVector<QVector<int> > &children, int index, FormatMode mode)
 {
-	if (!bookmark)
-	{
-		return;
-	}
+	const BookmarkNode &node(nodes.at(index));
 
-	const BookmarkType type(bookmark->getType());
-
-	switch (type)
+	switch (node.type)
 	{
 		case FeedBookmark:
 		case UrlBookmark:
 			writer->writeStartElement(QLatin1String("bookmark"));
-			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark->getRawData(IdentifierRole).toULongLong()));
+			writer->writeAttribute(QLatin1String("id"), QString::number(node.identifier));
 
-			if (type == FeedBookmark)
+			if (node.type == FeedBookmark)
 			{
 				writer->writeAttribute(QLatin1String("feed"), QLatin1String("true"));
 			}
 
-			if (!bookmark->getRawData(UrlRole).toString().isEmpty())
+			if (!node.url.isEmpty())
 			{
-				writer->writeAttribute(QLatin1String("href"), bookmark->getRawData(UrlRole).toString());
+				writer->writeAttribute(QLatin1String("href"), node.url);
 			}
 
-			if (bookmark->getRawData(TimeAddedRole).toDateTime().isValid())
+			if (node.timeAdded.isValid())
 			{
-				writer->writeAttribute(QLatin1String("added"), bookmark->getRawData(TimeAddedRole).toDateTime().toString(Qt::ISODate));
+				writer->writeAttribute(QLatin1String("added"), node.timeAdded.toString(Qt::ISODate));
 			}
 
-			if (bookmark->getRawData(TimeModifiedRole).toDateTime().isValid())
+			if (node.timeModified.isValid())
 			{
-				writer->writeAttribute(QLatin1String("modified"), bookmark->getRawData(TimeModifiedRole).toDateTime().toString(Qt::ISODate));
+				writer->writeAttribute(QLatin1String("modified"), node.timeModified.toString(Qt::ISODate));
 			}
 
-			if (m_mode != NotesMode)
+			if (mode != NotesMode)
 			{
-				if (bookmark->getRawData(TimeVisitedRole).toDateTime().isValid())
+				if (node.timeVisited.isValid())
 				{
-					writer->writeAttribute(QLatin1String("visited"), bookmark->getRawData(TimeVisitedRole).toDateTime().toString(Qt::ISODate));
+					writer->writeAttribute(QLatin1String("visited"), node.timeVisited.toString(Qt::ISODate));
 				}
 
-				writer->writeTextElement(QLatin1String("title"), bookmark->getRawData(TitleRole).toString());
+				writer->writeTextElement(QLatin1String("title"), node.title);
 			}
 
-			if (!bookmark->getRawData(DescriptionRole).toString().isEmpty())
+			if (!node.description.isEmpty())
 			{
-				writer->writeTextElement(QLatin1String("desc"), bookmark->getRawData(DescriptionRole).toString());
+				writer->writeTextElement(QLatin1String("desc"), node.description);
 			}
 
-			if (m_mode == BookmarksMode && (!bookmark->getRawData(KeywordRole).toString().isEmpty() || bookmark->getRawData(VisitsRole).toInt() > 0))
+			if (mode == BookmarksMode && (!node.keyword.isEmpty() || node.visits > 0))
 			{
 				writer->writeStartElement(QLatin1String("info"));
 				writer->writeStartElement(QLatin1String("metadata"));
 				writer->writeAttribute(QLatin1String("owner"), QLatin1String("http://otter-browser.org/otter-xbel-bookmark"));
 
-				if (!bookmark->getRawData(KeywordRole).toString().isEmpty())
+				if (!node.keyword.isEmpty())
 				{
-					writer->writeTextElement(QLatin1String("keyword"), bookmark->getRawData(KeywordRole).toString());
+					writer->writeTextElement(QLatin1String("keyword"), node.keyword);
 				}
 
-				if (bookmark->getRawData(VisitsRole).toInt() > 0)
+				if (node.visits > 0)
 				{
-					writer->writeTextElement(QLatin1String("visits"), QString::number(bookmark->getRawData(VisitsRole).toInt()));
+					writer->writeTextElement(QLatin1String("visits"), QString::number(node.visits));
 				}
 
 				writer->writeEndElement();
@@ -786,38 +756,38 @@ void BookmarksModel::writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark)
 			break;
 		case FolderBookmark:
 			writer->writeStartElement(QLatin1String("folder"));
-			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark->getRawData(IdentifierRole).toULongLong()));
+			writer->writeAttribute(QLatin1String("id"), QString::number(node.identifier));
 
-			if (bookmark->getRawData(TimeAddedRole).toDateTime().isValid())
+			if (node.timeAdded.isValid())
 			{
-				writer->writeAttribute(QLatin1String("added"), bookmark->getRawData(TimeAddedRole).toDateTime().toString(Qt::ISODate));
+				writer->writeAttribute(QLatin1String("added"), node.timeAdded.toString(Qt::ISODate));
 			}
 
-			if (bookmark->getRawData(TimeModifiedRole).toDateTime().isValid())
+			if (node.timeModified.isValid())
 			{
-				writer->writeAttribute(QLatin1String("modified"), bookmark->getRawData(TimeModifiedRole).toDateTime().toString(Qt::ISODate));
+				writer->writeAttribute(QLatin1String("modified"), node.timeModified.toString(Qt::ISODate));
 			}
 
-			writer->writeTextElement(QLatin1String("title"), bookmark->getRawData(TitleRole).toString());
+			writer->writeTextElement(QLatin1String("title"), node.title);
 
-			if (!bookmark->getRawData(DescriptionRole).toString().isEmpty())
+			if (!node.description.isEmpty())
 			{
-				writer->writeTextElement(QLatin1String("desc"), bookmark->getRawData(DescriptionRole).toString());
+				writer->writeTextElement(QLatin1String("desc"), node.description);
 			}
 
-			if (m_mode == BookmarksMode && !bookmark->getRawData(KeywordRole).toString().isEmpty())
+			if (mode == BookmarksMode && !node.keyword.isEmpty())
 			{
 				writer->writeStartElement(QLatin1String("info"));
 				writer->writeStartElement(QLatin1String("metadata"));
 				writer->writeAttribute(QLatin1String("owner"), QLatin1String("http://otter-browser.org/otter-xbel-bookmark"));
-				writer->writeTextElement(QLatin1String("keyword"), bookmark->getRawData(KeywordRole).toString());
+				writer->writeTextElement(QLatin1String("keyword"), node.keyword);
 				writer->writeEndElement();
 				writer->writeEndElement();
 			}
 
-			for (int i = 0; i < bookmark->rowCount(); ++i)
+			for (int i = 0; i < children.at(index).count(); ++i)
 			{
-				writeBookmark(writer, bookmark->getChild(i));
+				writeBookmarkNode(writer, nodes, children, children.at(index).at(i), mode);
 			}
 
 			writer->writeEndElement();
@@ -830,6 +800,154 @@ void BookmarksModel::writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark)
 	}
 }
 
+void BookmarksModel::attachBookmarks(const QVector<BookmarkNode> &nodes)
+{
+	QVector<Bookmark*> bookmarks;
+	bookmarks.reserve(nodes.count());
+
+	QVector<QList<QStandardItem*> > children(nodes.count());
+	QList<QStandardItem*> topLevelBookmarks;
+	QVector<Bookmark*> feeds;
+
+	m_urls.reserve(m_urls.count() + nodes.count());
+
+	for (int i = 0; i < nodes.count(); ++i)
+	{
+		const BookmarkNode &node(nodes.at(i));
+		Bookmark *bookmark(new Bookmark());
+		bookmark->setItemData(node.type, TypeRole);
+
+		if (node.type == UrlBookmark || node.type == SeparatorBookmark)
+		{
+			bookmark->setDropEnabled(false);
+		}
+
+		if (node.type != SeparatorBookmark)
+		{
+			quint64 identifier(node.identifier);
+
+			if (identifier == 0 || m_identifiers.contains(identifier))
+			{
+				identifier = (m_identifiers.isEmpty() ? 1 : (m_identifiers.lastKey() + 1));
+			}
+
+			m_identifiers[identifier] = bookmark;
+
+			bookmark->setItemData(identifier, IdentifierRole);
+			bookmark->setItemData(node.title, TitleRole);
+			bookmark->setItemData(node.timeAdded, TimeAddedRole);
+			bookmark->setItemData(node.timeModified, TimeModifiedRole);
+
+			if (!node.description.isEmpty())
+			{
+				bookmark->setItemData(node.description, DescriptionRole);
+			}
+
+			if (!node.keyword.isEmpty())
+			{
+				bookmark->setItemData(node.keyword, KeywordRole);
+
+				handleKeywordChanged(bookmark, node.keyword);
+			}
+
+			if (node.type != FolderBookmark)
+			{
+				bookmark->setItemData(node.url, UrlRole);
+				bookmark->setItemData(node.timeVisited, TimeVisitedRole);
+
+				if (node.visits > 0)
+				{
+					bookmark->setItemData(node.visits, VisitsRole);
+				}
+
+				if (!node.url.isEmpty())
+				{
+					handleUrlChanged(bookmark, node.normalizedUrl);
+				}
+
+				if (node.type == UrlBookmark)
+				{
+					bookmark->setFlags(bookmark->flags() | Qt::ItemNeverHasChildren);
+				}
+				else
+				{
+					feeds.append(bookmark);
+				}
+			}
+		}
+
+		if (node.parent >= 0 && node.parent < i)
+		{
+			children[node.parent].append(bookmark);
+		}
+		else
+		{
+			topLevelBookmarks.append(bookmark);
+		}
+
+		bookmarks.append(bookmark);
+	}
+
+	for (int i = 0; i < bookmarks.count(); ++i)
+	{
+		if (!children.at(i).isEmpty())
+		{
+			bookmarks.at(i)->appendRows(children.at(i));
+		}
+	}
+
+	if (!topLevelBookmarks.isEmpty())
+	{
+		m_rootItem->appendRows(topLevelBookmarks);
+	}
+
+	for (int i = 0; i < feeds.count(); ++i)
+	{
+		setupFeed(feeds.at(i));
+	}
+}
+
+void BookmarksModel::createSnapshot(Bookmark *bookmark, int parent, QVector<BookmarkNode> *nodes) const
+{
+	BookmarkNode node;
+	node.type = bookmark->getType();
+	node.parent = parent;
+
+	if (node.type != SeparatorBookmark)
+	{
+		node.identifier = bookmark->getRawData(IdentifierRole).toULongLong();
+		node.title = bookmark->getRawData(TitleRole).toString();
+		node.description = bookmark->getRawData(DescriptionRole).toString();
+		node.keyword = bookmark->getRawData(KeywordRole).toString();
+		node.timeAdded = bookmark->getRawData(TimeAddedRole).toDateTime();
+		node.timeModified = bookmark->getRawData(TimeModifiedRole).toDateTime();
+
+		if (node.type != FolderBookmark)
+		{
+			node.url = bookmark->getRawData(UrlRole).toString();
+			node.timeVisited = bookmark->getRawData(TimeVisitedRole).toDateTime();
+			node.visits = bookmark->getRawData(VisitsRole).toInt();
+		}
+	}
+
+	const int index(nodes->count());
+
+	nodes->append(node);
+
+	if (node.type == FolderBookmark)
+	{
+		for (int i = 0; i < bookmark->rowCount(); ++i)
+		{
+			Bookmark *child(bookmark->getChild(i));
+
+			if (child)
+			{
+				createSnapshot(child, index, nodes);
+			}
+		}
+	}
+}
+
 void BookmarksModel::removeBookmarkUrl(Bookmark *bookmark)
 {
 	if (!bookmark)
@@ -847,17 +965,14 @@ void BookmarksModel::removeBookmarkUrl(Bookmark *bookmark)
 
 			break;
 		case UrlBookmark:
+			if (!bookmark->m_normalizedUrl.isEmpty() && m_urls.contains(bookmark->m_normalizedUrl))
 			{
-				const QUrl url(Utils::normalizeUrl(bookmark->data(UrlRole).toUrl()));
+				QVector<Bookmark*> &bookmarks(m_urls[bookmark->m_normalizedUrl]);
+				bookmarks.removeAll(bookmark);
 
-				if (!url.isEmpty() && m_urls.contains(url))
+				if (bookmarks.isEmpty())
 				{
-					m_urls[url].removeAll(bookmark);
-
-					if (m_urls[url].isEmpty())
-					{
-						m_urls.remove(url);
-					}
+					m_urls.remove(bookmark->m_normalizedUrl);
 				}
 			}
 
@@ -867,6 +982,35 @@ void BookmarksModel::removeBookmarkUrl(Bookmark *bookmark)
 	}
 }
 
+void BookmarksModel::removeBookmarkIndexes(Bookmark *bookmark)
+{
+	if (!bookmark)
+	{
+		return;
+	}
+
+	const quint64 identifier(bookmark->getIdentifier());
+
+	if (identifier > 0 && m_identifiers.value(identifier) == bookmark)
+	{
+		m_identifiers.remove(identifier);
+	}
+
+	const QString keyword(bookmark->getRawData(KeywordRole).toString());
+
+	if (!keyword.isEmpty() && m_keywords.value(keyword) == bookmark)
+	{
+		m_keywords.remove(keyword);
+	}
+
+	m_trash.remove(bookmark);
+
+	for (int i = 0; i < bookmark->rowCount(); ++i)
+	{
+		removeBookmarkIndexes(static_cast<Bookmark*>(bookmark->child(i, 0)));
+	}
+}
+
 void BookmarksModel::readdBookmarkUrl(Bookmark *bookmark)
 {
 	if (!bookmark)
@@ -884,18 +1028,9 @@ void BookmarksModel::readdBookmarkUrl(Bookmark *bookmark)
 
 			break;
 		case UrlBookmark:
+			if (!bookmark->m_normalizedUrl.isEmpty())
 			{
-				const QUrl url(Utils::normalizeUrl(bookmark->data(UrlRole).toUrl()));
-
-				if (!url.isEmpty())
-				{
-					if (!m_urls.contains(url))
-					{
-						m_urls[url] = QVector<Bookmark*>();
-					}
-
-					m_urls[url].append(bookmark);
-				}
+				m_urls[bookmark->m_normalizedUrl].append(bookmark);
 			}
 
 			break;
@@ -904,6 +1039,38 @@ void BookmarksModel::readdBookmarkUrl(Bookmark *bookmark)
 	}
 }
 
+void BookmarksModel::markBookmarkModified(Bookmark *bookmark)
+{
+	if (m_bulkEditDepth == 0)
+	{
+		emit bookmarkModified(bookmark);
+
+		return;
+	}
+
+	while (bookmark && bookmark != m_rootItem && bookmark != m_trashItem && bookmark->getIdentifier() == 0)
+	{
+		bookmark = static_cast<Bookmark*>(bookmark->parent());
+	}
+
+	if (bookmark && bookmark != m_trashItem)
+	{
+		m_bulkModifiedBookmarks.insert(bookmark->getIdentifier());
+	}
+}
+
+void BookmarksModel::markModelModified()
+{
+	if (m_bulkEditDepth > 0)
+	{
+		m_isBulkModified = true;
+	}
+	else
+	{
+		emit modelModified();
+	}
+}
+
 void BookmarksModel::setupFeed(BookmarksModel::Bookmark *bookmark)
 {
 	const QUrl normalizedUrl(Utils::normalizeUrl(bookmark->getUrl()));
@@ -926,12 +1093,20 @@ void BookmarksModel::setupFeed(BookmarksModel::Bookmark *bookmark)
 
 void BookmarksModel::emptyTrash()
 {
+	beginBulkEdit();
+
+	for (int i = 0; i < m_trashItem->rowCount(); ++i)
+	{
+		removeBookmarkIndexes(static_cast<Bookmark*>(m_trashItem->child(i, 0)));
+	}
+
 	m_trashItem->removeRows(0, m_trashItem->rowCount());
 	m_trashItem->setEnabled(false);
 
 	m_trash.clear();
 
-	emit modelModified();
+	markModelModified();
+	endBulkEdit();
 }
 
 void BookmarksModel::handleFeedModified(Feed *feed)
@@ -980,10 +1155,10 @@ void BookmarksModel::handleFeedModified(Feed *feed)
 
 	for (int i = 0; i < bookmarks.count(); ++i)
 	{
-		emit bookmarkModified(bookmarks.at(i));
+		markBookmarkModified(bookmarks.at(i));
 	}
 
-	emit modelModified();
+	markModelModified();
 }
 
 void BookmarksModel::handleKeywordChanged(Bookmark *bookmark, const QString &newKeyword, const QString &oldKeyword)
@@ -1011,13 +1186,10 @@ void BookmarksModel::handleUrlChanged(Bookmark *bookmark, const QUrl &newUrl, co
 		}
 	}
 
+	bookmark->m_normalizedUrl = newUrl;
+
 	if (!newUrl.isEmpty())
 	{
-		if (!m_urls.contains(newUrl))
-		{
-			m_urls[newUrl] = QVector<Bookmark*>();
-		}
-
 		m_urls[newUrl].append(bookmark);
 	}
 }
@@ -1028,7 +1200,7 @@ void BookmarksModel::notifyBookmarkModified(const QModelIndex &index)
 
 	if (bookmark)
 	{
-		emit bookmarkModified(bookmark);
+		markBookmarkModified(bookmark);
 	}
 }
 
@@ -1094,8 +1266,16 @@ BookmarksModel::Bookmark* BookmarksModel::addBookmark(BookmarkType type, const Q
 
 	bookmark->setItemData(type, TypeRole);
 
-	emit bookmarkAdded(bookmark);
-	emit modelModified();
+	if (m_bulkEditDepth > 0)
+	{
+		markBookmarkModified(bookmark);
+	}
+	else
+	{
+		emit bookmarkAdded(bookmark);
+	}
+
+	markModelModified();
 
 	return bookmark;
 }
@@ -1220,14 +1400,110 @@ QMimeData* BookmarksModel::mimeData(const QModelIndexList &indexes) const
 	return mimeData;
 }
 
-QDateTime BookmarksModel::readDateTime(QXmlStreamReader *reader, const QString &attribute)
+QDateTime BookmarksModel::readDateTime(const QStringRef &value)
 {
-	QDateTime dateTime(QDateTime::fromString(reader->attributes().value(attribute).toString(), Qt::ISODate));
+	if ((value.length() == 19 || (value.length() == 20 && value.at(19) == QLatin1Char('Z'))) && value.at(4) == QLatin1Char('-') && value.at(7) == QLatin1Char('-') && value.at(10) == QLatin1Char('T') && value.at(13) == QLatin1Char(':') && value.at(16) == QLatin1Char(':'))
+	{
+		const auto readNumber([&](int position, int length) -> int
+		{
+			int number(0);
+
+			for (int i = position; i < (position + length); ++i)
+			{
+				const int digit(value.at(i).digitValue());
+
+				if (digit < 0)
+				{
+					return -1;
+				}
+
+				number = ((number * 10) + digit);
+			}
+
+			return number;
+		});
+		const QDate date(readNumber(0, 4), readNumber(5, 2), readNumber(8, 2));
+		const QTime time(readNumber(11, 2), readNumber(14, 2), readNumber(17, 2));
+
+		if (date.isValid() && time.isValid())
+		{
+			return QDateTime(date, time, Qt::UTC);
+		}
+	}
+
+	QDateTime dateTime(QDateTime::fromString(value.toString(), Qt::ISODate));
 	dateTime.setTimeSpec(Qt::UTC);
 
 	return dateTime;
 }
 
+BookmarksModel::LoadResult BookmarksModel::loadBookmarks(const QString &path)
+{
+	LoadResult result;
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		result.errorString = file.errorString();
+		result.hasFailedOpening = true;
+
+		return result;
+	}
+
+	QByteArray data;
+	const qint64 size(file.size());
+	uchar *mappedData((size > 0 && size < std::numeric_limits<int>::max()) ? file.map(0, size) : nullptr);
+
+	if (mappedData)
+	{
+		data = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), static_cast<int>(size));
+	}
+	else
+	{
+		data = file.readAll();
+	}
+
+	QXmlStreamReader reader(data);
+
+	if (reader.readNextStartElement() && reader.name() == QLatin1String("xbel") && reader.attributes().value(QLatin1String("version")) == QLatin1String("1.0"))
+	{
+		result.nodes.reserve(static_cast<int>(qMin(size / 256, static_cast<qint64>(100000))));
+
+		while (reader.readNextStartElement())
+		{
+			if (reader.name() == QLatin1String("folder") || reader.name() == QLatin1String("bookmark") || reader.name() == QLatin1String("separator"))
+			{
+				readBookmarkNode(&reader, -1, &result.nodes);
+			}
+			else
+			{
+				reader.skipCurrentElement();
+			}
+
+			if (reader.hasError())
+			{
+				result.nodes.clear();
+				result.errorString = reader.errorString();
+				result.hasFailedParsing = true;
+
+				break;
+			}
+		}
+	}
+
+	reader.clear();
+	data.clear();
+
+	if (mappedData)
+	{
+		file.unmap(mappedData);
+	}
+
+	file.close();
+
+	return result;
+}
+
 QStringList BookmarksModel::mimeTypes() const
 {
 	return {QLatin1String("text/uri-list")};
@@ -1311,31 +1587,29 @@ QVector<BookmarksModel::Bookmark*> BookmarksModel::findUrls(const QUrl &url, QSt
 		branch = m_rootItem;
 	}
 
-	const QUrl normalizedUrl(Utils::normalizeUrl(url));
+	const QVector<Bookmark*> matchingBookmarks(m_urls.value(Utils::normalizeUrl(url)));
 	QVector<Bookmark*> bookmarks;
+	bookmarks.reserve(matchingBookmarks.count());
 
-	for (int i = 0; i < branch->rowCount(); ++i)
+	for (int i = 0; i < matchingBookmarks.count(); ++i)
 	{
-		Bookmark *bookmark(static_cast<Bookmark*>(branch->child(i)));
+		Bookmark *bookmark(matchingBookmarks.at(i));
 
-		if (bookmark)
+		if (bookmark->getType() != UrlBookmark)
 		{
-			switch (bookmark->getType())
-			{
-				case FolderBookmark:
-					bookmarks.append(findUrls(url, bookmark));
+			continue;
+		}
 
-					break;
-				case UrlBookmark:
-					if (normalizedUrl == Utils::normalizeUrl(bookmark->getUrl()))
-					{
-						bookmarks.append(bookmark);
-					}
+		QStandardItem *parent(bookmark->parent());
 
-					break;
-				default:
-					break;
-			}
+		while (parent && parent != branch && static_cast<Bookmark*>(parent)->getType() == FolderBookmark)
+		{
+			parent = parent->parent();
+		}
+
+		if (parent == branch)
+		{
+			bookmarks.append(bookmark);
 		}
 	}
 
@@ -1385,7 +1659,7 @@ bool BookmarksModel::moveBookmark(Bookmark *bookmark, Bookmark *newParent, int n
 			newParent->insertRow(newRow, bookmark);
 		}
 
-		emit modelModified();
+		markModelModified();
 
 		return true;
 	}
@@ -1397,7 +1671,8 @@ bool BookmarksModel::moveBookmark(Bookmark *bookmark, Bookmark *newParent, int n
 		newParent->appendRow(bookmark->parent()->takeRow(bookmark->row()));
 
 		emit bookmarkMoved(bookmark, previousParent, previousRow);
-		emit modelModified();
+
+		markModelModified();
 
 		return true;
 	}
@@ -1412,7 +1687,8 @@ bool BookmarksModel::moveBookmark(Bookmark *bookmark, Bookmark *newParent, int n
 	newParent->insertRow(targetRow, bookmark->parent()->takeRow(bookmark->row()));
 
 	emit bookmarkMoved(bookmark, previousParent, previousRow);
-	emit modelModified();
+
+	markModelModified();
 
 	return true;
 }
@@ -1449,11 +1725,15 @@ bool BookmarksModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
 		{
 			const QVector<QUrl> urls(Utils::extractUrls(data));
 
+			beginBulkEdit();
+
 			for (int i = 0; i < urls.count(); ++i)
 			{
 				addBookmark(UrlBookmark, {{UrlRole, urls.at(i)}, {TitleRole, (data->property("x-url-title").toString().isEmpty() ? urls.at(i).toString() : data->property("x-url-title").toString())}}, getBookmark(parent), row);
 			}
 
+			endBulkEdit();
+
 			return true;
 		}
 
@@ -1463,17 +1743,72 @@ bool BookmarksModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
 	return false;
 }
 
-bool BookmarksModel::save(const QString &path) const
+bool BookmarksModel::save(const QString &path)
 {
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
 	}
 
+	QVector<BookmarkNode> nodes;
+	nodes.reserve(m_identifiers.count() + 1);
+
+	for (int i = 0; i < m_rootItem->rowCount(); ++i)
+	{
+		Bookmark *bookmark(m_rootItem->getChild(i));
+
+		if (bookmark)
+		{
+			createSnapshot(bookmark, -1, &nodes);
+		}
+	}
+
+	++m_saveGeneration;
+
+	QFutureWatcher<bool> *watcher(new QFutureWatcher<bool>(this));
+
+	connect(watcher, &QFutureWatcher<bool>::finished, this, [=]()
+	{
+		emit saveFinished(path, watcher->result());
+
+		watcher->deleteLater();
+	});
+
+	watcher->setFuture(QtConcurrent::run(&BookmarksModel::writeBookmarks, path, nodes, m_mode, m_saveGeneration));
+
+	return true;
+}
+
+bool BookmarksModel::writeBookmarks(const QString &path, const QVector<BookmarkNode> &nodes, FormatMode mode, quint64 generation)
+{
+	QMutexLocker locker(&m_saveMutex);
+
+	if (m_savedGenerations.value(path) >= generation)
+	{
+		return true;
+	}
+
+	QVector<QVector<int> > children(nodes.count());
+	QVector<int> topLevelNodes;
+
+	for (int i = 0; i < nodes.count(); ++i)
+	{
+		if (nodes.at(i).parent >= 0)
+		{
+			children[nodes.at(i).parent].append(i);
+		}
+		else
+		{
+			topLevelNodes.append(i);
+		}
+	}
+
 	QSaveFile file(path);
 
 	if (!file.open(QIODevice::WriteOnly))
 	{
+		Console::addMessage(((mode == NotesMode) ? tr("Failed to save notes file: %1") : tr("Failed to save bookmarks file: %1")).arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+
 		return false;
 	}
 
@@ -1485,14 +1820,23 @@ bool BookmarksModel::save(const QString &path) const
 	writer.writeStartElement(QLatin1String("xbel"));
 	writer.writeAttribute(QLatin1String("version"), QLatin1String("1.0"));
 
-	for (int i = 0; i < m_rootItem->rowCount(); ++i)
+	for (int i = 0; i < topLevelNodes.count(); ++i)
 	{
-		writeBookmark(&writer, m_rootItem->getChild(i));
+		writeBookmarkNode(&writer, nodes, children, topLevelNodes.at(i), mode);
 	}
 
 	writer.writeEndDocument();
 
-	return file.commit();
+	if (!file.commit())
+	{
+		Console::addMessage(((mode == NotesMode) ? tr("Failed to save notes file: %1") : tr("Failed to save bookmarks file: %1")).arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+
+		return false;
+	}
+
+	m_savedGenerations[path] = generation;
+
+	return true;
 }
 
 bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, int role)
@@ -1525,7 +1869,7 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 		case UrlRole:
 			if (value.toUrl() != index.data(UrlRole).toUrl())
 			{
-				handleUrlChanged(bookmark, Utils::normalizeUrl(value.toUrl()), Utils::normalizeUrl(index.data(UrlRole).toUrl()));
+				handleUrlChanged(bookmark, Utils::normalizeUrl(value.toUrl()), bookmark->m_normalizedUrl);
 			}
 
 			break;
@@ -1547,8 +1891,8 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 		case TimeModifiedRole:
 		case TimeVisitedRole:
 		case VisitsRole:
-			emit bookmarkModified(bookmark);
-			emit modelModified();
+			markBookmarkModified(bookmark);
+			markModelModified();
 
 			break;
 		default:
@@ -21,6 +21,11 @@
 #ifndef OTTER_BOOKMARKSMODEL_H
 #define OTTER_BOOKMARKSMODEL_H
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QXmlStreamReader>
 #include <QtCore/QXmlStreamWriter>
@@ -97,6 +102,9 @@ public:
 	protected:
 		explicit Bookmark();
 
+	private:
+		QUrl m_normalizedUrl;
+
 	friend class BookmarksModel;
 	};
 
@@ -108,8 +116,12 @@ public:
 
 	explicit BookmarksModel(const QString &path, FormatMode mode, QObject *parent = nullptr);
 
+	static void preloadBookmarks(const QString &path);
+
 	void beginImport(Bookmark *target, int estimatedUrlsAmount = 0, int estimatedKeywordsAmount = 0);
 	void endImport();
+	void beginBulkEdit();
+	void endBulkEdit();
 	void trashBookmark(Bookmark *bookmark);
 	void restoreBookmark(Bookmark *bookmark);
 	void removeBookmark(Bookmark *bookmark);
@@ -130,7 +142,7 @@ public:
 	bool moveBookmark(Bookmark *bookmark, Bookmark *newParent, int newRow = -1);
 	bool canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const override;
 	bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) override;
-	bool save(const QString &path) const;
+	bool save(const QString &path);
 	bool setData(const QModelIndex &index, const QVariant &value, int role) override;
 	bool hasBookmark(const QUrl &url) const;
 	bool hasFeed(const QUrl &url) const;
@@ -140,14 +152,45 @@ public slots:
 	void emptyTrash();
 
 protected:
-	void readBookmark(QXmlStreamReader *reader, Bookmark *parent);
-	void writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark) const;
+	struct BookmarkNode final
+	{
+		QString title;
+		QString description;
+		QString keyword;
+		QString url;
+		QUrl normalizedUrl;
+		QDateTime timeAdded;
+		QDateTime timeModified;
+		QDateTime timeVisited;
+		quint64 identifier = 0;
+		BookmarkType type = UnknownBookmark;
+		int parent = -1;
+		int visits = 0;
+	};
+
+	struct LoadResult final
+	{
+		QVector<BookmarkNode> nodes;
+		QString errorString;
+		bool hasFailedOpening = false;
+		bool hasFailedParsing = false;
+	};
+
+	void attachBookmarks(const QVector<BookmarkNode> &nodes);
+	void createSnapshot(Bookmark *bookmark, int parent, QVector<BookmarkNode> *nodes) const;
 	void removeBookmarkUrl(Bookmark *bookmark);
+	void removeBookmarkIndexes(Bookmark *bookmark);
 	void readdBookmarkUrl(Bookmark *bookmark);
+	void markBookmarkModified(Bookmark *bookmark);
+	void markModelModified();
 	void setupFeed(Bookmark *bookmark);
 	void handleKeywordChanged(Bookmark *bookmark, const QString &newKeyword, const QString &oldKeyword = {});
 	void handleUrlChanged(Bookmark *bookmark, const QUrl &newUrl, const QUrl &oldUrl = {});
-	static QDateTime readDateTime(QXmlStreamReader *reader, const QString &attribute);
+	static void readBookmarkNode(QXmlStreamReader *reader, int parent, QVector<BookmarkNode> *nodes);
+	static void writeBookmarkNode(QXmlStreamWriter *writer, const QVector<BookmarkNode> &nodes, const QVector<QVector<int> > &children, int index, FormatMode mode);
+	static QDateTime readDateTime(const QStringRef &value);
+	static LoadResult loadBookmarks(const QString &path);
+	static bool writeBookmarks(const QString &path, const QVector<BookmarkNode> &nodes, FormatMode mode, quint64 generation);
 
 protected slots:
 	void handleFeedModified(Feed *feed);
@@ -162,7 +205,15 @@ private:
 	QHash<QUrl, QVector<Bookmark*> > m_urls;
 	QHash<QString, Bookmark*> m_keywords;
 	QMap<quint64, Bookmark*> m_identifiers;
+	QSet<quint64> m_bulkModifiedBookmarks;
 	FormatMode m_mode;
+	int m_bulkEditDepth;
+	bool m_isBulkModified;
+
+	static QHash<QString, QFuture<LoadResult> > m_preloadedBookmarks;
+	static QHash<QString, quint64> m_savedGenerations;
+	static QMutex m_saveMutex;
+	static quint64 m_saveGeneration;
 
 signals:
 	void bookmarkAdded(Bookmark *bookmark);
@@ -172,6 +223,7 @@ signals:
 	void bookmarkRestored(Bookmark *bookmark);
 	void bookmarkRemoved(Bookmark *bookmark, Bookmark *previousParent);
 	void modelModified();
+	void saveFinished(const QString &path, bool isSuccess);
 
 friend class Bookmark;
 };
@@ -20,14 +20,22 @@
 #include "Console.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QTimerEvent>
 
 namespace Otter
 {
 
 Console* Console::m_instance(nullptr);
+QMutex Console::m_mutex;
 QVector<Console::Message> Console::m_messages;
+QVector<int> Console::m_categoryCounters;
+int Console::m_firstMessage(0);
+int Console::m_messagesAmount(0);
+int Console::m_pendingMessagesAmount(0);
+bool Console::m_isNotificationScheduled(false);
 
-Console::Console(QObject *parent) : QObject(parent)
+Console::Console(QObject *parent) : QObject(parent),
+	m_notificationTimer(0)
 {
 }
 
@@ -35,12 +43,61 @@ void Console::createInstance()
 {
 	if (!m_instance)
 	{
+		m_messages.resize(m_capacity);
+		m_categoryCounters.fill(0, (JavaScriptCategory + 1));
+
 		m_instance = new Console(QCoreApplication::instance());
 	}
 }
 
+void Console::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_notificationTimer)
+	{
+		return;
+	}
+
+	killTimer(m_notificationTimer);
+
+	m_notificationTimer = 0;
+
+	QVector<Message> messages;
+
+	m_mutex.lock();
+
+	messages.reserve(m_pendingMessagesAmount);
+
+	for (int i = (m_messagesAmount - m_pendingMessagesAmount); i < m_messagesAmount; ++i)
+	{
+		messages.append(m_messages.at((m_firstMessage + i) % m_capacity));
+	}
+
+	m_pendingMessagesAmount = 0;
+	m_isNotificationScheduled = false;
+
+	m_mutex.unlock();
+
+	if (!messages.isEmpty())
+	{
+		emit messagesAdded(messages);
+	}
+}
+
+void Console::scheduleNotification()
+{
+	if (m_notificationTimer == 0)
+	{
+		m_notificationTimer = startTimer(m_notificationInterval);
+	}
+}
+
 void Console::addMessage(const QString &note, MessageCategory category, MessageLevel level, const QString &source, int line, quint64 window)
 {
+	if (!m_instance)
+	{
+		return;
+	}
+
 	Message message;
 	message.note = note;
 	message.source = source;
@@ -49,14 +106,38 @@ void Console::addMessage(const QString &note, MessageCategory category, MessageL
 	message.line = line;
 	message.window = window;
 
-	m_messages.append(message);
+	m_mutex.lock();
 
-	if (m_messages.count() > 1000)
+	++m_categoryCounters[category];
+
+	if (m_pendingMessagesAmount > 0 && m_messages.at((m_firstMessage + m_messagesAmount - 1) % m_capacity).isSameMessage(message))
 	{
-		m_messages.removeFirst();
+		++m_messages[(m_firstMessage + m_messagesAmount - 1) % m_capacity].count;
 	}
+	else if (m_messagesAmount < m_capacity)
+	{
+		m_messages[(m_firstMessage + m_messagesAmount) % m_capacity] = message;
 
-	emit m_instance->messageAdded(message);
+		++m_messagesAmount;
+		++m_pendingMessagesAmount;
+	}
+	else
+	{
+		m_messages[m_firstMessage] = message;
+		m_firstMessage = ((m_firstMessage + 1) % m_capacity);
+		m_pendingMessagesAmount = qMin((m_pendingMessagesAmount + 1), m_capacity);
+	}
+
+	const bool needsNotification(!m_isNotificationScheduled);
+
+	m_isNotificationScheduled = true;
+
+	m_mutex.unlock();
+
+	if (needsNotification)
+	{
+		QMetaObject::invokeMethod(m_instance, "scheduleNotification", Qt::QueuedConnection);
+	}
 }
 
 Console* Console::getInstance()
@@ -66,7 +147,31 @@ Console* Console::getInstance()
 
 QVector<Console::Message> Console::getMessages()
 {
-	return m_messages;
+	QVector<Message> messages;
+
+	m_mutex.lock();
+
+	messages.reserve(m_messagesAmount - m_pendingMessagesAmount);
+
+	for (int i = 0; i < (m_messagesAmount - m_pendingMessagesAmount); ++i)
+	{
+		messages.append(m_messages.at((m_firstMessage + i) % m_capacity));
+	}
+
+	m_mutex.unlock();
+
+	return messages;
+}
+
+int Console::getMessagesCount(MessageCategory category)
+{
+	m_mutex.lock();
+
+	const int count(m_categoryCounters.value(category, 0));
+
+	m_mutex.unlock();
+
+	return count;
 }
 
 }
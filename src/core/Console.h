@@ -21,6 +21,7 @@
 #define OTTER_CONSOLE_H
 
 #include <QtCore/QDateTime>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QVector>
 
@@ -60,22 +61,45 @@ public:
 		MessageLevel level = UnknownLevel;
 		quint64 window = 0;
 		int line = -1;
+		int count = 1;
+
+		bool isSameMessage(const Message &other) const
+		{
+			return (category == other.category && level == other.level && line == other.line && window == other.window && note == other.note && source == other.source);
+		}
 	};
 
 	static void createInstance();
 	static void addMessage(const QString &note, MessageCategory category, MessageLevel level, const QString &source = {}, int line = -1, quint64 window = 0);
 	static Console* getInstance();
 	static QVector<Console::Message> getMessages();
+	static int getMessagesCount(MessageCategory category);
 
 protected:
 	explicit Console(QObject *parent = nullptr);
 
+	void timerEvent(QTimerEvent *event) override;
+
+protected slots:
+	void scheduleNotification();
+
 private:
+	int m_notificationTimer;
+
 	static Console *m_instance;
+	static QMutex m_mutex;
 	static QVector<Message> m_messages;
+	static QVector<int> m_categoryCounters;
+	static int m_firstMessage;
+	static int m_messagesAmount;
+	static int m_pendingMessagesAmount;
+	static bool m_isNotificationScheduled;
+
+	static const int m_capacity = 1000;
+	static const int m_notificationInterval = 250;
 
 signals:
-	void messageAdded(const Console::Message &message);
+	void messagesAdded(const QVector<Console::Message> &messages);
 };
 
 }
@@ -21,6 +21,7 @@
 #include "ContentFiltersManager.h"
 #include "AdblockContentFiltersProfile.h"
 #include "Console.h"
+#include "HashPrefixContentFiltersProfile.h"
 #include "JsonSettings.h"
 #include "SettingsManager.h"
 #include "SessionsManager.h"
@@ -28,6 +29,7 @@
 #include "../ui/ItemViewWidget.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QTimer>
@@ -39,6 +41,16 @@ namespace Otter
 ContentFiltersManager* ContentFiltersManager::m_instance(nullptr);
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_contentBlockingProfiles;
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_fraudCheckingProfiles;
+QHash<QString, ContentFiltersManager::CosmeticFiltersStyleSheet> ContentFiltersManager::m_cosmeticFiltersStyleSheets;
+QHash<QString, QSet<QString> > ContentFiltersManager::m_genericCosmeticFilters;
+QHash<QString, QString> ContentFiltersManager::m_genericCosmeticFiltersStyleSheets;
+QCache<QString, ContentFiltersManager::CachedCheckResult> ContentFiltersManager::m_decisionCache(10000);
+QMutex ContentFiltersManager::m_decisionCacheMutex;
+ContentFiltersManager::DecisionCacheStatistics ContentFiltersManager::m_decisionCacheStatistics;
+QCache<QString, QSharedPointer<ContentFiltersManager::CombinedProfile> > ContentFiltersManager::m_combinedProfiles(10);
+QSet<QString> ContentFiltersManager::m_pendingCombinedProfiles;
+QMutex ContentFiltersManager::m_combinedProfilesMutex;
+quint64 ContentFiltersManager::m_combinedProfilesGeneration(0);
 ContentFiltersManager::CosmeticFiltersMode ContentFiltersManager::m_cosmeticFiltersMode(AllFilters);
 bool ContentFiltersManager::m_areWildcardsEnabled(true);
 
@@ -55,6 +67,7 @@ ContentFiltersManager::ContentFiltersManager(QObject *parent) : QObject(parent),
 	});
 
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &ContentFiltersManager::handleOptionChanged);
+	connect(this, &ContentFiltersManager::combinedProfileRequested, this, &ContentFiltersManager::createCombinedProfile, Qt::QueuedConnection);
 }
 
 void ContentFiltersManager::createInstance()
@@ -169,8 +182,15 @@ void ContentFiltersManager::initialize()
 
 		m_contentBlockingProfiles.append(profile);
 
+		connect(profile, &ContentFiltersProfile::rulesModified, profile, [=]()
+		{
+			clearCombinedProfiles(m_contentBlockingProfiles.indexOf(profile));
+		});
 		connect(profile, &ContentFiltersProfile::profileModified, profile, [=]()
 		{
+			clearCosmeticFiltersCache();
+			invalidateDecisionCache();
+
 			m_instance->scheduleSave();
 
 			emit m_instance->profileModified(profile->getName());
@@ -178,6 +198,77 @@ void ContentFiltersManager::initialize()
 	}
 
 	m_contentBlockingProfiles.squeeze();
+
+	const QJsonObject bundledFraudCheckingObject(JsonSettings(SessionsManager::getReadableDataPath(QLatin1String("fraudChecking.json"), true)).object());
+	const QJsonObject localFraudCheckingObject(JsonSettings(SessionsManager::getWritableDataPath(QLatin1String("fraudChecking.json"))).object());
+	QStringList fraudCheckingProfiles(bundledFraudCheckingObject.keys());
+
+	for (iterator = localFraudCheckingObject.constBegin(); iterator != localFraudCheckingObject.constEnd(); ++iterator)
+	{
+		if (!fraudCheckingProfiles.contains(iterator.key()))
+		{
+			fraudCheckingProfiles.append(iterator.key());
+		}
+	}
+
+	fraudCheckingProfiles.sort();
+
+	for (int i = 0; i < fraudCheckingProfiles.count(); ++i)
+	{
+		QJsonObject profileObject(localFraudCheckingObject.value(fraudCheckingProfiles.at(i)).toObject());
+		const QJsonObject bundledProfileObject(bundledFraudCheckingObject.value(fraudCheckingProfiles.at(i)).toObject());
+		QString title;
+		QUrl updateUrl;
+		ContentFiltersProfile::ProfileFlags flags(ContentFiltersProfile::NoFlags);
+
+		if (profileObject.isEmpty())
+		{
+			profileObject = bundledProfileObject;
+			updateUrl = QUrl(profileObject.value(QLatin1String("updateUrl")).toString());
+			title = profileObject.value(QLatin1String("title")).toString();
+		}
+		else
+		{
+			if (profileObject.value(QLatin1String("isHidden")).toBool())
+			{
+				continue;
+			}
+
+			updateUrl = QUrl(profileObject.value(QLatin1String("updateUrl")).toString());
+			title = profileObject.value(QLatin1String("title")).toString();
+
+			if (updateUrl.isEmpty())
+			{
+				updateUrl = QUrl(bundledProfileObject.value(QLatin1String("updateUrl")).toString());
+			}
+			else
+			{
+				flags |= ContentFiltersProfile::HasCustomUpdateUrlFlag;
+			}
+
+			if (title.isEmpty())
+			{
+				title = bundledProfileObject.value(QLatin1String("title")).toString();
+			}
+			else
+			{
+				flags |= ContentFiltersProfile::HasCustomTitleFlag;
+			}
+		}
+
+		ContentFiltersProfile *profile(new HashPrefixContentFiltersProfile(fraudCheckingProfiles.at(i), title, updateUrl, profileObject.value(QLatin1String("updateInterval")).toInt(), flags, m_instance));
+
+		m_fraudCheckingProfiles.append(profile);
+
+		connect(profile, &ContentFiltersProfile::profileModified, profile, [=]()
+		{
+			invalidateDecisionCache();
+
+			m_instance->scheduleSave();
+
+			emit m_instance->profileModified(profile->getName());
+		});
+	}
 }
 
 void ContentFiltersManager::timerEvent(QTimerEvent *event)
@@ -262,6 +353,58 @@ void ContentFiltersManager::timerEvent(QTimerEvent *event)
 
 		settings.setObject(mainObject);
 		settings.save();
+
+		JsonSettings fraudCheckingSettings(SessionsManager::getWritableDataPath(QLatin1String("fraudChecking.json")));
+		QJsonObject fraudCheckingObject(fraudCheckingSettings.object());
+
+		iterator = fraudCheckingObject.begin();
+
+		while (iterator != fraudCheckingObject.end())
+		{
+			const QJsonObject profileObject(fraudCheckingObject.value(iterator.key()).toObject());
+
+			if (profileObject.value(QLatin1String("isHidden")).toBool())
+			{
+				++iterator;
+			}
+			else
+			{
+				iterator = fraudCheckingObject.erase(iterator);
+			}
+		}
+
+		for (int i = 0; i < m_fraudCheckingProfiles.count(); ++i)
+		{
+			const ContentFiltersProfile *profile(m_fraudCheckingProfiles.at(i));
+
+			if (!profile)
+			{
+				continue;
+			}
+
+			QJsonObject profileObject;
+			const int updateInterval(profile->getUpdateInterval());
+
+			if (updateInterval > 0)
+			{
+				profileObject.insert(QLatin1String("updateInterval"), updateInterval);
+			}
+
+			if (profile->getFlags().testFlag(ContentFiltersProfile::HasCustomTitleFlag))
+			{
+				profileObject.insert(QLatin1String("title"), profile->getTitle());
+			}
+
+			if (profile->getFlags().testFlag(ContentFiltersProfile::HasCustomUpdateUrlFlag))
+			{
+				profileObject.insert(QLatin1String("updateUrl"), profile->getUpdateUrl().url());
+			}
+
+			fraudCheckingObject.insert(profile->getName(), profileObject);
+		}
+
+		fraudCheckingSettings.setObject(fraudCheckingObject);
+		fraudCheckingSettings.save();
 	}
 }
 
@@ -279,9 +422,21 @@ void ContentFiltersManager::addProfile(ContentFiltersProfile *profile)
 	{
 		m_contentBlockingProfiles.append(profile);
 
+		clearCosmeticFiltersCache();
+		clearCombinedProfiles();
+		invalidateDecisionCache();
+
 		getInstance()->scheduleSave();
 
 		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::scheduleSave);
+		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::clearCosmeticFiltersCache);
+		connect(profile, &ContentFiltersProfile::rulesModified, m_instance, [=]()
+		{
+			clearCombinedProfiles(m_contentBlockingProfiles.indexOf(profile));
+		});
+		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::invalidateDecisionCache);
+
+		emit m_instance->profileModified(profile->getName());
 	}
 }
 
@@ -293,6 +448,10 @@ void ContentFiltersManager::handleOptionChanged(int identifier, const QVariant &
 			m_areWildcardsEnabled = value.toBool();
 
 			break;
+		case SettingsManager::ContentBlocking_IgnoreHostsOption:
+			invalidateDecisionCache();
+
+			return;
 		case SettingsManager::ContentBlocking_CosmeticFiltersModeOption:
 			{
 				const QString cosmeticFiltersMode(value.toString());
@@ -320,6 +479,106 @@ void ContentFiltersManager::handleOptionChanged(int identifier, const QVariant &
 	{
 		m_contentBlockingProfiles.at(i)->clear();
 	}
+
+	clearCosmeticFiltersCache();
+	clearCombinedProfiles();
+	invalidateDecisionCache();
+}
+
+void ContentFiltersManager::clearCosmeticFiltersCache()
+{
+	m_cosmeticFiltersStyleSheets.clear();
+	m_genericCosmeticFilters.clear();
+	m_genericCosmeticFiltersStyleSheets.clear();
+}
+
+void ContentFiltersManager::clearCombinedProfiles(int profile)
+{
+	QMutexLocker locker(&m_combinedProfilesMutex);
+
+	++m_combinedProfilesGeneration;
+
+	m_pendingCombinedProfiles.clear();
+
+	if (profile < 0)
+	{
+		m_combinedProfiles.clear();
+
+		return;
+	}
+
+	const QString identifier(QString::number(profile));
+	const QList<QString> keys(m_combinedProfiles.keys());
+
+	for (int i = 0; i < keys.count(); ++i)
+	{
+		if (keys.at(i).split(QLatin1Char(',')).contains(identifier))
+		{
+			m_combinedProfiles.remove(keys.at(i));
+		}
+	}
+}
+
+void ContentFiltersManager::createCombinedProfile(const QString &key)
+{
+	m_combinedProfilesMutex.lock();
+
+	const quint64 generation(m_combinedProfilesGeneration);
+	const bool isPending(m_pendingCombinedProfiles.contains(key));
+
+	m_combinedProfilesMutex.unlock();
+
+	if (!isPending)
+	{
+		return;
+	}
+
+	const QStringList identifiers(key.split(QLatin1Char(',')));
+	QVector<QPair<int, AdblockContentFiltersProfile*> > profiles;
+	profiles.reserve(identifiers.count());
+
+	for (int i = 0; i < identifiers.count(); ++i)
+	{
+		const int identifier(identifiers.at(i).toInt());
+
+		if (identifier >= 0 && identifier < m_contentBlockingProfiles.count())
+		{
+			AdblockContentFiltersProfile *profile(qobject_cast<AdblockContentFiltersProfile*>(m_contentBlockingProfiles.at(identifier)));
+
+			if (profile)
+			{
+				profiles.append({identifier, profile});
+			}
+		}
+	}
+
+	QFutureWatcher<AdblockContentFiltersProfile*> *watcher(new QFutureWatcher<AdblockContentFiltersProfile*>(this));
+
+	connect(watcher, &QFutureWatcher<AdblockContentFiltersProfile*>::finished, this, [=]()
+	{
+		QSharedPointer<CombinedProfile> combinedProfile(new CombinedProfile());
+		combinedProfile->profile = QSharedPointer<AdblockContentFiltersProfile>(watcher->result());
+
+		watcher->deleteLater();
+
+		QMutexLocker locker(&m_combinedProfilesMutex);
+
+		if (generation == m_combinedProfilesGeneration && m_pendingCombinedProfiles.remove(key))
+		{
+			m_combinedProfiles.insert(key, new QSharedPointer<CombinedProfile>(combinedProfile));
+		}
+	});
+
+	watcher->setFuture(AdblockContentFiltersProfile::createCombinedProfile(profiles));
+}
+
+void ContentFiltersManager::invalidateDecisionCache()
+{
+	QMutexLocker locker(&m_decisionCacheMutex);
+
+	++m_decisionCacheStatistics.generation;
+
+	m_decisionCache.clear();
 }
 
 void ContentFiltersManager::removeProfile(ContentFiltersProfile *profile)
@@ -352,6 +611,12 @@ void ContentFiltersManager::removeProfile(ContentFiltersProfile *profile)
 
 	m_contentBlockingProfiles.removeAll(profile);
 
+	clearCosmeticFiltersCache();
+	clearCombinedProfiles();
+	invalidateDecisionCache();
+
+	emit m_instance->profileModified(profile->getName());
+
 	profile->deleteLater();
 }
 
@@ -495,15 +760,138 @@ ContentFiltersManager::CheckResult ContentFiltersManager::checkUrl(const QVector
 		return {};
 	}
 
+	QString key;
+	key.reserve(requestUrl.url().length() + 64);
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		key.append(QString::number(profiles.at(i)) + QLatin1Char(','));
+	}
+
+	key.append(QLatin1Char('|') + baseUrl.host() + QLatin1Char('|') + QString::number(resourceType) + QLatin1Char('|') + requestUrl.url());
+
+	quint64 generation(0);
+
+	{
+		QMutexLocker locker(&m_decisionCacheMutex);
+
+		++m_decisionCacheStatistics.lookupsAmount;
+
+		const CachedCheckResult *cachedResult(m_decisionCache.object(key));
+
+		if (cachedResult && cachedResult->generation == m_decisionCacheStatistics.generation)
+		{
+			++m_decisionCacheStatistics.hitsAmount;
+
+			return cachedResult->result;
+		}
+
+		generation = m_decisionCacheStatistics.generation;
+	}
+
+	CachedCheckResult *cachedResult(new CachedCheckResult());
+	cachedResult->result = checkUrlUncached(profiles, baseUrl, requestUrl, resourceType);
+	cachedResult->generation = generation;
+
+	const CheckResult result(cachedResult->result);
+	QMutexLocker locker(&m_decisionCacheMutex);
+
+	if (generation == m_decisionCacheStatistics.generation)
+	{
+		m_decisionCache.insert(key, cachedResult);
+	}
+	else
+	{
+		delete cachedResult;
+	}
+
+	return result;
+}
+
+ContentFiltersManager::CheckResult ContentFiltersManager::checkUrlUncached(const QVector<int> &profiles, const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType)
+{
 	CheckResult result;
 	result.isFraud = ((resourceType == NetworkManager::MainFrameType || resourceType == NetworkManager::SubFrameType) ? isFraud(requestUrl) : false);
 
-	for (int i = 0; i < profiles.count(); ++i)
+	QVector<int> remainingProfiles;
+
+	if (profiles.count() > 1)
+	{
+		QStringList profilesList;
+		profilesList.reserve(profiles.count());
+
+		for (int i = 0; i < profiles.count(); ++i)
+		{
+			profilesList.append(QString::number(profiles.at(i)));
+		}
+
+		const QString key(profilesList.join(QLatin1Char(',')));
+		QSharedPointer<CombinedProfile> combinedProfile;
+
+		m_combinedProfilesMutex.lock();
+
+		const QSharedPointer<CombinedProfile> *cachedProfile(m_combinedProfiles.object(key));
+
+		if (cachedProfile)
+		{
+			combinedProfile = *cachedProfile;
+		}
+		else if (m_instance && !m_pendingCombinedProfiles.contains(key))
+		{
+			m_pendingCombinedProfiles.insert(key);
+
+			emit m_instance->combinedProfileRequested(key);
+		}
+
+		m_combinedProfilesMutex.unlock();
+
+		if (combinedProfile)
+		{
+			combinedProfile->mutex.lock();
+
+			const CheckResult currentResult(combinedProfile->profile->checkUrl(baseUrl, requestUrl, resourceType));
+
+			combinedProfile->mutex.unlock();
+
+			if (currentResult.isBlocked || currentResult.isException)
+			{
+				const bool isFraud(result.isFraud);
+
+				result = currentResult;
+				result.isFraud = isFraud;
+
+				if (result.isException)
+				{
+					return result;
+				}
+			}
+
+			for (int i = 0; i < profiles.count(); ++i)
+			{
+				if (profiles.at(i) >= 0 && profiles.at(i) < m_contentBlockingProfiles.count() && !qobject_cast<AdblockContentFiltersProfile*>(m_contentBlockingProfiles.at(profiles.at(i))))
+				{
+					remainingProfiles.append(profiles.at(i));
+				}
+			}
+		}
+		else
+		{
+			remainingProfiles = profiles;
+		}
+	}
+	else
 	{
-		if (profiles.at(i) >= 0 && profiles.at(i) < m_contentBlockingProfiles.count())
+		remainingProfiles = profiles;
+	}
+
+	for (int i = 0; i < remainingProfiles.count(); ++i)
+	{
+		const int identifier(remainingProfiles.at(i));
+
+		if (identifier >= 0 && identifier < m_contentBlockingProfiles.count())
 		{
-			CheckResult currentResult(m_contentBlockingProfiles.at(profiles.at(i))->checkUrl(baseUrl, requestUrl, resourceType));
-			currentResult.profile = profiles.at(i);
+			CheckResult currentResult(m_contentBlockingProfiles.at(identifier)->checkUrl(baseUrl, requestUrl, resourceType));
+			currentResult.profile = identifier;
 			currentResult.isFraud = result.isFraud;
 
 			if (currentResult.isBlocked)
@@ -553,6 +941,108 @@ ContentFiltersManager::CosmeticFiltersResult ContentFiltersManager::getCosmeticF
 	return result;
 }
 
+QString ContentFiltersManager::createStyleSheet(const QStringList &rules, const QSet<QString> &exceptions)
+{
+	QString styleSheet;
+
+	for (int i = 0; i < rules.count(); ++i)
+	{
+		if (!exceptions.contains(rules.at(i)))
+		{
+			styleSheet.append(rules.at(i) + QLatin1String(" {display:none !important;}\n"));
+		}
+	}
+
+	return styleSheet;
+}
+
+QString ContentFiltersManager::getCosmeticFiltersStyleSheet(const QVector<int> &profiles, const QUrl &requestUrl)
+{
+	if (profiles.isEmpty() || m_cosmeticFiltersMode == NoFilters)
+	{
+		return {};
+	}
+
+	const CosmeticFiltersMode mode(checkUrl(profiles, requestUrl, requestUrl, NetworkManager::OtherType).comesticFiltersMode);
+
+	if (mode == NoFilters)
+	{
+		return {};
+	}
+
+	QStringList profilesList;
+	profilesList.reserve(profiles.count());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		profilesList.append(QString::number(profiles.at(i)));
+	}
+
+	const QString genericKey(profilesList.join(QLatin1Char(',')));
+	const QString domainKey(genericKey + ((mode == DomainOnlyFilters) ? QLatin1String("|domain|") : QLatin1String("|all|")) + requestUrl.host());
+
+	if (mode == AllFilters && !m_genericCosmeticFilters.contains(genericKey))
+	{
+		QStringList rules;
+
+		for (int i = 0; i < profiles.count(); ++i)
+		{
+			const int index(profiles.at(i));
+
+			if (index >= 0 && index < m_contentBlockingProfiles.count())
+			{
+				rules.append(m_contentBlockingProfiles.at(index)->getCosmeticFilters({}, false).rules);
+			}
+		}
+
+		m_genericCosmeticFilters[genericKey] = rules.toSet();
+		m_genericCosmeticFiltersStyleSheets[genericKey] = createStyleSheet(rules, {});
+	}
+
+	if (!m_cosmeticFiltersStyleSheets.contains(domainKey))
+	{
+		if (m_cosmeticFiltersStyleSheets.count() > 1000)
+		{
+			m_cosmeticFiltersStyleSheets.clear();
+		}
+
+		const QStringList domains(createSubdomainList(requestUrl.host()));
+		CosmeticFiltersResult result;
+
+		for (int i = 0; i < profiles.count(); ++i)
+		{
+			const int index(profiles.at(i));
+
+			if (index >= 0 && index < m_contentBlockingProfiles.count())
+			{
+				const CosmeticFiltersResult profileResult(m_contentBlockingProfiles.at(index)->getCosmeticFilters(domains, true));
+
+				result.rules.append(profileResult.rules);
+				result.exceptions.append(profileResult.exceptions);
+			}
+		}
+
+		const QSet<QString> exceptions(result.exceptions.toSet());
+		CosmeticFiltersStyleSheet styleSheet;
+
+		if (mode == AllFilters && m_genericCosmeticFilters.value(genericKey).intersects(exceptions))
+		{
+			styleSheet.styleSheet = createStyleSheet((m_genericCosmeticFilters.value(genericKey).toList() + result.rules), exceptions);
+		}
+		else
+		{
+			styleSheet.styleSheet = createStyleSheet(result.rules, exceptions);
+			styleSheet.needsGenericStyleSheet = (mode == AllFilters);
+		}
+
+		m_cosmeticFiltersStyleSheets[domainKey] = styleSheet;
+	}
+
+	const CosmeticFiltersStyleSheet styleSheet(m_cosmeticFiltersStyleSheets.value(domainKey));
+
+	return (styleSheet.needsGenericStyleSheet ? (m_genericCosmeticFiltersStyleSheets.value(genericKey) + styleSheet.styleSheet) : styleSheet.styleSheet);
+}
+
 QStringList ContentFiltersManager::createSubdomainList(const QString &domain)
 {
 	QStringList subdomainList;
@@ -623,6 +1113,16 @@ ContentFiltersManager::CosmeticFiltersMode ContentFiltersManager::getCosmeticFil
 	return m_cosmeticFiltersMode;
 }
 
+ContentFiltersManager::DecisionCacheStatistics ContentFiltersManager::getDecisionCacheStatistics()
+{
+	QMutexLocker locker(&m_decisionCacheMutex);
+
+	DecisionCacheStatistics statistics(m_decisionCacheStatistics);
+	statistics.entriesAmount = m_decisionCache.count();
+
+	return statistics;
+}
+
 bool ContentFiltersManager::areWildcardsEnabled()
 {
 	return m_areWildcardsEnabled;
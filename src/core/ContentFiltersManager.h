@@ -23,12 +23,17 @@
 
 #include "NetworkManager.h"
 
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QUrl>
 #include <QtGui/QStandardItemModel>
 
 namespace Otter
 {
 
+class AdblockContentFiltersProfile;
 class ContentFiltersProfile;
 
 class ContentFiltersManager final : public QObject
@@ -70,6 +75,14 @@ public:
 		QStringList exceptions;
 	};
 
+	struct DecisionCacheStatistics final
+	{
+		quint64 generation = 0;
+		quint64 lookupsAmount = 0;
+		quint64 hitsAmount = 0;
+		int entriesAmount = 0;
+	};
+
 	static void createInstance();
 	static void initialize();
 	static void addProfile(ContentFiltersProfile *profile);
@@ -81,23 +94,49 @@ public:
 	static ContentFiltersProfile* getProfile(int identifier);
 	static CheckResult checkUrl(const QVector<int> &profiles, const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType);
 	static CosmeticFiltersResult getCosmeticFilters(const QVector<int> &profiles, const QUrl &requestUrl);
+	static QString getCosmeticFiltersStyleSheet(const QVector<int> &profiles, const QUrl &requestUrl);
 	static QStringList createSubdomainList(const QString &domain);
 	static QStringList getProfileNames();
 	static QVector<ContentFiltersProfile*> getContentBlockingProfiles();
 	static QVector<ContentFiltersProfile*> getFraudCheckingProfiles();
 	static QVector<int> getProfileIdentifiers(const QStringList &names);
 	static CosmeticFiltersMode getCosmeticFiltersMode();
+	static DecisionCacheStatistics getDecisionCacheStatistics();
 	static bool areWildcardsEnabled();
 	static bool isFraud(const QUrl &url);
 
 protected:
 	explicit ContentFiltersManager(QObject *parent);
 
+	struct CosmeticFiltersStyleSheet final
+	{
+		QString styleSheet;
+		bool needsGenericStyleSheet = false;
+	};
+
+	struct CachedCheckResult final
+	{
+		CheckResult result;
+		quint64 generation = 0;
+	};
+
+	struct CombinedProfile final
+	{
+		QSharedPointer<AdblockContentFiltersProfile> profile;
+		QMutex mutex;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
+	static void clearCosmeticFiltersCache();
+	static void invalidateDecisionCache();
+	static void clearCombinedProfiles(int profile = -1);
+	static CheckResult checkUrlUncached(const QVector<int> &profiles, const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType);
+	static QString createStyleSheet(const QStringList &rules, const QSet<QString> &exceptions);
 
 protected slots:
 	void scheduleSave();
 	void handleOptionChanged(int identifier, const QVariant &value);
+	void createCombinedProfile(const QString &key);
 
 private:
 	int m_saveTimer;
@@ -105,11 +144,22 @@ private:
 	static ContentFiltersManager *m_instance;
 	static QVector<ContentFiltersProfile*> m_contentBlockingProfiles;
 	static QVector<ContentFiltersProfile*> m_fraudCheckingProfiles;
+	static QHash<QString, CosmeticFiltersStyleSheet> m_cosmeticFiltersStyleSheets;
+	static QHash<QString, QSet<QString> > m_genericCosmeticFilters;
+	static QHash<QString, QString> m_genericCosmeticFiltersStyleSheets;
+	static QCache<QString, CachedCheckResult> m_decisionCache;
+	static QMutex m_decisionCacheMutex;
+	static DecisionCacheStatistics m_decisionCacheStatistics;
+	static QCache<QString, QSharedPointer<CombinedProfile> > m_combinedProfiles;
+	static QSet<QString> m_pendingCombinedProfiles;
+	static QMutex m_combinedProfilesMutex;
+	static quint64 m_combinedProfilesGeneration;
 	static CosmeticFiltersMode m_cosmeticFiltersMode;
 	static bool m_areWildcardsEnabled;
 
 signals:
 	void profileModified(const QString &profile);
+	void combinedProfileRequested(const QString &key);
 };
 
 class ContentFiltersProfile : public QObject
@@ -170,6 +220,7 @@ public:
 
 signals:
 	void profileModified();
+	void rulesModified();
 	void updateProgressChanged(int progress);
 };
 
@@ -0,0 +1,464 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "FaviconsDatabase.h"
+#include "Console.h"
+#include "SessionsManager.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+#include <QtCore/QTimerEvent>
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+
+namespace Otter
+{
+
+FaviconsDatabase::FaviconsDatabase(const QString &path, QObject *parent) : QObject(parent),
+	m_file(path),
+	m_icons(200),
+	m_data(nullptr),
+	m_indexOffset(m_headerSize),
+	m_saveTimer(0),
+	m_isModified(false)
+{
+	load();
+}
+
+FaviconsDatabase::~FaviconsDatabase()
+{
+	save();
+}
+
+void FaviconsDatabase::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_saveTimer)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+
+		save();
+	}
+}
+
+void FaviconsDatabase::load()
+{
+	if (!m_file.exists() || !m_file.open(QIODevice::ReadOnly))
+	{
+		return;
+	}
+
+	QDataStream stream(&m_file);
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	quint32 magic(0);
+	quint32 version(0);
+	quint64 indexOffset(0);
+
+	stream >> magic >> version >> indexOffset;
+
+	if (magic != m_magic || version != m_version || indexOffset < m_headerSize || indexOffset > static_cast<quint64>(m_file.size()) || !m_file.seek(static_cast<qint64>(indexOffset)))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to load favicons database: invalid header"), Console::OtherCategory, Console::ErrorLevel, m_file.fileName());
+
+		m_file.close();
+
+		return;
+	}
+
+	quint32 blobsAmount(0);
+
+	stream >> blobsAmount;
+
+	for (quint32 i = 0; (i < blobsAmount && stream.status() == QDataStream::Ok); ++i)
+	{
+		QByteArray hash;
+		BlobLocation location;
+
+		stream >> hash >> location.offset >> location.size;
+
+		if ((location.offset + location.size) <= indexOffset)
+		{
+			m_blobs[hash] = location;
+		}
+	}
+
+	quint32 keysAmount(0);
+
+	stream >> keysAmount;
+
+	for (quint32 i = 0; (i < keysAmount && stream.status() == QDataStream::Ok); ++i)
+	{
+		QString key;
+		QByteArray hash;
+
+		stream >> key >> hash;
+
+		if (m_blobs.contains(hash))
+		{
+			m_keys[key] = hash;
+		}
+	}
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to load favicons database: invalid index"), Console::OtherCategory, Console::ErrorLevel, m_file.fileName());
+
+		m_keys.clear();
+		m_blobs.clear();
+		m_file.close();
+
+		return;
+	}
+
+	m_indexOffset = indexOffset;
+
+	map();
+}
+
+void FaviconsDatabase::map()
+{
+	m_data = ((m_file.isOpen() && m_indexOffset > m_headerSize) ? m_file.map(0, static_cast<qint64>(m_indexOffset)) : nullptr);
+}
+
+void FaviconsDatabase::clear()
+{
+	if (m_saveTimer != 0)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+	}
+
+	m_file.close();
+
+	if (!SessionsManager::isReadOnly())
+	{
+		m_file.remove();
+	}
+
+	m_keys.clear();
+	m_blobs.clear();
+	m_pendingBlobs.clear();
+	m_icons.clear();
+
+	m_data = nullptr;
+	m_indexOffset = m_headerSize;
+	m_isModified = false;
+}
+
+void FaviconsDatabase::save()
+{
+	if (!m_isModified || SessionsManager::isReadOnly())
+	{
+		return;
+	}
+
+	if (m_saveTimer != 0)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+	}
+
+	QSaveFile file(m_file.fileName());
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to save favicons database: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, m_file.fileName());
+
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_6);
+	stream << m_magic << m_version << static_cast<quint64>(0);
+
+	QHash<QByteArray, BlobLocation> blobs;
+	QHash<QString, QByteArray>::iterator keysIterator(m_keys.begin());
+
+	while (keysIterator != m_keys.end())
+	{
+		const QByteArray hash(keysIterator.value());
+
+		if (!blobs.contains(hash))
+		{
+			const QByteArray blob(getBlob(hash));
+
+			if (blob.isEmpty())
+			{
+				keysIterator = m_keys.erase(keysIterator);
+
+				continue;
+			}
+
+			BlobLocation location;
+			location.offset = static_cast<quint64>(file.pos());
+			location.size = static_cast<quint32>(blob.size());
+
+			file.write(blob);
+
+			blobs[hash] = location;
+		}
+
+		++keysIterator;
+	}
+
+	const quint64 indexOffset(static_cast<quint64>(file.pos()));
+
+	stream << static_cast<quint32>(blobs.count());
+
+	QHash<QByteArray, BlobLocation>::const_iterator locationsIterator;
+
+	for (locationsIterator = blobs.constBegin(); locationsIterator != blobs.constEnd(); ++locationsIterator)
+	{
+		stream << locationsIterator.key() << locationsIterator.value().offset << locationsIterator.value().size;
+	}
+
+	stream << static_cast<quint32>(m_keys.count());
+
+	for (keysIterator = m_keys.begin(); keysIterator != m_keys.end(); ++keysIterator)
+	{
+		stream << keysIterator.key() << keysIterator.value();
+	}
+
+	file.seek(0);
+
+	stream << m_magic << m_version << indexOffset;
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		file.cancelWriting();
+	}
+
+	m_file.close();
+
+	m_data = nullptr;
+
+	if (!file.commit())
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to save favicons database: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, m_file.fileName());
+
+		if (m_file.open(QIODevice::ReadOnly))
+		{
+			map();
+		}
+
+		return;
+	}
+
+	m_blobs = blobs;
+	m_pendingBlobs.clear();
+	m_indexOffset = indexOffset;
+	m_isModified = false;
+
+	if (m_file.open(QIODevice::ReadOnly))
+	{
+		map();
+	}
+}
+
+void FaviconsDatabase::removeIcons(const QVector<QUrl> &urls)
+{
+	QSet<QString> hostKeys;
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		if (m_keys.remove(getPageKey(urls.at(i))) > 0)
+		{
+			hostKeys.insert(getHostKey(urls.at(i)));
+		}
+	}
+
+	if (hostKeys.isEmpty())
+	{
+		return;
+	}
+
+	QHash<QString, QByteArray>::const_iterator iterator;
+
+	for (iterator = m_keys.constBegin(); iterator != m_keys.constEnd(); ++iterator)
+	{
+		if (!iterator.key().startsWith(QLatin1String("host:")))
+		{
+			hostKeys.remove(getHostKey(QUrl(iterator.key())));
+
+			if (hostKeys.isEmpty())
+			{
+				break;
+			}
+		}
+	}
+
+	QSet<QString>::const_iterator hostsIterator;
+
+	for (hostsIterator = hostKeys.constBegin(); hostsIterator != hostKeys.constEnd(); ++hostsIterator)
+	{
+		m_keys.remove(*hostsIterator);
+	}
+
+	scheduleSave();
+}
+
+void FaviconsDatabase::scheduleSave()
+{
+	m_isModified = true;
+
+	if (m_saveTimer == 0)
+	{
+		m_saveTimer = startTimer(5000);
+	}
+}
+
+void FaviconsDatabase::handleIconEncoded(const EncodedIcon &icon)
+{
+	if (icon.data.isEmpty())
+	{
+		return;
+	}
+
+	if (m_keys.value(icon.pageKey) == icon.hash && m_keys.value(icon.hostKey) == icon.hash)
+	{
+		return;
+	}
+
+	m_keys[icon.pageKey] = icon.hash;
+	m_keys[icon.hostKey] = icon.hash;
+
+	if (!m_blobs.contains(icon.hash) && !m_pendingBlobs.contains(icon.hash))
+	{
+		m_pendingBlobs[icon.hash] = icon.data;
+	}
+
+	scheduleSave();
+}
+
+void FaviconsDatabase::setIcon(const QUrl &url, const QIcon &icon)
+{
+	const QString pageKey(getPageKey(url));
+	const QString hostKey(getHostKey(url));
+
+	if (icon.isNull() || pageKey.isEmpty() || hostKey.isEmpty())
+	{
+		return;
+	}
+
+	const QImage image(icon.pixmap(32, 32).toImage());
+
+	if (image.isNull())
+	{
+		return;
+	}
+
+	QFutureWatcher<EncodedIcon> *watcher(new QFutureWatcher<EncodedIcon>(this));
+
+	connect(watcher, &QFutureWatcher<EncodedIcon>::finished, this, [=]()
+	{
+		handleIconEncoded(watcher->result());
+
+		watcher->deleteLater();
+	});
+
+	watcher->setFuture(QtConcurrent::run([=]() -> EncodedIcon
+	{
+		EncodedIcon encodedIcon;
+		encodedIcon.pageKey = pageKey;
+		encodedIcon.hostKey = hostKey;
+
+		QBuffer buffer(&encodedIcon.data);
+		buffer.open(QIODevice::WriteOnly);
+
+		image.save(&buffer, "PNG");
+
+		encodedIcon.hash = QCryptographicHash::hash(encodedIcon.data, QCryptographicHash::Sha1);
+
+		return encodedIcon;
+	}));
+}
+
+QString FaviconsDatabase::getPageKey(const QUrl &url)
+{
+	return url.adjusted(QUrl::RemoveFragment | QUrl::RemoveUserInfo).toString();
+}
+
+QString FaviconsDatabase::getHostKey(const QUrl &url)
+{
+	const QString host(url.host().toLower());
+
+	return (host.isEmpty() ? QString() : QLatin1String("host:") + host);
+}
+
+QByteArray FaviconsDatabase::getBlob(const QByteArray &hash) const
+{
+	if (m_pendingBlobs.contains(hash))
+	{
+		return m_pendingBlobs[hash];
+	}
+
+	if (!m_data || !m_blobs.contains(hash))
+	{
+		return {};
+	}
+
+	const BlobLocation location(m_blobs[hash]);
+
+	return QByteArray::fromRawData(reinterpret_cast<const char*>(m_data + location.offset), static_cast<int>(location.size));
+}
+
+QIcon FaviconsDatabase::getIcon(const QUrl &url)
+{
+	QByteArray hash(m_keys.value(getPageKey(url)));
+
+	if (hash.isEmpty())
+	{
+		hash = m_keys.value(getHostKey(url));
+
+		if (hash.isEmpty())
+		{
+			return {};
+		}
+	}
+
+	if (m_icons.contains(hash))
+	{
+		return *m_icons.object(hash);
+	}
+
+	QPixmap pixmap;
+
+	if (!pixmap.loadFromData(getBlob(hash), "PNG"))
+	{
+		return {};
+	}
+
+	const QIcon icon(pixmap);
+
+	m_icons.insert(hash, new QIcon(icon));
+
+	return icon;
+}
+
+}
@@ -0,0 +1,89 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_FAVICONSDATABASE_H
+#define OTTER_FAVICONSDATABASE_H
+
+#include <QtCore/QCache>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+#include <QtCore/QVector>
+#include <QtGui/QIcon>
+
+namespace Otter
+{
+
+class FaviconsDatabase final : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit FaviconsDatabase(const QString &path, QObject *parent = nullptr);
+	~FaviconsDatabase();
+
+	void clear();
+	void save();
+	void removeIcons(const QVector<QUrl> &urls);
+	void setIcon(const QUrl &url, const QIcon &icon);
+	QIcon getIcon(const QUrl &url);
+
+protected:
+	struct BlobLocation final
+	{
+		quint64 offset = 0;
+		quint32 size = 0;
+	};
+
+	struct EncodedIcon final
+	{
+		QString pageKey;
+		QString hostKey;
+		QByteArray hash;
+		QByteArray data;
+	};
+
+	void timerEvent(QTimerEvent *event) override;
+	void load();
+	void map();
+	void scheduleSave();
+	void handleIconEncoded(const EncodedIcon &icon);
+	static QString getPageKey(const QUrl &url);
+	static QString getHostKey(const QUrl &url);
+	QByteArray getBlob(const QByteArray &hash) const;
+
+private:
+	QFile m_file;
+	QHash<QString, QByteArray> m_keys;
+	QHash<QByteArray, BlobLocation> m_blobs;
+	QHash<QByteArray, QByteArray> m_pendingBlobs;
+	QCache<QByteArray, QIcon> m_icons;
+	uchar *m_data;
+	quint64 m_indexOffset;
+	int m_saveTimer;
+	bool m_isModified;
+
+	static const quint32 m_magic = 0x4f544649;
+	static const quint32 m_version = 1;
+	static const int m_headerSize = 16;
+};
+
+}
+
+#endif
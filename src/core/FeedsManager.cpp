@@ -26,6 +26,7 @@
 #include "LongTermTimer.h"
 #include "NotificationsManager.h"
 #include "SessionsManager.h"
+#include "StartupManager.h"
 #include "Utils.h"
 
 #include <QtCore/QFile>
@@ -634,11 +635,24 @@ void FeedsManager::ensureInitialized()
 
 	m_isInitialized = true;
 
-	QFile file(SessionsManager::getWritableDataPath(QLatin1String("feeds.json")));
+	const QString path(SessionsManager::getWritableDataPath(QLatin1String("feeds.json")));
+	QByteArray data;
 
-	if (file.open(QIODevice::ReadOnly))
+	if (!StartupManager::takePreloadedFile(path, &data))
 	{
-		const QJsonArray feedsArray(QJsonDocument::fromJson(file.readAll()).array());
+		QFile file(path);
+
+		if (file.open(QIODevice::ReadOnly))
+		{
+			data = file.readAll();
+
+			file.close();
+		}
+	}
+
+	if (!data.isEmpty())
+	{
+		const QJsonArray feedsArray(QJsonDocument::fromJson(data).array());
 
 		for (int i = 0; i < feedsArray.count(); ++i)
 		{
@@ -22,9 +22,11 @@
 #include "Console.h"
 #include "FeedsManager.h"
 #include "SessionsManager.h"
+#include "StartupManager.h"
 #include "ThemesManager.h"
 #include "Utils.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
 #include <QtCore/QSaveFile>
@@ -297,16 +299,24 @@ FeedsModel::FeedsModel(const QString &path, QObject *parent) : QStandardItemMode
 		return;
 	}
 
+	QByteArray data;
+	QBuffer buffer(&data);
 	QFile file(path);
+	QIODevice *device(&file);
 
-	if (!file.open(QIODevice::ReadOnly))
+	if (StartupManager::takePreloadedFile(path, &data))
 	{
-		Console::addMessage(tr("Failed to open feeds file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+		device = &buffer;
+	}
+
+	if (!device->open(QIODevice::ReadOnly))
+	{
+		Console::addMessage(tr("Failed to open feeds file: %1").arg(device->errorString()), Console::OtherCategory, Console::ErrorLevel, path);
 
 		return;
 	}
 
-	QXmlStreamReader reader(&file);
+	QXmlStreamReader reader(device);
 
 	if (reader.readNextStartElement() && reader.name() == QLatin1String("opml") && reader.attributes().value(QLatin1String("version")).toString() == QLatin1String("1.0"))
 	{
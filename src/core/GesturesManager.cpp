@@ -36,6 +36,7 @@
 
 #define UNKNOWN_GESTURE -1
 #define NATIVE_GESTURE -2
+#define EVENTS_LIMIT 64
 
 namespace Otter
 {
@@ -587,11 +588,17 @@ QPoint GesturesManager::m_lastPosition;
 QVariantMap GesturesManager::m_parameters;
 QHash<GesturesManager::GesturesContext, QVector<MouseProfile::Gesture> > GesturesManager::m_gestures;
 QHash<GesturesManager::GesturesContext, QVector<QVector<MouseProfile::Gesture::Step> > > GesturesManager::m_nativeGestures;
-QVector<QInputEvent*> GesturesManager::m_events;
+QHash<GesturesManager::GesturesContext, QVector<GesturesManager::GestureNode> > GesturesManager::m_gestureTrees;
+QVector<GesturesManager::EventInformation> GesturesManager::m_events;
 QVector<MouseProfile::Gesture::Step> GesturesManager::m_steps;
+QVector<GesturesManager::GestureState> GesturesManager::m_gestureStates;
 QVector<GesturesManager::GesturesContext> GesturesManager::m_contexts;
 int GesturesManager::m_gesturesContextEnumerator(0);
+int GesturesManager::m_eventsOffset(0);
+int GesturesManager::m_eventsAmount(0);
+int GesturesManager::m_moveDistance(0);
 bool GesturesManager::m_isReleasing(false);
+bool GesturesManager::m_isReplayingEvents(false);
 bool GesturesManager::m_afterScroll(false);
 
 GesturesManager::GesturesManager(QObject *parent) : QObject(parent),
@@ -612,6 +619,9 @@ void GesturesManager::createInstance()
 		m_instance = new GesturesManager(QCoreApplication::instance());
 		m_gesturesContextEnumerator = GesturesManager::staticMetaObject.indexOfEnumerator(QLatin1String("GesturesContext").data());
 
+		m_events.resize(EVENTS_LIMIT);
+		m_steps.reserve(EVENTS_LIMIT);
+
 		loadProfiles();
 	}
 }
@@ -678,39 +688,93 @@ void GesturesManager::loadProfiles()
 			}
 		}
 	}
+
+	compileGestures();
 }
 
-void GesturesManager::recognizeMoveStep(const QInputEvent *event)
+void GesturesManager::compileGestures()
 {
-	if (!m_recognizer)
-	{
-		return;
-	}
-
-	QHash<int, MouseGestures::ActionList> possibleMoves;
+	m_gestureTrees.clear();
 
-	for (int i = 0; i < m_contexts.count(); ++i)
+	for (int i = (UnknownContext + 1); i < OtherContext; ++i)
 	{
-		const QVector<MouseProfile::Gesture> gestures(m_gestures[m_contexts.at(i)]);
+		const GesturesContext context(static_cast<GesturesContext>(i));
+		const QVector<QVector<MouseProfile::Gesture::Step> > nativeGestures(m_nativeGestures.value(context));
+		const QVector<MouseProfile::Gesture> gestures(m_gestures.value(context));
+		QVector<GestureNode> nodes({GestureNode()});
 
-		for (int j = 0; j < gestures.count(); ++j)
+		for (int j = 0; j < (nativeGestures.count() + gestures.count()); ++j)
 		{
-			const QVector<MouseProfile::Gesture::Step> steps(gestures.at(j).steps);
+			const bool isNativeGesture(j < nativeGestures.count());
+			const QVector<MouseProfile::Gesture::Step> steps(isNativeGesture ? nativeGestures.at(j) : gestures.at(j - nativeGestures.count()).steps);
+			int index(0);
 
-			if (steps.count() > m_steps.count() && steps[m_steps.count()].type == QEvent::MouseMove && steps.mid(0, m_steps.count()) == m_steps)
+			for (int k = 0; k < steps.count(); ++k)
 			{
-				MouseGestures::ActionList moves;
+				int childIndex(-1);
 
-				for (int k = m_steps.count(); (k < steps.count() && steps.at(k).type == QEvent::MouseMove); ++k)
+				for (int l = 0; l < nodes.at(index).children.count(); ++l)
 				{
-					moves.push_back(steps.at(k).direction);
+					if (nodes.at(nodes.at(index).children.at(l)).step == steps.at(k))
+					{
+						childIndex = nodes.at(index).children.at(l);
+
+						break;
+					}
 				}
 
-				if (!moves.empty())
+				if (childIndex < 0)
 				{
-					possibleMoves.insert(m_recognizer->registerGesture(moves), moves);
+					GestureNode node;
+					node.step = steps.at(k);
+					node.parent = index;
+
+					childIndex = nodes.count();
+
+					nodes[index].children.append(childIndex);
+					nodes.append(node);
 				}
+
+				index = childIndex;
+
+				if (!isNativeGesture)
+				{
+					nodes[index].hasGestures = true;
+				}
+			}
+
+			if (isNativeGesture)
+			{
+				nodes[index].isNativeGesture = true;
 			}
+			else
+			{
+				nodes[index].gestures.append(j - nativeGestures.count());
+			}
+		}
+
+		m_gestureTrees[context] = nodes;
+	}
+
+	updateGestureStates();
+}
+
+void GesturesManager::recognizeMoveStep(const QInputEvent *event)
+{
+	if (!m_recognizer)
+	{
+		return;
+	}
+
+	QHash<int, MouseGestures::ActionList> possibleMoves;
+
+	for (int i = 0; i < m_gestureStates.count(); ++i)
+	{
+		const GestureState state(m_gestureStates.at(i));
+
+		if (state.node >= 0 && state.missingSteps == 0)
+		{
+			collectMoves(m_gestureTrees[m_contexts.at(i)], state.node, {}, &possibleMoves);
 		}
 	}
 
@@ -727,12 +791,249 @@ void GesturesManager::recognizeMoveStep(const QInputEvent *event)
 
 	for (iterator = moves.begin(); iterator != moves.end(); ++iterator)
 	{
-		m_steps.append(MouseProfile::Gesture::Step(QEvent::MouseMove, *iterator, event->modifiers()));
+		addStep(MouseProfile::Gesture::Step(QEvent::MouseMove, *iterator, event->modifiers()));
 	}
 
 	if (m_steps.empty() && calculateLastMoveDistance(true) >= QApplication::startDragDistance())
 	{
-		m_steps.append(MouseProfile::Gesture::Step(QEvent::MouseMove, MouseGestures::UnknownMouseAction, event->modifiers()));
+		addStep(MouseProfile::Gesture::Step(QEvent::MouseMove, MouseGestures::UnknownMouseAction, event->modifiers()));
+	}
+}
+
+void GesturesManager::collectMoves(const QVector<GestureNode> &nodes, int index, const MouseGestures::ActionList &moves, QHash<int, MouseGestures::ActionList> *possibleMoves)
+{
+	const QVector<int> children(nodes.at(index).children);
+
+	for (int i = 0; i < children.count(); ++i)
+	{
+		const GestureNode &node(nodes.at(children.at(i)));
+
+		if (!node.hasGestures || node.step.type != QEvent::MouseMove)
+		{
+			continue;
+		}
+
+		MouseGestures::ActionList nodeMoves(moves);
+		nodeMoves.push_back(node.step.direction);
+
+		bool isLastMove(!node.gestures.isEmpty());
+
+		for (int j = 0; j < node.children.count(); ++j)
+		{
+			if (nodes.at(node.children.at(j)).hasGestures && nodes.at(node.children.at(j)).step.type != QEvent::MouseMove)
+			{
+				isLastMove = true;
+
+				break;
+			}
+		}
+
+		if (isLastMove)
+		{
+			possibleMoves->insert(m_recognizer->registerGesture(nodeMoves), nodeMoves);
+		}
+
+		collectMoves(nodes, children.at(i), nodeMoves, possibleMoves);
+	}
+}
+
+void GesturesManager::findClosestGesture(const QVector<GestureNode> &nodes, int index, int depth, int difference, int *lowestDifference, int *gesture)
+{
+	const GestureNode &node(nodes.at(index));
+
+	if (depth == m_steps.count())
+	{
+		if (node.isNativeGesture && (difference < *lowestDifference || (difference == *lowestDifference && *gesture != NATIVE_GESTURE)))
+		{
+			*lowestDifference = difference;
+			*gesture = NATIVE_GESTURE;
+		}
+
+		if (!node.gestures.isEmpty() && (difference < *lowestDifference || (difference == *lowestDifference && *gesture != NATIVE_GESTURE && node.gestures.first() < *gesture)))
+		{
+			*lowestDifference = difference;
+			*gesture = node.gestures.first();
+		}
+
+		return;
+	}
+
+	for (int i = 0; i < node.children.count(); ++i)
+	{
+		const int stepDifference(calculateStepDifference(nodes.at(node.children.at(i)).step, m_steps.at(depth), (depth == (m_steps.count() - 1))));
+
+		if (stepDifference >= 0)
+		{
+			findClosestGesture(nodes, node.children.at(i), (depth + 1), (difference + stepDifference), lowestDifference, gesture);
+		}
+	}
+}
+
+void GesturesManager::addEvent(const QInputEvent *event)
+{
+	EventInformation information;
+	information.type = event->type();
+	information.modifiers = event->modifiers();
+
+	if (event->type() == QEvent::Wheel)
+	{
+		const QWheelEvent *wheelEvent(static_cast<const QWheelEvent*>(event));
+
+		information.localPosition = wheelEvent->posF();
+		information.screenPosition = wheelEvent->globalPosF();
+		information.pixelDelta = wheelEvent->pixelDelta();
+		information.angleDelta = wheelEvent->angleDelta();
+		information.buttons = wheelEvent->buttons();
+		information.orientation = wheelEvent->orientation();
+		information.delta = wheelEvent->delta();
+	}
+	else
+	{
+		const QMouseEvent *mouseEvent(static_cast<const QMouseEvent*>(event));
+
+		information.localPosition = mouseEvent->localPos();
+		information.windowPosition = mouseEvent->windowPos();
+		information.screenPosition = mouseEvent->screenPos();
+		information.button = mouseEvent->button();
+		information.buttons = mouseEvent->buttons();
+	}
+
+	const bool isContinuingMove(information.type == QEvent::MouseMove && m_eventsAmount > 0 && getEvent(m_eventsAmount - 1).type == QEvent::MouseMove);
+
+	if (isContinuingMove)
+	{
+		m_moveDistance += (getEvent(m_eventsAmount - 1).localPosition.toPoint() - information.localPosition.toPoint()).manhattanLength();
+	}
+	else if (information.type == QEvent::MouseMove)
+	{
+		m_moveDistance = 0;
+	}
+
+	if (m_eventsAmount == EVENTS_LIMIT)
+	{
+		if (isContinuingMove)
+		{
+			m_events[(m_eventsOffset + m_eventsAmount - 1) % EVENTS_LIMIT] = information;
+
+			return;
+		}
+
+		m_eventsOffset = ((m_eventsOffset + 1) % EVENTS_LIMIT);
+
+		--m_eventsAmount;
+	}
+
+	m_events[(m_eventsOffset + m_eventsAmount) % EVENTS_LIMIT] = information;
+
+	++m_eventsAmount;
+}
+
+void GesturesManager::removeLastEvent()
+{
+	if (m_eventsAmount > 0)
+	{
+		--m_eventsAmount;
+	}
+}
+
+void GesturesManager::addStep(const MouseProfile::Gesture::Step &step)
+{
+	m_steps.append(step);
+
+	for (int i = 0; i < m_gestureStates.count(); ++i)
+	{
+		GestureState &state(m_gestureStates[i]);
+
+		if (state.node < 0)
+		{
+			continue;
+		}
+
+		if (state.missingSteps > 0)
+		{
+			++state.missingSteps;
+
+			continue;
+		}
+
+		const QVector<GestureNode> &nodes(m_gestureTrees[m_contexts.at(i)]);
+		const QVector<int> &children(nodes.at(state.node).children);
+		int childIndex(-1);
+
+		for (int j = 0; j < children.count(); ++j)
+		{
+			if (nodes.at(children.at(j)).step == step)
+			{
+				childIndex = children.at(j);
+
+				break;
+			}
+		}
+
+		if (childIndex >= 0)
+		{
+			state.node = childIndex;
+		}
+		else
+		{
+			state.missingSteps = 1;
+		}
+	}
+}
+
+void GesturesManager::removeLastStep()
+{
+	if (m_steps.isEmpty())
+	{
+		return;
+	}
+
+	m_steps.removeLast();
+
+	for (int i = 0; i < m_gestureStates.count(); ++i)
+	{
+		GestureState &state(m_gestureStates[i]);
+
+		if (state.node < 0)
+		{
+			continue;
+		}
+
+		if (state.missingSteps > 0)
+		{
+			--state.missingSteps;
+		}
+		else
+		{
+			state.node = m_gestureTrees[m_contexts.at(i)].at(state.node).parent;
+		}
+	}
+}
+
+void GesturesManager::updateGestureStates()
+{
+	m_gestureStates.fill(GestureState(), m_contexts.count());
+
+	for (int i = 0; i < m_contexts.count(); ++i)
+	{
+		if (!m_gestureTrees.contains(m_contexts.at(i)))
+		{
+			m_gestureStates[i].node = -1;
+		}
+	}
+
+	if (m_steps.isEmpty())
+	{
+		return;
+	}
+
+	const QVector<MouseProfile::Gesture::Step> steps(m_steps);
+
+	m_steps.clear();
+
+	for (int i = 0; i < steps.count(); ++i)
+	{
+		addStep(steps.at(i));
 	}
 }
 
@@ -741,10 +1042,11 @@ void GesturesManager::cancelGesture()
 	releaseObject();
 
 	m_steps.clear();
+	m_eventsOffset = 0;
+	m_eventsAmount = 0;
+	m_moveDistance = 0;
 
-	qDeleteAll(m_events);
-
-	m_events.clear();
+	updateGestureStates();
 }
 
 void GesturesManager::releaseObject()
@@ -805,8 +1107,38 @@ QString GesturesManager::getContextName(int identifier)
 	return {};
 }
 
+const GesturesManager::EventInformation& GesturesManager::getEvent(int index)
+{
+	return m_events.at((m_eventsOffset + index) % EVENTS_LIMIT);
+}
+
 MouseProfile::Gesture GesturesManager::matchGesture()
 {
+	for (int i = 0; i < m_gestureStates.count(); ++i)
+	{
+		const GestureState state(m_gestureStates.at(i));
+
+		if (state.node < 0 || state.missingSteps > 0)
+		{
+			continue;
+		}
+
+		const GestureNode &node(m_gestureTrees[m_contexts.at(i)].at(state.node));
+
+		if (node.isNativeGesture)
+		{
+			MouseProfile::Gesture gesture;
+			gesture.action = NATIVE_GESTURE;
+
+			return gesture;
+		}
+
+		if (!node.gestures.isEmpty())
+		{
+			return m_gestures[m_contexts.at(i)].at(node.gestures.first());
+		}
+	}
+
 	MouseProfile::Gesture bestGesture;
 	bestGesture.action = UNKNOWN_GESTURE;
 
@@ -814,45 +1146,29 @@ MouseProfile::Gesture GesturesManager::matchGesture()
 
 	for (int i = 0; i < m_contexts.count(); ++i)
 	{
-		const QVector<QVector<MouseProfile::Gesture::Step> > nativeGestures(m_nativeGestures[m_contexts.at(i)]);
-
-		for (int j = 0; j < nativeGestures.count(); ++j)
+		if (!m_gestureTrees.contains(m_contexts.at(i)))
 		{
-			const int difference(calculateGesturesDifference(nativeGestures.at(j)));
+			continue;
+		}
 
-			if (difference == 0)
-			{
-				MouseProfile::Gesture gesture;
-				gesture.action = NATIVE_GESTURE;
+		int contextDifference(std::numeric_limits<int>::max());
+		int contextGesture(UNKNOWN_GESTURE);
 
-				return gesture;
-			}
+		findClosestGesture(m_gestureTrees[m_contexts.at(i)], 0, 0, 0, &contextDifference, &contextGesture);
 
-			if (difference < lowestDifference)
+		if (contextGesture != UNKNOWN_GESTURE && contextDifference < lowestDifference)
+		{
+			if (contextGesture == NATIVE_GESTURE)
 			{
 				bestGesture = {};
 				bestGesture.action = NATIVE_GESTURE;
-
-				lowestDifference = difference;
 			}
-		}
-
-		const QVector<MouseProfile::Gesture> gestures(m_gestures[m_contexts.at(i)]);
-
-		for (int j = 0; j < gestures.count(); ++j)
-		{
-			const int difference(calculateGesturesDifference(gestures.at(j).steps));
-
-			if (difference == 0)
+			else
 			{
-				return gestures.at(j);
+				bestGesture = m_gestures[m_contexts.at(i)].at(contextGesture);
 			}
 
-			if (difference < lowestDifference)
-			{
-				bestGesture = gestures.at(j);
-				lowestDifference = difference;
-			}
+			lowestDifference = contextDifference;
 		}
 	}
 
@@ -871,84 +1187,49 @@ int GesturesManager::getContextIdentifier(const QString &name)
 
 int GesturesManager::calculateLastMoveDistance(bool measureFinished)
 {
-	int result(0);
-	int index(m_events.count() - 1);
-
-	if (!measureFinished && (index < 0 || m_events.at(index)->type() != QEvent::MouseMove))
+	if (!measureFinished && (m_eventsAmount == 0 || getEvent(m_eventsAmount - 1).type != QEvent::MouseMove))
 	{
-		return result;
+		return 0;
 	}
 
-	while (index >= 0 && m_events.at(index)->type() != QEvent::MouseMove)
-	{
-		--index;
-	}
-
-	for (; index > 0 && m_events.at(index - 1)->type() == QEvent::MouseMove; --index)
-	{
-		const QMouseEvent *current(static_cast<QMouseEvent*>(m_events.at(index)));
-		const QMouseEvent *previous(static_cast<QMouseEvent*>(m_events.at(index - 1)));
-
-		if (!current || !previous)
-		{
-			break;
-		}
-
-		result += (previous->pos() - current->pos()).manhattanLength();
-	}
-
-	return result;
+	return m_moveDistance;
 }
 
-int GesturesManager::calculateGesturesDifference(const QVector<MouseProfile::Gesture::Step> &steps)
+int GesturesManager::calculateStepDifference(const MouseProfile::Gesture::Step &matchedStep, const MouseProfile::Gesture::Step &recordedStep, bool isLastStep)
 {
-	if (m_steps.count() != steps.count())
-	{
-		return std::numeric_limits<int>::max();
-	}
-
 	int difference(0);
 
-	for (int i = 0; i < steps.count(); ++i)
+	if (isLastStep && matchedStep.type == QEvent::MouseButtonPress && recordedStep.type == QEvent::MouseButtonDblClick && matchedStep.button == recordedStep.button && matchedStep.modifiers == recordedStep.modifiers)
 	{
-		const MouseProfile::Gesture::Step matchedStep(steps.at(i));
-		const MouseProfile::Gesture::Step recordedStep(m_steps.at(i));
-		int stepDifference(0);
+		difference += 100;
+	}
 
-		if (i == (steps.count() - 1) && matchedStep.type == QEvent::MouseButtonPress && recordedStep.type == QEvent::MouseButtonDblClick && matchedStep.button == recordedStep.button && matchedStep.modifiers == recordedStep.modifiers)
+	if (recordedStep.type == matchedStep.type && (matchedStep.type == QEvent::MouseButtonPress || matchedStep.type == QEvent::MouseButtonRelease || matchedStep.type == QEvent::MouseButtonDblClick) && recordedStep.button == matchedStep.button && (recordedStep.modifiers | matchedStep.modifiers) == recordedStep.modifiers)
+	{
+		if (recordedStep.modifiers.testFlag(Qt::ControlModifier) && !matchedStep.modifiers.testFlag(Qt::ControlModifier))
 		{
-			stepDifference += 100;
+			difference += 8;
 		}
 
-		if (recordedStep.type == matchedStep.type && (matchedStep.type == QEvent::MouseButtonPress || matchedStep.type == QEvent::MouseButtonRelease || matchedStep.type == QEvent::MouseButtonDblClick) && recordedStep.button == matchedStep.button && (recordedStep.modifiers | matchedStep.modifiers) == recordedStep.modifiers)
+		if (recordedStep.modifiers.testFlag(Qt::ShiftModifier) && !matchedStep.modifiers.testFlag(Qt::ShiftModifier))
 		{
-			if (recordedStep.modifiers.testFlag(Qt::ControlModifier) && !matchedStep.modifiers.testFlag(Qt::ControlModifier))
-			{
-				stepDifference += 8;
-			}
-
-			if (recordedStep.modifiers.testFlag(Qt::ShiftModifier) && !matchedStep.modifiers.testFlag(Qt::ShiftModifier))
-			{
-				stepDifference += 4;
-			}
-
-			if (recordedStep.modifiers.testFlag(Qt::AltModifier) && !matchedStep.modifiers.testFlag(Qt::AltModifier))
-			{
-				stepDifference += 2;
-			}
+			difference += 4;
+		}
 
-			if (recordedStep.modifiers.testFlag(Qt::MetaModifier) && !matchedStep.modifiers.testFlag(Qt::MetaModifier))
-			{
-				stepDifference += 1;
-			}
+		if (recordedStep.modifiers.testFlag(Qt::AltModifier) && !matchedStep.modifiers.testFlag(Qt::AltModifier))
+		{
+			difference += 2;
 		}
 
-		if (stepDifference == 0 && matchedStep != recordedStep)
+		if (recordedStep.modifiers.testFlag(Qt::MetaModifier) && !matchedStep.modifiers.testFlag(Qt::MetaModifier))
 		{
-			return std::numeric_limits<int>::max();
+			difference += 1;
 		}
+	}
 
-		difference += stepDifference;
+	if (difference == 0 && matchedStep != recordedStep)
+	{
+		return -1;
 	}
 
 	return difference;
@@ -958,7 +1239,24 @@ bool GesturesManager::startGesture(QObject *object, QEvent *event, QVector<Gestu
 {
 	QInputEvent *inputEvent(static_cast<QInputEvent*>(event));
 
-	if (!object || !inputEvent || m_gestures.keys().toSet().intersect(contexts.toList().toSet()).isEmpty() || m_events.contains(inputEvent))
+	if (!object || !inputEvent || m_isReplayingEvents)
+	{
+		return false;
+	}
+
+	bool hasGestures(false);
+
+	for (int i = 0; i < contexts.count(); ++i)
+	{
+		if (m_gestures.contains(contexts.at(i)))
+		{
+			hasGestures = true;
+
+			break;
+		}
+	}
+
+	if (!hasGestures)
 	{
 		return false;
 	}
@@ -970,6 +1268,8 @@ bool GesturesManager::startGesture(QObject *object, QEvent *event, QVector<Gestu
 		m_contexts = contexts;
 		m_isReleasing = false;
 		m_afterScroll = false;
+
+		updateGestureStates();
 	}
 
 	createInstance();
@@ -1022,11 +1322,28 @@ bool GesturesManager::triggerAction(const MouseProfile::Gesture &gesture)
 
 	if (gesture.action == NATIVE_GESTURE)
 	{
-		for (int i = 0; i < m_events.count(); ++i)
+		m_isReplayingEvents = true;
+
+		for (int i = 0; (i < m_eventsAmount && m_trackedObject); ++i)
 		{
-			QCoreApplication::sendEvent(m_trackedObject, m_events.at(i));
+			const EventInformation information(getEvent(i));
+
+			if (information.type == QEvent::Wheel)
+			{
+				QWheelEvent event(information.localPosition, information.screenPosition, information.pixelDelta, information.angleDelta, information.delta, information.orientation, information.buttons, information.modifiers);
+
+				QCoreApplication::sendEvent(m_trackedObject, &event);
+			}
+			else
+			{
+				QMouseEvent event(information.type, information.localPosition, information.windowPosition, information.screenPosition, information.button, information.buttons, information.modifiers);
+
+				QCoreApplication::sendEvent(m_trackedObject, &event);
+			}
 		}
 
+		m_isReplayingEvents = false;
+
 		cancelGesture();
 	}
 	else if (gesture.action == ActionsManager::ContextMenuAction)
@@ -1076,17 +1393,17 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 				break;
 			}
 
-			if (!m_events.isEmpty() && m_events.last()->type() == event->type())
+			if (m_eventsAmount > 0 && getEvent(m_eventsAmount - 1).type == event->type())
 			{
-				const QMouseEvent *previousMouseEvent(static_cast<QMouseEvent*>(m_events.last()));
+				const EventInformation &previousEvent(getEvent(m_eventsAmount - 1));
 
-				if (previousMouseEvent && previousMouseEvent->button() == mouseEvent->button() && previousMouseEvent->modifiers() == mouseEvent->modifiers())
+				if (previousEvent.button == mouseEvent->button() && previousEvent.modifiers == mouseEvent->modifiers())
 				{
 					break;
 				}
 			}
 
-			m_events.append(new QMouseEvent(event->type(), mouseEvent->localPos(), mouseEvent->windowPos(), mouseEvent->screenPos(), mouseEvent->button(), mouseEvent->buttons(), mouseEvent->modifiers()));
+			addEvent(mouseEvent);
 
 			if (m_afterScroll && event->type() == QEvent::MouseButtonRelease)
 			{
@@ -1098,7 +1415,7 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 
 			recognizeMoveStep(mouseEvent);
 
-			m_steps.append(MouseProfile::Gesture::Step(mouseEvent));
+			addStep(MouseProfile::Gesture::Step(mouseEvent));
 
 			if (m_isReleasing && event->type() == QEvent::MouseButtonRelease)
 			{
@@ -1109,6 +1426,8 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 						m_steps.removeAt(i);
 					}
 				}
+
+				updateGestureStates();
 			}
 			else
 			{
@@ -1140,7 +1459,7 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 				break;
 			}
 
-			m_events.append(new QMouseEvent(event->type(), mouseEvent->localPos(), mouseEvent->windowPos(), mouseEvent->screenPos(), mouseEvent->button(), mouseEvent->buttons(), mouseEvent->modifiers()));
+			addEvent(mouseEvent);
 
 			m_afterScroll = false;
 
@@ -1156,7 +1475,7 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 
 			if (calculateLastMoveDistance() >= QApplication::startDragDistance())
 			{
-				m_steps.append(MouseProfile::Gesture::Step(QEvent::MouseMove, MouseGestures::UnknownMouseAction, mouseEvent->modifiers()));
+				addStep(MouseProfile::Gesture::Step(QEvent::MouseMove, MouseGestures::UnknownMouseAction, mouseEvent->modifiers()));
 
 				gesture = matchGesture();
 
@@ -1168,7 +1487,7 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 				}
 				else
 				{
-					m_steps.pop_back();
+					removeLastStep();
 				}
 			}
 
@@ -1182,11 +1501,11 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 					break;
 				}
 
-				m_events.append(new QWheelEvent(wheelEvent->pos(), wheelEvent->globalPos(), wheelEvent->pixelDelta(), wheelEvent->angleDelta(), wheelEvent->delta(), wheelEvent->orientation(), wheelEvent->buttons(), wheelEvent->modifiers()));
+				addEvent(wheelEvent);
 
 				recognizeMoveStep(wheelEvent);
 
-				m_steps.append(MouseProfile::Gesture::Step(wheelEvent));
+				addStep(MouseProfile::Gesture::Step(wheelEvent));
 
 				m_lastClick = wheelEvent->pos();
 
@@ -1203,12 +1522,12 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 
 				while (!m_steps.isEmpty() && m_steps.at(m_steps.count() - 1).type == QEvent::Wheel)
 				{
-					m_steps.removeAt(m_steps.count() - 1);
+					removeLastStep();
 				}
 
-				while (!m_events.isEmpty() && m_events.at(m_events.count() - 1)->type() == QEvent::Wheel)
+				while (m_eventsAmount > 0 && getEvent(m_eventsAmount - 1).type == QEvent::Wheel)
 				{
-					m_events.removeAt(m_events.count() - 1);
+					removeLastEvent();
 				}
 
 				m_afterScroll = true;
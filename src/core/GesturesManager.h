@@ -125,14 +125,54 @@ public:
 	static bool isTracking();
 
 protected:
+	struct EventInformation final
+	{
+		QPointF localPosition;
+		QPointF windowPosition;
+		QPointF screenPosition;
+		QPoint pixelDelta;
+		QPoint angleDelta;
+		QEvent::Type type = QEvent::None;
+		Qt::MouseButton button = Qt::NoButton;
+		Qt::MouseButtons buttons = Qt::NoButton;
+		Qt::KeyboardModifiers modifiers = Qt::NoModifier;
+		Qt::Orientation orientation = Qt::Vertical;
+		int delta = 0;
+	};
+
+	struct GestureNode final
+	{
+		MouseProfile::Gesture::Step step;
+		QVector<int> children;
+		QVector<int> gestures;
+		int parent = -1;
+		bool hasGestures = false;
+		bool isNativeGesture = false;
+	};
+
+	struct GestureState final
+	{
+		int node = 0;
+		int missingSteps = 0;
+	};
+
 	explicit GesturesManager(QObject *parent);
 
 	void timerEvent(QTimerEvent *event) override;
+	static void compileGestures();
 	static void recognizeMoveStep(const QInputEvent *event);
+	static void collectMoves(const QVector<GestureNode> &nodes, int index, const MouseGestures::ActionList &moves, QHash<int, MouseGestures::ActionList> *possibleMoves);
+	static void findClosestGesture(const QVector<GestureNode> &nodes, int index, int depth, int difference, int *lowestDifference, int *gesture);
+	static void addEvent(const QInputEvent *event);
+	static void removeLastEvent();
+	static void addStep(const MouseProfile::Gesture::Step &step);
+	static void removeLastStep();
+	static void updateGestureStates();
 	static void releaseObject();
+	static const EventInformation& getEvent(int index);
 	static MouseProfile::Gesture matchGesture();
 	static int calculateLastMoveDistance(bool measureFinished = false);
-	static int calculateGesturesDifference(const QVector<MouseProfile::Gesture::Step> &steps);
+	static int calculateStepDifference(const MouseProfile::Gesture::Step &matchedStep, const MouseProfile::Gesture::Step &recordedStep, bool isLastStep);
 	static bool triggerAction(const MouseProfile::Gesture &gesture);
 	bool eventFilter(QObject *object, QEvent *event) override;
 
@@ -151,11 +191,17 @@ private:
 	static QVariantMap m_parameters;
 	static QHash<GesturesContext, QVector<MouseProfile::Gesture> > m_gestures;
 	static QHash<GesturesContext, QVector<QVector<MouseProfile::Gesture::Step> > > m_nativeGestures;
+	static QHash<GesturesContext, QVector<GestureNode> > m_gestureTrees;
 	static QVector<MouseProfile::Gesture::Step> m_steps;
-	static QVector<QInputEvent*> m_events;
+	static QVector<EventInformation> m_events;
+	static QVector<GestureState> m_gestureStates;
 	static QVector<GesturesContext> m_contexts;
 	static int m_gesturesContextEnumerator;
+	static int m_eventsOffset;
+	static int m_eventsAmount;
+	static int m_moveDistance;
 	static bool m_isReleasing;
+	static bool m_isReplayingEvents;
 	static bool m_afterScroll;
 };
 
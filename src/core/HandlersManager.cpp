@@ -93,6 +93,8 @@ void HandlersManager::setHandler(const QMimeType &mimeType, const HandlerDefinit
 
 HandlersManager* HandlersManager::getInstance()
 {
+	createInstance();
+
 	return m_instance;
 }
 
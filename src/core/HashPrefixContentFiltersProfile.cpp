@@ -0,0 +1,944 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "HashPrefixContentFiltersProfile.h"
+#include "Console.h"
+#include "Job.h"
+#include "SessionsManager.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QHostAddress>
+
+#include <cstring>
+
+#define DATABASE_MAGIC 0x4f544850
+#define DATABASE_VERSION 1
+#define DATABASE_HEADER_SIZE 28
+#define PREFIX_SIZE 4
+#define HASH_SIZE 32
+#define RESOLVED_PREFIXES_CACHE_LIMIT 1000
+
+namespace Otter
+{
+
+HashPrefixContentFiltersProfile::HashPrefixContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, int updateInterval, const ProfileFlags &flags, QObject *parent) : ContentFiltersProfile(parent),
+	m_dataFetchJob(nullptr),
+	m_resolveJob(nullptr),
+	m_name(name),
+	m_title(title),
+	m_updateUrl(updateUrl),
+	m_fullHashes(RESOLVED_PREFIXES_CACHE_LIMIT),
+	m_category(OtherCategory),
+	m_error(NoError),
+	m_flags(flags),
+	m_updateInterval(updateInterval),
+	m_isMerging(false),
+	m_wasLoaded(false)
+{
+	loadDatabase();
+
+	if (m_database.updateTime > 0)
+	{
+		m_lastUpdate = QDateTime::fromMSecsSinceEpoch(m_database.updateTime, Qt::UTC);
+	}
+
+	if (m_updateUrl.isValid() && (!m_lastUpdate.isValid() || (m_updateInterval > 0 && m_lastUpdate.daysTo(QDateTime::currentDateTimeUtc()) > m_updateInterval)))
+	{
+		update();
+	}
+}
+
+HashPrefixContentFiltersProfile::~HashPrefixContentFiltersProfile()
+{
+	closeDatabase(&m_database);
+}
+
+void HashPrefixContentFiltersProfile::clear()
+{
+	QMutexLocker locker(&m_databaseMutex);
+
+	if (!m_wasLoaded)
+	{
+		return;
+	}
+
+	closeDatabase(&m_database);
+
+	m_fullHashes.clear();
+
+	m_wasLoaded = false;
+}
+
+void HashPrefixContentFiltersProfile::loadDatabase()
+{
+	m_wasLoaded = true;
+
+	openDatabase(&m_database);
+}
+
+void HashPrefixContentFiltersProfile::closeDatabase(Database *database)
+{
+	if (database->data)
+	{
+		database->file.unmap(database->data);
+	}
+
+	if (database->file.isOpen())
+	{
+		database->file.close();
+	}
+
+	database->data = nullptr;
+	database->records = nullptr;
+	database->version = 0;
+	database->updateTime = 0;
+	database->amount = 0;
+}
+
+void HashPrefixContentFiltersProfile::raiseError(const QString &message, ContentFiltersProfile::ProfileError error)
+{
+	m_error = error;
+
+	Console::addMessage(message, Console::OtherCategory, Console::ErrorLevel, getPath());
+
+	emit profileModified();
+}
+
+void HashPrefixContentFiltersProfile::resolvePrefixes()
+{
+	if (m_resolveJob || !m_updateUrl.isValid())
+	{
+		return;
+	}
+
+	m_databaseMutex.lock();
+
+	m_resolvingPrefixes = m_pendingPrefixes.values().toVector();
+
+	m_databaseMutex.unlock();
+
+	if (m_resolvingPrefixes.isEmpty())
+	{
+		return;
+	}
+
+	// Only prefixes are stored locally, full hashes for matching ones are requested on demand
+	QStringList prefixes;
+	prefixes.reserve(m_resolvingPrefixes.count());
+
+	for (int i = 0; i < m_resolvingPrefixes.count(); ++i)
+	{
+		prefixes.append(QString::fromLatin1(m_resolvingPrefixes.at(i).toHex()));
+	}
+
+	QUrl url(m_updateUrl);
+	QUrlQuery query(url);
+	query.addQueryItem(QLatin1String("prefixes"), prefixes.join(QLatin1Char(',')));
+
+	url.setQuery(query);
+
+	m_resolveJob = new DataFetchJob(url, this);
+	m_resolveJob->setPriority(FetchJob::UserPriority);
+
+	connect(m_resolveJob, &Job::jobFinished, this, &HashPrefixContentFiltersProfile::handleResolveJobFinished);
+
+	m_resolveJob->start();
+}
+
+void HashPrefixContentFiltersProfile::handleJobFinished(bool isSuccess)
+{
+	if (!m_dataFetchJob)
+	{
+		return;
+	}
+
+	QIODevice *device(m_dataFetchJob->getData());
+
+	m_dataFetchJob->deleteLater();
+	m_dataFetchJob = nullptr;
+
+	if (!isSuccess)
+	{
+		raiseError(QCoreApplication::translate("main", "Failed to update fraud checking profile: %1").arg(device->errorString()), DownloadError);
+
+		return;
+	}
+
+	const QByteArray data(device->readAll());
+
+	m_databaseMutex.lock();
+
+	if (!m_wasLoaded)
+	{
+		loadDatabase();
+	}
+
+	const quint64 currentVersion(m_database.version);
+	const QByteArray currentPrefixes(m_database.records ? QByteArray(reinterpret_cast<const char*>(m_database.records), static_cast<int>(m_database.amount * PREFIX_SIZE)) : QByteArray());
+
+	m_databaseMutex.unlock();
+
+	QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("fraudChecking")));
+
+	m_isMerging = true;
+
+	QFutureWatcher<UpdateResult> *watcher(new QFutureWatcher<UpdateResult>(this));
+
+	connect(watcher, &QFutureWatcher<UpdateResult>::finished, this, [=]()
+	{
+		handleUpdateMerged(watcher->result());
+
+		watcher->deleteLater();
+	});
+
+	watcher->setFuture(QtConcurrent::run(&HashPrefixContentFiltersProfile::mergeUpdate, data, currentPrefixes, currentVersion, (getPath() + QLatin1String(".new"))));
+}
+
+void HashPrefixContentFiltersProfile::handleResolveJobFinished(bool isSuccess)
+{
+	if (!m_resolveJob)
+	{
+		return;
+	}
+
+	QIODevice *device(m_resolveJob->getData());
+
+	m_resolveJob->deleteLater();
+	m_resolveJob = nullptr;
+
+	QHash<QByteArray, QVector<QByteArray> > fullHashes;
+
+	if (isSuccess)
+	{
+		while (!device->atEnd())
+		{
+			const QByteArray line(device->readLine().trimmed());
+
+			if (line.length() != (HASH_SIZE * 2))
+			{
+				continue;
+			}
+
+			const QByteArray hash(QByteArray::fromHex(line));
+
+			if (hash.size() == HASH_SIZE)
+			{
+				fullHashes[hash.left(PREFIX_SIZE)].append(hash);
+			}
+		}
+	}
+	else
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to resolve fraud checking hash prefixes: %1").arg(device->errorString()), Console::OtherCategory, Console::WarningLevel, getPath());
+	}
+
+	bool hasMatches(false);
+
+	m_databaseMutex.lock();
+
+	for (int i = 0; i < m_resolvingPrefixes.count(); ++i)
+	{
+		const QByteArray prefix(m_resolvingPrefixes.at(i));
+
+		m_pendingPrefixes.remove(prefix);
+
+		if (isSuccess)
+		{
+			const QVector<QByteArray> hashes(fullHashes.value(prefix));
+
+			if (!hashes.isEmpty())
+			{
+				hasMatches = true;
+			}
+
+			m_fullHashes.insert(prefix, new QVector<QByteArray>(hashes));
+		}
+	}
+
+	const bool hasPendingPrefixes(!m_pendingPrefixes.isEmpty());
+
+	m_databaseMutex.unlock();
+
+	m_resolvingPrefixes.clear();
+
+	if (hasMatches)
+	{
+		emit profileModified();
+	}
+
+	if (isSuccess && hasPendingPrefixes)
+	{
+		resolvePrefixes();
+	}
+}
+
+void HashPrefixContentFiltersProfile::handleUpdateMerged(const UpdateResult &result)
+{
+	m_isMerging = false;
+
+	if (result.error != NoError)
+	{
+		raiseError(QCoreApplication::translate("main", "Failed to update fraud checking profile: %1").arg(result.errorString), result.error);
+
+		return;
+	}
+
+	QMutexLocker locker(&m_databaseMutex);
+
+	closeDatabase(&m_database);
+
+	bool isWritten(false);
+
+	if (result.isUpToDate)
+	{
+		isWritten = (QFile::exists(getPath()) ? writeUpdateTime(getPath(), result.updateTime) : writeDatabase(getPath(), {}, result.version, result.updateTime));
+	}
+	else
+	{
+		isWritten = replaceDatabase();
+
+		m_fullHashes.clear();
+	}
+
+	loadDatabase();
+
+	locker.unlock();
+
+	if (!isWritten)
+	{
+		raiseError(QCoreApplication::translate("main", "Failed to update fraud checking profile: unable to write database"), ReadError);
+
+		return;
+	}
+
+	m_lastUpdate = QDateTime::fromMSecsSinceEpoch(result.updateTime, Qt::UTC);
+	m_error = NoError;
+
+	emit profileModified();
+}
+
+void HashPrefixContentFiltersProfile::setUpdateInterval(int interval)
+{
+	if (interval != m_updateInterval)
+	{
+		m_updateInterval = interval;
+
+		emit profileModified();
+	}
+}
+
+void HashPrefixContentFiltersProfile::setUpdateUrl(const QUrl &url)
+{
+	if (url.isValid() && url != m_updateUrl)
+	{
+		m_updateUrl = url;
+		m_flags |= HasCustomUpdateUrlFlag;
+
+		emit profileModified();
+	}
+}
+
+void HashPrefixContentFiltersProfile::setCategory(ProfileCategory category)
+{
+	if (category != m_category)
+	{
+		m_category = category;
+
+		emit profileModified();
+	}
+}
+
+void HashPrefixContentFiltersProfile::setTitle(const QString &title)
+{
+	if (title != m_title)
+	{
+		m_title = title;
+		m_flags |= HasCustomTitleFlag;
+
+		emit profileModified();
+	}
+}
+
+QString HashPrefixContentFiltersProfile::getName() const
+{
+	return m_name;
+}
+
+QString HashPrefixContentFiltersProfile::getTitle() const
+{
+	return (m_title.isEmpty() ? tr("(Unknown)") : m_title);
+}
+
+QString HashPrefixContentFiltersProfile::getPath() const
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("fraudChecking/%1.prefixes")).arg(m_name);
+}
+
+QDateTime HashPrefixContentFiltersProfile::getLastUpdate() const
+{
+	return m_lastUpdate;
+}
+
+QUrl HashPrefixContentFiltersProfile::getUpdateUrl() const
+{
+	return m_updateUrl;
+}
+
+ContentFiltersManager::CheckResult HashPrefixContentFiltersProfile::checkUrl(const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType)
+{
+	Q_UNUSED(baseUrl)
+	Q_UNUSED(requestUrl)
+	Q_UNUSED(resourceType)
+
+	return {};
+}
+
+QVector<QByteArray> HashPrefixContentFiltersProfile::createUrlExpressions(const QUrl &url)
+{
+	QString host(url.host(QUrl::FullyEncoded).toLower());
+
+	while (host.contains(QLatin1String("..")))
+	{
+		host.replace(QLatin1String(".."), QLatin1String("."));
+	}
+
+	while (host.startsWith(QLatin1Char('.')))
+	{
+		host.remove(0, 1);
+	}
+
+	while (host.endsWith(QLatin1Char('.')))
+	{
+		host.chop(1);
+	}
+
+	if (host.isEmpty())
+	{
+		return {};
+	}
+
+	QStringList hosts({host});
+
+	if (QHostAddress(host).isNull())
+	{
+		const QStringList components(host.split(QLatin1Char('.')));
+
+		for (int i = qMax(1, (components.count() - 5)); i < (components.count() - 1); ++i)
+		{
+			hosts.append(components.mid(i).join(QLatin1Char('.')));
+		}
+	}
+
+	QString path(url.adjusted(QUrl::NormalizePathSegments).path(QUrl::FullyEncoded));
+
+	while (path.contains(QLatin1String("//")))
+	{
+		path.replace(QLatin1String("//"), QLatin1String("/"));
+	}
+
+	if (!path.startsWith(QLatin1Char('/')))
+	{
+		path.prepend(QLatin1Char('/'));
+	}
+
+	QStringList paths;
+
+	if (url.hasQuery())
+	{
+		paths.append(path + QLatin1Char('?') + url.query(QUrl::FullyEncoded));
+	}
+
+	paths.append(path);
+
+	int position(0);
+	int prefixesAmount(0);
+
+	while (prefixesAmount < 4 && (position = path.indexOf(QLatin1Char('/'), position)) >= 0)
+	{
+		const QString prefix(path.left(position + 1));
+
+		if (!paths.contains(prefix))
+		{
+			paths.append(prefix);
+		}
+
+		++position;
+		++prefixesAmount;
+	}
+
+	QVector<QByteArray> expressions;
+	expressions.reserve(hosts.count() * paths.count());
+
+	for (int i = 0; i < hosts.count(); ++i)
+	{
+		for (int j = 0; j < paths.count(); ++j)
+		{
+			expressions.append((hosts.at(i) + paths.at(j)).toUtf8());
+		}
+	}
+
+	return expressions;
+}
+
+HashPrefixContentFiltersProfile::UpdateResult HashPrefixContentFiltersProfile::mergeUpdate(const QByteArray &data, const QByteArray &currentPrefixes, quint64 currentVersion, const QString &path)
+{
+	QBuffer buffer;
+	buffer.setData(data);
+	buffer.open(QIODevice::ReadOnly);
+
+	QSet<QByteArray> addedPrefixes;
+	QSet<QByteArray> removedPrefixes;
+	UpdateResult result;
+	quint64 baseVersion(0);
+	bool hasBaseVersion(false);
+	bool hasVersion(false);
+	bool isReset(false);
+
+	while (!buffer.atEnd())
+	{
+		const QByteArray line(buffer.readLine().trimmed());
+
+		if (line.isEmpty() || line.startsWith('#'))
+		{
+			continue;
+		}
+
+		if (line.startsWith("version "))
+		{
+			result.version = line.mid(8).trimmed().toULongLong(&hasVersion);
+		}
+		else if (line.startsWith("base "))
+		{
+			baseVersion = line.mid(5).trimmed().toULongLong(&hasBaseVersion);
+		}
+		else if (line == "reset")
+		{
+			isReset = true;
+		}
+		else if (line.length() == ((PREFIX_SIZE * 2) + 1) && (line.at(0) == '+' || line.at(0) == '-'))
+		{
+			const QByteArray prefix(QByteArray::fromHex(line.mid(1)));
+
+			if (prefix.size() != PREFIX_SIZE)
+			{
+				continue;
+			}
+
+			if (line.at(0) == '+')
+			{
+				addedPrefixes.insert(prefix);
+				removedPrefixes.remove(prefix);
+			}
+			else
+			{
+				removedPrefixes.insert(prefix);
+				addedPrefixes.remove(prefix);
+			}
+		}
+	}
+
+	result.updateTime = QDateTime::currentMSecsSinceEpoch();
+
+	if (!hasVersion)
+	{
+		result.error = DownloadError;
+		result.errorString = QCoreApplication::translate("main", "invalid update file");
+
+		return result;
+	}
+
+	if (result.version < currentVersion)
+	{
+		result.error = DownloadError;
+		result.errorString = QCoreApplication::translate("main", "update version %1 is older than local version %2").arg(result.version).arg(currentVersion);
+
+		return result;
+	}
+
+	if (!isReset && (!hasBaseVersion || baseVersion != currentVersion))
+	{
+		result.error = DownloadError;
+		result.errorString = QCoreApplication::translate("main", "partial update does not apply to local version %1").arg(currentVersion);
+
+		return result;
+	}
+
+	if (!isReset && result.version == currentVersion)
+	{
+		result.isUpToDate = true;
+
+		return result;
+	}
+
+	const int currentAmount(isReset ? 0 : (currentPrefixes.size() / PREFIX_SIZE));
+	QVector<QByteArray> prefixes;
+	prefixes.reserve(currentAmount + addedPrefixes.count());
+
+	for (int i = 0; i < currentAmount; ++i)
+	{
+		const QByteArray prefix(currentPrefixes.mid((i * PREFIX_SIZE), PREFIX_SIZE));
+
+		if (!removedPrefixes.contains(prefix))
+		{
+			prefixes.append(prefix);
+		}
+	}
+
+	QSet<QByteArray>::const_iterator iterator;
+
+	for (iterator = addedPrefixes.constBegin(); iterator != addedPrefixes.constEnd(); ++iterator)
+	{
+		prefixes.append(*iterator);
+	}
+
+	std::sort(prefixes.begin(), prefixes.end());
+
+	prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+
+	if (!writeDatabase(path, prefixes, result.version, result.updateTime))
+	{
+		result.error = ReadError;
+		result.errorString = QCoreApplication::translate("main", "unable to write database");
+	}
+
+	return result;
+}
+
+ContentFiltersProfile::ProfileCategory HashPrefixContentFiltersProfile::getCategory() const
+{
+	return m_category;
+}
+
+ContentFiltersProfile::ProfileError HashPrefixContentFiltersProfile::getError() const
+{
+	return m_error;
+}
+
+ContentFiltersProfile::ProfileFlags HashPrefixContentFiltersProfile::getFlags() const
+{
+	return m_flags;
+}
+
+int HashPrefixContentFiltersProfile::getUpdateInterval() const
+{
+	return m_updateInterval;
+}
+
+int HashPrefixContentFiltersProfile::getUpdateProgress() const
+{
+	return (m_dataFetchJob ? m_dataFetchJob->getProgress() : -1);
+}
+
+bool HashPrefixContentFiltersProfile::openDatabase(Database *database)
+{
+	closeDatabase(database);
+
+	database->file.setFileName(getPath());
+
+	if (!database->file.exists())
+	{
+		return false;
+	}
+
+	if (!database->file.open(QIODevice::ReadOnly))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to open fraud checking profile database: %1").arg(database->file.errorString()), Console::OtherCategory, Console::ErrorLevel, database->file.fileName());
+
+		return false;
+	}
+
+	const qint64 size(database->file.size());
+
+	if (size >= DATABASE_HEADER_SIZE)
+	{
+		database->data = database->file.map(0, size);
+	}
+
+	const uchar *header(database->data);
+
+	if (!header || qFromBigEndian<quint32>(header) != DATABASE_MAGIC || qFromBigEndian<quint32>(header + 4) != DATABASE_VERSION || size < (DATABASE_HEADER_SIZE + (static_cast<qint64>(qFromBigEndian<quint32>(header + 24)) * PREFIX_SIZE)))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to load fraud checking profile database: invalid file"), Console::OtherCategory, Console::ErrorLevel, database->file.fileName());
+
+		closeDatabase(database);
+
+		return false;
+	}
+
+	database->version = qFromBigEndian<quint64>(header + 8);
+	database->updateTime = qFromBigEndian<qint64>(header + 16);
+	database->amount = qFromBigEndian<quint32>(header + 24);
+	database->records = (header + DATABASE_HEADER_SIZE);
+
+	return true;
+}
+
+bool HashPrefixContentFiltersProfile::replaceDatabase()
+{
+	const QString path(getPath());
+
+	return ((!QFile::exists(path) || QFile::remove(path)) && QFile::rename(path + QLatin1String(".new"), path));
+}
+
+bool HashPrefixContentFiltersProfile::writeDatabase(const QString &path, const QVector<QByteArray> &records, quint64 version, qint64 updateTime)
+{
+	QSaveFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to save fraud checking profile database: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setByteOrder(QDataStream::BigEndian);
+	stream << static_cast<quint32>(DATABASE_MAGIC) << static_cast<quint32>(DATABASE_VERSION) << version << updateTime << static_cast<quint32>(records.count());
+
+	for (int i = 0; i < records.count(); ++i)
+	{
+		file.write(records.at(i));
+	}
+
+	if (!file.commit())
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to save fraud checking profile database: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return false;
+	}
+
+	return true;
+}
+
+bool HashPrefixContentFiltersProfile::writeUpdateTime(const QString &path, qint64 updateTime)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadWrite) || file.size() < DATABASE_HEADER_SIZE || !file.seek(16))
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Failed to save fraud checking profile database: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setByteOrder(QDataStream::BigEndian);
+	stream << updateTime;
+
+	return (stream.status() == QDataStream::Ok);
+}
+
+bool HashPrefixContentFiltersProfile::containsPrefix(const Database &database, const char *prefix)
+{
+	quint32 low(0);
+	quint32 high(database.amount);
+
+	while (low < high)
+	{
+		const quint32 middle(low + ((high - low) / 2));
+		const int comparison(std::memcmp((database.records + (static_cast<size_t>(middle) * PREFIX_SIZE)), prefix, PREFIX_SIZE));
+
+		if (comparison == 0)
+		{
+			return true;
+		}
+
+		if (comparison < 0)
+		{
+			low = (middle + 1);
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return false;
+}
+
+bool HashPrefixContentFiltersProfile::update()
+{
+	if (m_dataFetchJob || m_isMerging || thread() != QThread::currentThread())
+	{
+		return false;
+	}
+
+	if (!m_updateUrl.isValid())
+	{
+		if (m_updateUrl.isEmpty())
+		{
+			raiseError(QCoreApplication::translate("main", "Failed to update fraud checking profile, update URL is empty"), DownloadError);
+		}
+		else
+		{
+			raiseError(QCoreApplication::translate("main", "Failed to update fraud checking profile, update URL (%1) is invalid").arg(m_updateUrl.toString()), DownloadError);
+		}
+
+		return false;
+	}
+
+	QUrl url(m_updateUrl);
+	QUrlQuery query(url);
+
+	m_databaseMutex.lock();
+
+	query.addQueryItem(QLatin1String("version"), QString::number(m_database.version));
+
+	m_databaseMutex.unlock();
+
+	url.setQuery(query);
+
+	m_dataFetchJob = new DataFetchJob(url, this);
+
+	connect(m_dataFetchJob, &Job::jobFinished, this, &HashPrefixContentFiltersProfile::handleJobFinished);
+	connect(m_dataFetchJob, &Job::progressChanged, this, &HashPrefixContentFiltersProfile::updateProgressChanged);
+
+	m_dataFetchJob->start();
+
+	emit profileModified();
+
+	return true;
+}
+
+bool HashPrefixContentFiltersProfile::remove()
+{
+	if (m_dataFetchJob)
+	{
+		m_dataFetchJob->cancel();
+		m_dataFetchJob->deleteLater();
+		m_dataFetchJob = nullptr;
+	}
+
+	if (m_resolveJob)
+	{
+		m_resolveJob->cancel();
+		m_resolveJob->deleteLater();
+		m_resolveJob = nullptr;
+	}
+
+	const QList<QFutureWatcherBase*> watchers(findChildren<QFutureWatcherBase*>());
+
+	for (int i = 0; i < watchers.count(); ++i)
+	{
+		watchers.at(i)->disconnect(this);
+		watchers.at(i)->waitForFinished();
+		watchers.at(i)->deleteLater();
+	}
+
+	m_isMerging = false;
+
+	QMutexLocker locker(&m_databaseMutex);
+
+	closeDatabase(&m_database);
+
+	m_fullHashes.clear();
+	m_pendingPrefixes.clear();
+
+	const QString path(getPath());
+
+	QFile::remove(path + QLatin1String(".new"));
+
+	return (!QFile::exists(path) || QFile::remove(path));
+}
+
+bool HashPrefixContentFiltersProfile::isUpdating() const
+{
+	return (m_dataFetchJob != nullptr || m_isMerging);
+}
+
+bool HashPrefixContentFiltersProfile::isFraud(const QUrl &url)
+{
+	const QVector<QByteArray> expressions(createUrlExpressions(url));
+
+	if (expressions.isEmpty())
+	{
+		return false;
+	}
+
+	QVector<QByteArray> hashes;
+	hashes.reserve(expressions.count());
+
+	for (int i = 0; i < expressions.count(); ++i)
+	{
+		hashes.append(QCryptographicHash::hash(expressions.at(i), QCryptographicHash::Sha256));
+	}
+
+	QMutexLocker locker(&m_databaseMutex);
+
+	if (!m_wasLoaded)
+	{
+		loadDatabase();
+	}
+
+	if (m_database.amount == 0)
+	{
+		return false;
+	}
+
+	bool isMatching(false);
+	bool needsResolving(false);
+
+	for (int i = 0; i < hashes.count(); ++i)
+	{
+		if (!containsPrefix(m_database, hashes.at(i).constData()))
+		{
+			continue;
+		}
+
+		const QByteArray prefix(hashes.at(i).left(PREFIX_SIZE));
+		const QVector<QByteArray> *fullHashes(m_fullHashes.object(prefix));
+
+		if (fullHashes)
+		{
+			if (fullHashes->contains(hashes.at(i)))
+			{
+				isMatching = true;
+
+				break;
+			}
+		}
+		else if (!m_pendingPrefixes.contains(prefix))
+		{
+			m_pendingPrefixes.insert(prefix);
+
+			needsResolving = true;
+		}
+	}
+
+	locker.unlock();
+
+	if (needsResolving)
+	{
+		QMetaObject::invokeMethod(this, "resolvePrefixes", Qt::QueuedConnection);
+	}
+
+	return isMatching;
+}
+
+}
@@ -0,0 +1,124 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_HASHPREFIXCONTENTFILTERSPROFILE_H
+#define OTTER_HASHPREFIXCONTENTFILTERSPROFILE_H
+
+#include "ContentFiltersManager.h"
+
+#include <QtCore/QCache>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+
+namespace Otter
+{
+
+class DataFetchJob;
+
+class HashPrefixContentFiltersProfile final : public ContentFiltersProfile
+{
+	Q_OBJECT
+
+public:
+	explicit HashPrefixContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, int updateInterval, const ProfileFlags &flags, QObject *parent = nullptr);
+	~HashPrefixContentFiltersProfile();
+
+	void clear() override;
+	void setCategory(ProfileCategory category) override;
+	void setTitle(const QString &title) override;
+	void setUpdateInterval(int interval) override;
+	void setUpdateUrl(const QUrl &url) override;
+	QString getName() const override;
+	QString getTitle() const override;
+	QUrl getUpdateUrl() const override;
+	QDateTime getLastUpdate() const override;
+	ContentFiltersManager::CheckResult checkUrl(const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType) override;
+	ProfileCategory getCategory() const override;
+	ProfileError getError() const override;
+	ProfileFlags getFlags() const override;
+	int getUpdateInterval() const override;
+	int getUpdateProgress() const override;
+	bool update() override;
+	bool remove() override;
+	bool isUpdating() const override;
+	bool isFraud(const QUrl &url) override;
+
+	static QVector<QByteArray> createUrlExpressions(const QUrl &url);
+
+protected:
+	struct UpdateResult final
+	{
+		QString errorString;
+		quint64 version = 0;
+		qint64 updateTime = 0;
+		ProfileError error = NoError;
+		bool isUpToDate = false;
+	};
+
+	struct Database final
+	{
+		QFile file;
+		uchar *data = nullptr;
+		const uchar *records = nullptr;
+		quint64 version = 0;
+		qint64 updateTime = 0;
+		quint32 amount = 0;
+	};
+
+	QString getPath() const;
+	void loadDatabase();
+	void closeDatabase(Database *database);
+	static UpdateResult mergeUpdate(const QByteArray &data, const QByteArray &currentPrefixes, quint64 currentVersion, const QString &path);
+	bool openDatabase(Database *database);
+	bool replaceDatabase();
+	static bool writeDatabase(const QString &path, const QVector<QByteArray> &records, quint64 version, qint64 updateTime);
+	static bool writeUpdateTime(const QString &path, qint64 updateTime);
+	static bool containsPrefix(const Database &database, const char *prefix);
+
+protected slots:
+	void raiseError(const QString &message, ProfileError error);
+	void resolvePrefixes();
+	void handleJobFinished(bool isSuccess);
+	void handleResolveJobFinished(bool isSuccess);
+	void handleUpdateMerged(const UpdateResult &result);
+
+private:
+	DataFetchJob *m_dataFetchJob;
+	DataFetchJob *m_resolveJob;
+	QString m_name;
+	QString m_title;
+	QUrl m_updateUrl;
+	QDateTime m_lastUpdate;
+	QMutex m_databaseMutex;
+	Database m_database;
+	QCache<QByteArray, QVector<QByteArray> > m_fullHashes;
+	QSet<QByteArray> m_pendingPrefixes;
+	QVector<QByteArray> m_resolvingPrefixes;
+	ProfileCategory m_category;
+	ProfileError m_error;
+	ProfileFlags m_flags;
+	int m_updateInterval;
+	bool m_isMerging;
+	bool m_wasLoaded;
+};
+
+}
+
+#endif
@@ -21,16 +21,19 @@
 #include "HistoryManager.h"
 #include "AddonsManager.h"
 #include "Application.h"
+#include "FaviconsDatabase.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "ThemesManager.h"
 
+#include <QtCore/QFile>
 #include <QtCore/QTimerEvent>
 
 namespace Otter
 {
 
 HistoryManager* HistoryManager::m_instance(nullptr);
+FaviconsDatabase* HistoryManager::m_faviconsDatabase(nullptr);
 HistoryModel* HistoryManager::m_browsingHistoryModel(nullptr);
 HistoryModel* HistoryManager::m_typedHistoryModel(nullptr);
 bool HistoryManager::m_isEnabled(false);
@@ -115,6 +118,36 @@ void HistoryManager::save()
 	{
 		m_typedHistoryModel->save(SessionsManager::getWritableDataPath(QLatin1String("typedHistory.json")));
 	}
+
+	if (!m_removedUrls.isEmpty() && m_browsingHistoryModel && QFile::exists(SessionsManager::getWritableDataPath(QLatin1String("favicons.pack"))))
+	{
+		getFaviconsDatabase();
+	}
+
+	if (m_faviconsDatabase)
+	{
+		if (!m_removedUrls.isEmpty() && m_browsingHistoryModel)
+		{
+			QVector<QUrl> urls;
+			urls.reserve(m_removedUrls.count());
+
+			QSet<QUrl>::const_iterator iterator;
+
+			for (iterator = m_removedUrls.constBegin(); iterator != m_removedUrls.constEnd(); ++iterator)
+			{
+				if (!m_browsingHistoryModel->hasEntry(Utils::normalizeUrl(*iterator)))
+				{
+					urls.append(*iterator);
+				}
+			}
+
+			m_faviconsDatabase->removeIcons(urls);
+		}
+
+		m_faviconsDatabase->save();
+	}
+
+	m_removedUrls.clear();
 }
 
 void HistoryManager::clearHistory(uint period)
@@ -132,6 +165,11 @@ void HistoryManager::clearHistory(uint period)
 	m_browsingHistoryModel->clearRecentEntries(period);
 	m_typedHistoryModel->clearRecentEntries(period);
 
+	if (period == 0 && m_faviconsDatabase)
+	{
+		m_faviconsDatabase->clear();
+	}
+
 	m_instance->scheduleSave();
 }
 
@@ -200,9 +238,21 @@ void HistoryManager::updateEntry(quint64 identifier, const QUrl &url, const QStr
 		item->setIcon(icon);
 	}
 
+	setIcon(url, icon);
+
 	m_instance->scheduleSave();
 }
 
+void HistoryManager::setIcon(const QUrl &url, const QIcon &icon)
+{
+	if (!m_isEnabled || !m_isStoringFavicons || !m_instance || icon.isNull() || Utils::isUrlEmpty(url) || url.scheme() == QLatin1String("about"))
+	{
+		return;
+	}
+
+	getFaviconsDatabase()->setIcon(url, icon);
+}
+
 void HistoryManager::handleOptionChanged(int identifier)
 {
 	switch (identifier)
@@ -263,16 +313,39 @@ void HistoryManager::handleOptionChanged(int identifier)
 	}
 }
 
+void HistoryManager::handleEntryRemoved(HistoryModel::Entry *entry)
+{
+	if (entry)
+	{
+		m_removedUrls.insert(entry->getUrl());
+	}
+}
+
 HistoryManager* HistoryManager::getInstance()
 {
 	return m_instance;
 }
 
+FaviconsDatabase* HistoryManager::getFaviconsDatabase()
+{
+	if (!m_faviconsDatabase)
+	{
+		m_faviconsDatabase = new FaviconsDatabase(SessionsManager::getWritableDataPath(QLatin1String("favicons.pack")), m_instance);
+	}
+
+	return m_faviconsDatabase;
+}
+
 HistoryModel* HistoryManager::getBrowsingHistoryModel()
 {
 	if (!m_browsingHistoryModel)
 	{
 		m_browsingHistoryModel = new HistoryModel(SessionsManager::getWritableDataPath(QLatin1String("browsingHistory.json")), HistoryModel::BrowsingHistory, m_instance);
+
+		if (m_instance)
+		{
+			connect(m_browsingHistoryModel, &HistoryModel::entryRemoved, m_instance, &HistoryManager::handleEntryRemoved);
+		}
 	}
 
 	return m_browsingHistoryModel;
@@ -310,7 +383,15 @@ QIcon HistoryManager::getIcon(const QUrl &url)
 		}
 	}
 
-///TODO
+	if (m_isStoringFavicons && m_instance)
+	{
+		const QIcon icon(getFaviconsDatabase()->getIcon(url));
+
+		if (!icon.isNull())
+		{
+			return icon;
+		}
+	}
 
 	return ThemesManager::createIcon(QLatin1String("text-html"));
 }
@@ -371,6 +452,8 @@ quint64 HistoryManager::addEntry(const QUrl &url, const QString &title, const QI
 		m_typedHistoryModel->addEntry(url, title, icon, QDateTime::currentDateTimeUtc());
 	}
 
+	setIcon(url, icon);
+
 	const int limit(SettingsManager::getOption(SettingsManager::History_BrowsingLimitAmountGlobalOption).toInt());
 
 	if (limit > 0 && m_browsingHistoryModel->rowCount() > limit)
@@ -401,4 +484,9 @@ bool HistoryManager::hasEntry(const QUrl &url)
 	return m_browsingHistoryModel->hasEntry(url);
 }
 
+bool HistoryManager::isEnabled()
+{
+	return m_isEnabled;
+}
+
 }
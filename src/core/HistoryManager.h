@@ -23,12 +23,15 @@
 
 #include "HistoryModel.h"
 
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtGui/QIcon>
 
 namespace Otter
 {
 
+class FaviconsDatabase;
+
 class HistoryManager final : public QObject
 {
 	Q_OBJECT
@@ -39,6 +42,7 @@ public:
 	static void removeEntry(quint64 identifier);
 	static void removeEntries(const QVector<quint64> &identifiers);
 	static void updateEntry(quint64 identifier, const QUrl &url, const QString &title, const QIcon &icon);
+	static void setIcon(const QUrl &url, const QIcon &icon);
 	static HistoryManager* getInstance();
 	static HistoryModel* getBrowsingHistoryModel();
 	static HistoryModel* getTypedHistoryModel();
@@ -47,6 +51,7 @@ public:
 	static QVector<HistoryModel::HistoryEntryMatch> findEntries(const QString &prefix, bool isTypedInOnly = false);
 	static quint64 addEntry(const QUrl &url, const QString &title, const QIcon &icon, bool isTypedIn = false);
 	static bool hasEntry(const QUrl &url);
+	static bool isEnabled();
 
 protected:
 	explicit HistoryManager(QObject *parent);
@@ -54,15 +59,19 @@ protected:
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
 	void save();
+	static FaviconsDatabase* getFaviconsDatabase();
 
 protected slots:
 	void handleOptionChanged(int identifier);
+	void handleEntryRemoved(HistoryModel::Entry *entry);
 
 private:
+	QSet<QUrl> m_removedUrls;
 	int m_dayTimer;
 	int m_saveTimer;
 
 	static HistoryManager *m_instance;
+	static FaviconsDatabase *m_faviconsDatabase;
 	static HistoryModel *m_browsingHistoryModel;
 	static HistoryModel *m_typedHistoryModel;
 	static bool m_isEnabled;
@@ -22,6 +22,7 @@
 #include "Console.h"
 #include "JsonSettings.h"
 #include "SessionsManager.h"
+#include "StartupManager.h"
 #include "ThemesManager.h"
 #include "Utils.h"
 
@@ -83,18 +84,25 @@ quint64 HistoryModel::Entry::getIdentifier() const
 HistoryModel::HistoryModel(const QString &path, HistoryType type, QObject *parent) : QStandardItemModel(parent),
 	m_type(type)
 {
-	QFile file(path);
+	QByteArray data;
 
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	if (!StartupManager::takePreloadedFile(path, &data))
 	{
-		Console::addMessage(tr("Failed to open history file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+		QFile file(path);
 
-		return;
-	}
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			Console::addMessage(tr("Failed to open history file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
 
-	const QJsonArray historyArray(QJsonDocument::fromJson(file.readAll()).array());
+			return;
+		}
+
+		data = file.readAll();
 
-	file.close();
+		file.close();
+	}
+
+	const QJsonArray historyArray(QJsonDocument::fromJson(data).array());
 
 	for (int i = 0; i < historyArray.count(); ++i)
 	{
@@ -327,9 +335,12 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 		return QStandardItemModel::setData(index, value, role);
 	}
 
-	if (role == UrlRole && value.toUrl() != index.data(UrlRole).toUrl())
+	const QUrl previousUrl((role == UrlRole) ? index.data(UrlRole).toUrl() : QUrl());
+	const bool isUrlModified(role == UrlRole && value.toUrl() != previousUrl);
+
+	if (isUrlModified)
 	{
-		const QUrl oldUrl(Utils::normalizeUrl(index.data(UrlRole).toUrl()));
+		const QUrl oldUrl(Utils::normalizeUrl(previousUrl));
 		const QUrl newUrl(Utils::normalizeUrl(value.toUrl()));
 
 		if (!oldUrl.isEmpty() && m_urls.contains(oldUrl))
@@ -355,6 +366,11 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 
 	entry->setItemData(value, role);
 
+	if (isUrlModified)
+	{
+		emit entryUrlModified(entry, previousUrl);
+	}
+
 	switch (role)
 	{
 		case TitleRole:
@@ -94,6 +94,7 @@ signals:
 	void cleared();
 	void entryAdded(Entry *entry);
 	void entryModified(Entry *entry);
+	void entryUrlModified(Entry *entry, const QUrl &previousUrl);
 	void entryRemoved(Entry *entry);
 	void modelModified();
 };
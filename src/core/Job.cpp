@@ -22,9 +22,23 @@
 #include "NetworkManagerFactory.h"
 #include "Utils.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QTextStream>
+
+#define FETCH_RESPONSES_CACHE_LIMIT 16384
+#define FETCH_TRANSFERS_LIMIT 4
+#define FETCH_USER_TRANSFERS_RESERVE 2
+
 namespace Otter
 {
 
+QVector<FetchJob*> FetchJob::m_queuedJobs;
+QVector<FetchJob*> FetchJob::m_activeJobs;
+QCache<QUrl, FetchJob::ResponseInformation> FetchJob::m_responses(FETCH_RESPONSES_CACHE_LIMIT);
+QHash<QNetworkReply*, FetchJob::ResponseInformation> FetchJob::m_validatedResponses;
+FetchJob::FetchStatistics FetchJob::m_statistics;
+int FetchJob::m_transfersAmount(0);
+
 Job::Job(QObject *parent) : QObject(parent),
 	m_progress(-1)
 {
@@ -48,17 +62,20 @@ void Job::setProgress(int progress)
 FetchJob::FetchJob(const QUrl &url, QObject *parent) : Job(parent),
 	m_reply(nullptr),
 	m_url(url),
+	m_priority(BackgroundPriority),
 	m_sizeLimit(-1),
+	m_timeout(0),
 	m_timeoutTimer(0),
 	m_isFinished(false),
 	m_isPrivate(false),
+	m_isStarted(false),
 	m_isSuccess(true)
 {
 }
 
 FetchJob::~FetchJob()
 {
-	m_reply->deleteLater();
+	detach();
 }
 
 void FetchJob::timerEvent(QTimerEvent *event)
@@ -74,51 +91,305 @@ void FetchJob::timerEvent(QTimerEvent *event)
 
 void FetchJob::start()
 {
-	if (m_reply)
+	if (m_isStarted)
 	{
 		return;
 	}
 
-	m_reply = NetworkManagerFactory::createRequest(m_url, QNetworkAccessManager::GetOperation, m_isPrivate);
+	m_isStarted = true;
 
-	connect(m_reply, &QNetworkReply::downloadProgress, this, [&](qint64 bytesReceived, qint64 bytesTotal)
+	m_timer.start();
+
+	if (m_priority == UserPriority)
 	{
-		if (m_sizeLimit >= 0 && ((bytesReceived > m_sizeLimit) || (bytesTotal > m_sizeLimit)))
+		int position(0);
+
+		while (position < m_queuedJobs.count() && m_queuedJobs.at(position)->m_priority == UserPriority)
 		{
-			cancel();
+			++position;
 		}
 
-		if (bytesTotal > 0)
+		m_queuedJobs.insert(position, this);
+	}
+	else
+	{
+		m_queuedJobs.append(this);
+	}
+
+	processQueue();
+}
+
+void FetchJob::cancel()
+{
+	detach();
+	deleteLater();
+
+	emit jobFinished(false);
+}
+
+void FetchJob::detach()
+{
+	m_queuedJobs.removeAll(this);
+
+	if (!m_reply)
+	{
+		return;
+	}
+
+	QNetworkReply *reply(m_reply);
+
+	m_activeJobs.removeAll(this);
+
+	m_reply = nullptr;
+
+	if (!hasJobs(reply))
+	{
+		m_validatedResponses.remove(reply);
+
+		reply->blockSignals(true);
+		reply->abort();
+		reply->deleteLater();
+
+		--m_transfersAmount;
+
+		processQueue();
+	}
+}
+
+void FetchJob::dispatchJob(FetchJob *job)
+{
+	QNetworkReply *reply(findReply(job->m_url, job->m_isPrivate));
+
+	job->m_timings.queueDuration = job->m_timer.elapsed();
+
+	if (reply)
+	{
+		job->m_timings.isShared = true;
+	}
+	else
+	{
+		const ResponseInformation *response(job->m_isPrivate ? nullptr : m_responses.object(job->m_url));
+		QNetworkRequest request(job->m_url);
+
+		if (response)
 		{
-			setProgress(Utils::calculatePercent(bytesReceived, bytesTotal));
+			if (!response->entityTag.isEmpty())
+			{
+				request.setRawHeader(QByteArrayLiteral("If-None-Match"), response->entityTag);
+			}
+
+			if (!response->lastModified.isEmpty())
+			{
+				request.setRawHeader(QByteArrayLiteral("If-Modified-Since"), response->lastModified);
+			}
+
+			request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 		}
-	});
-	connect(m_reply, &QNetworkReply::finished, this, [&]()
+
+		reply = NetworkManagerFactory::createRequest(request, QNetworkAccessManager::GetOperation, job->m_isPrivate);
+
+		if (response)
+		{
+			m_validatedResponses.insert(reply, *response);
+		}
+
+		++m_transfersAmount;
+
+		connect(reply, &QNetworkReply::downloadProgress, reply, [=](qint64 bytesReceived, qint64 bytesTotal)
+		{
+			handleReplyProgress(reply, bytesReceived, bytesTotal);
+		});
+		connect(reply, &QNetworkReply::finished, reply, [=]()
+		{
+			handleReplyFinished(reply);
+		});
+	}
+
+	job->m_reply = reply;
+
+	if (job->m_timeout > 0)
 	{
-		const bool isSuccess(m_reply->error() == QNetworkReply::NoError);
+		job->m_timeoutTimer = job->startTimer(job->m_timeout * 1000);
+	}
 
-		if (isSuccess && (m_sizeLimit < 0 || m_reply->size() <= m_sizeLimit))
+	m_activeJobs.append(job);
+}
+
+void FetchJob::processQueue()
+{
+	while (!m_queuedJobs.isEmpty())
+	{
+		FetchJob *job(m_queuedJobs.first());
+		const int limit((job->m_priority == UserPriority) ? (FETCH_TRANSFERS_LIMIT + FETCH_USER_TRANSFERS_RESERVE) : FETCH_TRANSFERS_LIMIT);
+
+		if (m_transfersAmount >= limit && !findReply(job->m_url, job->m_isPrivate))
 		{
-			handleSuccessfulReply(m_reply);
+			break;
 		}
 
-		if (!isSuccess || m_isFinished)
+		m_queuedJobs.removeFirst();
+
+		dispatchJob(job);
+	}
+}
+
+void FetchJob::handleReplyProgress(QNetworkReply *reply, qint64 bytesReceived, qint64 bytesTotal)
+{
+	const QVector<FetchJob*> jobs(m_activeJobs);
+
+	for (int i = 0; i < jobs.count(); ++i)
+	{
+		if (jobs.at(i)->m_reply == reply)
 		{
-			deleteLater();
+			jobs.at(i)->handleDownloadProgress(bytesReceived, bytesTotal);
+		}
+	}
+}
+
+void FetchJob::handleReplyFinished(QNetworkReply *reply)
+{
+	QVector<FetchJob*> jobs;
+
+	for (int i = (m_activeJobs.count() - 1); i >= 0; --i)
+	{
+		if (m_activeJobs.at(i)->m_reply == reply)
+		{
+			jobs.prepend(m_activeJobs.takeAt(i));
+		}
+	}
+
+	--m_transfersAmount;
+
+	const QUrl url(reply->request().url());
+	const bool isPrivate(jobs.isEmpty() || jobs.first()->m_isPrivate);
+	const bool hasValidatedResponse(m_validatedResponses.contains(reply));
+	const ResponseInformation validatedResponse(m_validatedResponses.take(reply));
+	bool isSuccess(reply->error() == QNetworkReply::NoError);
+	bool isNotModified(false);
+	ResponseInformation response;
+
+	if (isSuccess && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304)
+	{
+		if (hasValidatedResponse)
+		{
+			response = validatedResponse;
+
+			isNotModified = true;
 
-			emit jobFinished(isSuccess && m_isSuccess);
+			if (!isPrivate && !m_responses.contains(url))
+			{
+				m_responses.insert(url, new ResponseInformation(response), qMax(1, (response.data.size() / 1024)));
+			}
 		}
-	});
+		else
+		{
+			isSuccess = false;
+		}
+	}
+	else if (isSuccess)
+	{
+		const QList<QNetworkReply::RawHeaderPair> rawHeaders(reply->rawHeaderPairs());
+
+		for (int i = 0; i < rawHeaders.count(); ++i)
+		{
+			response.headers[rawHeaders.at(i).first] = rawHeaders.at(i).second;
+		}
+
+		response.data = reply->readAll();
+		response.entityTag = reply->rawHeader(QByteArrayLiteral("ETag"));
+		response.lastModified = reply->rawHeader(QByteArrayLiteral("Last-Modified"));
+
+		if (!isPrivate && (!response.entityTag.isEmpty() || !response.lastModified.isEmpty()))
+		{
+			m_responses.insert(url, new ResponseInformation(response), qMax(1, (response.data.size() / 1024)));
+		}
+		else
+		{
+			m_responses.remove(url);
+		}
+	}
+
+	reply->deleteLater();
+
+	for (int i = 0; i < jobs.count(); ++i)
+	{
+		jobs.at(i)->handleTransferFinished(isSuccess, response, isNotModified);
+	}
+
+	processQueue();
 }
 
-void FetchJob::cancel()
+void FetchJob::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
 {
-	m_reply->blockSignals(true);
-	m_reply->abort();
+	if (m_sizeLimit >= 0 && ((bytesReceived > m_sizeLimit) || (bytesTotal > m_sizeLimit)))
+	{
+		cancel();
 
-	deleteLater();
+		return;
+	}
 
-	emit jobFinished(false);
+	if (bytesTotal > 0)
+	{
+		setProgress(Utils::calculatePercent(bytesReceived, bytesTotal));
+	}
+}
+
+void FetchJob::handleTransferFinished(bool isSuccess, const ResponseInformation &response, bool isNotModified)
+{
+	m_reply = nullptr;
+	m_timings.transferDuration = (m_timer.elapsed() - m_timings.queueDuration);
+	m_timings.isNotModified = isNotModified;
+
+	++m_statistics.jobsAmount;
+
+	m_statistics.queueDuration += m_timings.queueDuration;
+	m_statistics.maximumQueueDuration = qMax(m_statistics.maximumQueueDuration, m_timings.queueDuration);
+	m_statistics.transferDuration += m_timings.transferDuration;
+	m_statistics.maximumTransferDuration = qMax(m_statistics.maximumTransferDuration, m_timings.transferDuration);
+
+	if (m_timings.isShared)
+	{
+		++m_statistics.sharedAmount;
+	}
+
+	if (isNotModified)
+	{
+		++m_statistics.notModifiedAmount;
+	}
+
+	if (!isSuccess)
+	{
+		++m_statistics.failedAmount;
+	}
+
+	if (m_timeoutTimer != 0)
+	{
+		killTimer(m_timeoutTimer);
+
+		m_timeoutTimer = 0;
+	}
+
+	if (isSuccess && (m_sizeLimit < 0 || response.data.size() <= m_sizeLimit))
+	{
+		QBuffer *buffer(new QBuffer(this));
+		buffer->setData(response.data);
+		buffer->open(QIODevice::ReadOnly);
+
+		m_headers = response.headers;
+
+		handleSuccessfulReply(buffer);
+	}
+	else
+	{
+		isSuccess = false;
+	}
+
+	if (!isSuccess || m_isFinished)
+	{
+		deleteLater();
+
+		emit jobFinished(isSuccess && m_isSuccess);
+	}
 }
 
 void FetchJob::markAsFailure()
@@ -133,12 +404,19 @@ void FetchJob::markAsFinished()
 
 void FetchJob::setTimeout(int seconds)
 {
+	m_timeout = seconds;
+
 	if (m_timeoutTimer != 0)
 	{
 		killTimer(m_timeoutTimer);
+
+		m_timeoutTimer = 0;
 	}
 
-	m_timeoutTimer = startTimer(seconds * 1000);
+	if (m_reply && m_timeout > 0)
+	{
+		m_timeoutTimer = startTimer(m_timeout * 1000);
+	}
 }
 
 void FetchJob::setSizeLimit(qint64 limit)
@@ -151,44 +429,112 @@ void FetchJob::setPrivate(bool isPrivate)
 	m_isPrivate = isPrivate;
 }
 
-QUrl FetchJob::getUrl() const
+void FetchJob::setPriority(FetchPriority priority)
 {
-	return (m_reply ? m_reply->request().url() : m_url);
+	m_priority = priority;
 }
 
-bool FetchJob::isRunning() const
+QNetworkReply* FetchJob::findReply(const QUrl &url, bool isPrivate)
 {
-	return (m_reply != nullptr);
+	for (int i = 0; i < m_activeJobs.count(); ++i)
+	{
+		if (m_activeJobs.at(i)->m_url == url && m_activeJobs.at(i)->m_isPrivate == isPrivate)
+		{
+			return m_activeJobs.at(i)->m_reply;
+		}
+	}
+
+	return nullptr;
 }
 
-DataFetchJob::DataFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, parent),
-	m_reply(nullptr)
+QUrl FetchJob::getUrl() const
 {
+	return m_url;
 }
 
-void DataFetchJob::handleSuccessfulReply(QNetworkReply *reply)
+QMap<QByteArray, QByteArray> FetchJob::getHeaders() const
 {
-	m_reply = reply;
-
-	markAsFinished();
+	return m_headers;
 }
 
-QIODevice* DataFetchJob::getData() const
+FetchJob::TimingInformation FetchJob::getTimings() const
 {
-	return m_reply;
+	return m_timings;
 }
 
-QMap<QByteArray, QByteArray> DataFetchJob::getHeaders() const
+QString FetchJob::createReport()
 {
-	QMap<QByteArray, QByteArray> headers;
-	const QList<QNetworkReply::RawHeaderPair> rawHeaders(m_reply->rawHeaderPairs());
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignLeft);
+	stream << QLatin1String("Fetch Jobs:\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Finished Transfers");
+	stream << m_statistics.jobsAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Failed Transfers");
+	stream << m_statistics.failedAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Shared Transfers");
+	stream << m_statistics.sharedAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Not Modified Responses");
+	stream << m_statistics.notModifiedAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Queue Wait (average / max)");
+	stream.setFieldWidth(0);
+	stream << QStringLiteral("%1 ms / %2 ms").arg((m_statistics.jobsAmount > 0) ? (m_statistics.queueDuration / m_statistics.jobsAmount) : 0).arg(m_statistics.maximumQueueDuration);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Transfer Time (average / max)");
+	stream.setFieldWidth(0);
+	stream << QStringLiteral("%1 ms / %2 ms").arg((m_statistics.jobsAmount > 0) ? (m_statistics.transferDuration / m_statistics.jobsAmount) : 0).arg(m_statistics.maximumTransferDuration);
+	stream << QLatin1String("\n\n");
+
+	return report;
+}
 
-	for (int i = 0; i < rawHeaders.count(); ++i)
+bool FetchJob::hasJobs(QNetworkReply *reply)
+{
+	for (int i = 0; i < m_activeJobs.count(); ++i)
 	{
-		headers[rawHeaders.at(i).first] = rawHeaders.at(i).second;
+		if (m_activeJobs.at(i)->m_reply == reply)
+		{
+			return true;
+		}
 	}
 
-	return headers;
+	return false;
+}
+
+bool FetchJob::isRunning() const
+{
+	return m_isStarted;
+}
+
+DataFetchJob::DataFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, parent),
+	m_device(nullptr)
+{
+}
+
+void DataFetchJob::handleSuccessfulReply(QIODevice *device)
+{
+	m_device = device;
+
+	markAsFinished();
+}
+
+QIODevice* DataFetchJob::getData() const
+{
+	return m_device;
 }
 
 IconFetchJob::IconFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, parent)
@@ -197,11 +543,11 @@ IconFetchJob::IconFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, par
 	setTimeout(5);
 }
 
-void IconFetchJob::handleSuccessfulReply(QNetworkReply *reply)
+void IconFetchJob::handleSuccessfulReply(QIODevice *device)
 {
 	QPixmap pixmap;
 
-	if (pixmap.loadFromData(reply->readAll()))
+	if (pixmap.loadFromData(device->readAll()))
 	{
 		m_icon = QIcon(pixmap);
 	}
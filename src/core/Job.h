@@ -20,6 +20,8 @@
 #ifndef OTTER_JOB_H
 #define OTTER_JOB_H
 
+#include <QtCore/QCache>
+#include <QtCore/QElapsedTimer>
 #include <QtGui/QIcon>
 #include <QtNetwork/QNetworkReply>
 
@@ -56,33 +58,93 @@ class FetchJob : public Job
 	Q_OBJECT
 
 public:
+	enum FetchPriority
+	{
+		BackgroundPriority = 0,
+		UserPriority
+	};
+
+	struct TimingInformation final
+	{
+		qint64 queueDuration = -1;
+		qint64 transferDuration = -1;
+		bool isShared = false;
+		bool isNotModified = false;
+	};
+
 	explicit FetchJob(const QUrl &url, QObject *parent = nullptr);
 	~FetchJob();
 
 	void setTimeout(int seconds);
 	void setSizeLimit(qint64 limit);
 	void setPrivate(bool isPrivate);
+	void setPriority(FetchPriority priority);
 	QUrl getUrl() const;
+	QMap<QByteArray, QByteArray> getHeaders() const;
+	TimingInformation getTimings() const;
 	bool isRunning() const override;
+	static QString createReport();
 
 public slots:
 	void start() override;
 	void cancel() override;
 
 protected:
+	struct ResponseInformation final
+	{
+		QMap<QByteArray, QByteArray> headers;
+		QByteArray data;
+		QByteArray entityTag;
+		QByteArray lastModified;
+	};
+
+	struct FetchStatistics final
+	{
+		qint64 queueDuration = 0;
+		qint64 maximumQueueDuration = 0;
+		qint64 transferDuration = 0;
+		qint64 maximumTransferDuration = 0;
+		int jobsAmount = 0;
+		int sharedAmount = 0;
+		int notModifiedAmount = 0;
+		int failedAmount = 0;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void markAsFailure();
 	void markAsFinished();
-	virtual void handleSuccessfulReply(QNetworkReply *reply) = 0;
+	void detach();
+	void handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+	void handleTransferFinished(bool isSuccess, const ResponseInformation &response, bool isNotModified);
+	virtual void handleSuccessfulReply(QIODevice *device) = 0;
+	static void dispatchJob(FetchJob *job);
+	static void processQueue();
+	static void handleReplyProgress(QNetworkReply *reply, qint64 bytesReceived, qint64 bytesTotal);
+	static void handleReplyFinished(QNetworkReply *reply);
+	static QNetworkReply* findReply(const QUrl &url, bool isPrivate);
+	static bool hasJobs(QNetworkReply *reply);
 
 private:
 	QNetworkReply *m_reply;
 	QUrl m_url;
+	QMap<QByteArray, QByteArray> m_headers;
+	QElapsedTimer m_timer;
+	TimingInformation m_timings;
+	FetchPriority m_priority;
 	qint64 m_sizeLimit;
+	int m_timeout;
 	int m_timeoutTimer;
 	bool m_isFinished;
 	bool m_isPrivate;
+	bool m_isStarted;
 	bool m_isSuccess;
+
+	static QVector<FetchJob*> m_queuedJobs;
+	static QVector<FetchJob*> m_activeJobs;
+	static QCache<QUrl, ResponseInformation> m_responses;
+	static QHash<QNetworkReply*, ResponseInformation> m_validatedResponses;
+	static FetchStatistics m_statistics;
+	static int m_transfersAmount;
 };
 
 class DataFetchJob final : public FetchJob
@@ -93,13 +155,12 @@ public:
 	explicit DataFetchJob(const QUrl &url, QObject *parent = nullptr);
 
 	QIODevice* getData() const;
-	QMap<QByteArray, QByteArray> getHeaders() const;
 
 protected:
-	void handleSuccessfulReply(QNetworkReply *reply) override;
+	void handleSuccessfulReply(QIODevice *device) override;
 
 private:
-	QNetworkReply *m_reply;
+	QIODevice *m_device;
 };
 
 class IconFetchJob final : public FetchJob
@@ -112,7 +173,7 @@ public:
 	QIcon getIcon() const;
 
 protected:
-	void handleSuccessfulReply(QNetworkReply *reply) override;
+	void handleSuccessfulReply(QIODevice *device) override;
 
 private:
 	QIcon m_icon;
@@ -23,22 +23,113 @@
 #include "ThemesManager.h"
 #include "Utils.h"
 
-#include <QtCore/QBuffer>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QtMath>
+#include <QtCore/QUrlQuery>
 #include <QtWidgets/QFileIconProvider>
 
+#define LISTING_ENTRIES_LIMIT 1000
+
 namespace Otter
 {
 
+QHash<QString, QString> ListingNetworkReply::m_iconsData;
+bool ListingNetworkReply::m_isWatchingThemes(false);
+
 ListingNetworkReply::ListingNetworkReply(const QNetworkRequest &request, QObject *parent) : QNetworkReply(parent)
 {
 	setRequest(request);
+
+	if (!m_isWatchingThemes && ThemesManager::getInstance())
+	{
+		m_isWatchingThemes = true;
+
+		connect(ThemesManager::getInstance(), &ThemesManager::iconThemeChanged, ThemesManager::getInstance(), &ListingNetworkReply::clearIconsData);
+		connect(ThemesManager::getInstance(), &ThemesManager::widgetStyleChanged, ThemesManager::getInstance(), &ListingNetworkReply::clearIconsData);
+	}
+}
+
+void ListingNetworkReply::clearIconsData()
+{
+	m_iconsData.clear();
+}
+
+QString ListingNetworkReply::getIconData(const ListingNetworkReply::ListingEntry &entry) const
+{
+	const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
+	const QString key(QStringLiteral("%1|%2|%3|%4").arg(entry.mimeType.name()).arg(entry.type).arg(entry.isSymlink).arg(iconSize));
+
+	if (m_iconsData.contains(key))
+	{
+		return m_iconsData[key];
+	}
+
+	const QFileIconProvider iconProvider;
+	QIcon icon;
+
+	switch (entry.type)
+	{
+		case ListingEntry::DirectoryType:
+			icon = iconProvider.icon(QFileIconProvider::Folder);
+
+			break;
+		case ListingEntry::DriveType:
+			icon = iconProvider.icon(QFileIconProvider::Drive);
+
+			break;
+		case ListingEntry::FileType:
+			icon = iconProvider.icon(QFileIconProvider::File);
+
+			break;
+		default:
+			break;
+	}
+
+	icon = QIcon::fromTheme(entry.mimeType.iconName(), icon);
+
+	if (icon.isNull())
+	{
+		switch (entry.type)
+		{
+			case ListingEntry::DriveType:
+			case ListingEntry::DirectoryType:
+				icon = ThemesManager::createIcon(QLatin1String("inode-directory"), false);
+
+				break;
+			case ListingEntry::FileType:
+				icon = ThemesManager::createIcon(QLatin1String("unknown"), false);
+
+				break;
+			default:
+				icon = ThemesManager::createIcon((entry.isSymlink ? QLatin1String("link") : QLatin1String("unknown")), false);
+
+				break;
+		}
+	}
+
+	const QString data(Utils::savePixmapAsDataUri(icon.pixmap(iconSize, iconSize)));
+
+	m_iconsData[key] = data;
+
+	return data;
+}
+
+QUrl ListingNetworkReply::getMoreEntriesUrl() const
+{
+	QUrl url(request().url());
+	QUrlQuery query(url);
+	query.removeAllQueryItems(QLatin1String("limit"));
+	query.addQueryItem(QLatin1String("limit"), QString::number(getEntriesLimit() + LISTING_ENTRIES_LIMIT));
+
+	url.setQuery(query);
+
+	return url;
 }
 
-QByteArray ListingNetworkReply::createListing(const QString &title, const QVector<ListingNetworkReply::NavigationEntry> &navigation, const QVector<ListingNetworkReply::ListingEntry> &entries)
+QByteArray ListingNetworkReply::createListingHeader(const QString &title, const QVector<ListingNetworkReply::NavigationEntry> &navigation)
 {
 	const QRegularExpression entryExpression(QLatin1String("<!--entry:begin-->(.*)<!--entry:end-->"), (QRegularExpression::DotMatchesEverythingOption | QRegularExpression::MultilineOption));
+	const QRegularExpression moreExpression(QLatin1String("<!--more:begin-->(.*)<!--more:end-->"), (QRegularExpression::DotMatchesEverythingOption | QRegularExpression::MultilineOption));
 	QFile file(SessionsManager::getReadableDataPath(QLatin1String("files/listing.html")));
 	file.open(QIODevice::ReadOnly | QIODevice::Text);
 
@@ -46,69 +137,58 @@ QByteArray ListingNetworkReply::createListing(const QString &title, const QVecto
 	stream.setCodec("UTF-8");
 
 	QString navigationHtml;
-	QString entriesHtml;
 	QString listingTemplate(stream.readAll());
-	const QString entryTemplate(entryExpression.match(listingTemplate).captured(1));
 
+	m_entryTemplate = entryExpression.match(listingTemplate).captured(1);
+	m_moreTemplate = moreExpression.match(listingTemplate).captured(1);
+
+	listingTemplate.remove(moreExpression);
 	listingTemplate.replace(entryExpression, QLatin1String("{entries}"));
 
+	const QString entriesPlaceholder(QLatin1String("{entries}"));
+	const int entriesPosition(listingTemplate.indexOf(entriesPlaceholder));
+
+	m_footerTemplate = ((entriesPosition < 0) ? QString() : listingTemplate.mid(entriesPosition + entriesPlaceholder.length()));
+
+	if (entriesPosition >= 0)
+	{
+		listingTemplate.truncate(entriesPosition);
+	}
+
 	for (int i = 0; i < navigation.count(); ++i)
 	{
 		navigationHtml.append(QStringLiteral("<a href=\"%1\">%2</a>").arg(navigation[i].url.toString()).arg(navigation[i].name) + ((i < (navigation.count() - 1)) ? QLatin1String("&shy;") : QString()));
 	}
 
-	QHash<QString, QIcon> icons;
-	const QFileIconProvider iconProvider;
+	QHash<QString, QString> variables;
+	variables[QLatin1String("title")] = title.toHtmlEscaped();
+	variables[QLatin1String("description")] = tr("Directory Contents").toHtmlEscaped();
+	variables[QLatin1String("dir")] = (Application::isLeftToRight() ? QLatin1String("ltr") : QLatin1String("rtl"));
+	variables[QLatin1String("style")] = QString();
+	variables[QLatin1String("navigation")] = navigationHtml;
+	variables[QLatin1String("headerName")] = tr("Name").toHtmlEscaped();
+	variables[QLatin1String("headerType")] = tr("Type").toHtmlEscaped();
+	variables[QLatin1String("headerSize")] = tr("Size").toHtmlEscaped();
+	variables[QLatin1String("headerDate")] = tr("Date").toHtmlEscaped();
+
+	return Utils::substitutePlaceholders(listingTemplate, variables).toUtf8();
+}
+
+QByteArray ListingNetworkReply::createListingEntries(const QVector<ListingNetworkReply::ListingEntry> &entries)
+{
+	QString entriesHtml;
 
 	for (int i = 0; i < entries.count(); ++i)
 	{
 		const ListingEntry entry(entries.at(i));
+		const QString mimeTypeName(entry.mimeType.name());
+		const QString iconIdentifier(Utils::createIdentifier(QStringLiteral("%1-%2%3").arg(mimeTypeName).arg(entry.type).arg(entry.isSymlink ? QLatin1String("-link") : QString())));
 
-		if (!icons.contains(entry.mimeType.name()))
+		if (!m_styledIcons.contains(iconIdentifier))
 		{
-			QIcon icon;
-
-			switch (entry.type)
-			{
-				case ListingEntry::DirectoryType:
-					icon = iconProvider.icon(QFileIconProvider::Folder);
-
-					break;
-				case ListingEntry::DriveType:
-					icon = iconProvider.icon(QFileIconProvider::Drive);
-
-					break;
-				case ListingEntry::FileType:
-					icon = iconProvider.icon(QFileIconProvider::File);
-
-					break;
-				default:
-					break;
-			}
-
-			icon = QIcon::fromTheme(entry.mimeType.iconName(), icon);
+			m_styledIcons.insert(iconIdentifier);
 
-			if (icon.isNull())
-			{
-				switch (entry.type)
-				{
-					case ListingEntry::DriveType:
-					case ListingEntry::DirectoryType:
-						icon = ThemesManager::createIcon(QLatin1String("inode-directory"), false);
-
-						break;
-					case ListingEntry::FileType:
-						icon = ThemesManager::createIcon(QLatin1String("unknown"), false);
-
-						break;
-					default:
-						icon = ThemesManager::createIcon((entry.isSymlink ? QLatin1String("link") : QLatin1String("unknown")), false);
-
-						break;
-				}
-			}
-
-			icons[entry.mimeType.name()] = icon;
+			entriesHtml.append(QStringLiteral("<style type=\"text/css\">\ntr td:first-child.icon_%1\n{\n\tbackground-image:url(\"%2\");\n}\n</style>\n").arg(iconIdentifier).arg(getIconData(entry)));
 		}
 
 		QStringList classes;
@@ -127,47 +207,42 @@ QByteArray ListingNetworkReply::createListing(const QString &title, const QVecto
 			classes.append(QLatin1String("link"));
 		}
 
-		classes.append(QLatin1String("icon_") + Utils::createIdentifier(entry.mimeType.name()));
+		classes.append(QLatin1String("icon_") + iconIdentifier);
 
 		QHash<QString, QString> variables;
 		variables[QLatin1String("class")] = classes.join(QLatin1Char(' '));
 		variables[QLatin1String("url")] = entry.url.toString().toHtmlEscaped();
-		variables[QLatin1String("mimeType")] = entry.mimeType.name().toHtmlEscaped();
+		variables[QLatin1String("mimeType")] = mimeTypeName.toHtmlEscaped();
 		variables[QLatin1String("name")] = entry.name.toHtmlEscaped();
 		variables[QLatin1String("comment")] = entry.mimeType.comment().toHtmlEscaped();
 		variables[QLatin1String("size")] = ((entry.type == ListingEntry::FileType) ? Utils::formatUnit(entry.size, false, 2) : QString());
 		variables[QLatin1String("lastModified")] = Utils::formatDateTime(entry.timeModified).toHtmlEscaped();
 
-		entriesHtml.append(Utils::substitutePlaceholders(entryTemplate, variables));
+		entriesHtml.append(Utils::substitutePlaceholders(m_entryTemplate, variables));
 	}
 
-	QString styleHtml;
-	const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
-	QHash<QString, QIcon>::iterator iterator;
+	return entriesHtml.toUtf8();
+}
 
-	for (iterator = icons.begin(); iterator != icons.end(); ++iterator)
+QByteArray ListingNetworkReply::createListingFooter(int hiddenEntries) const
+{
+	if (hiddenEntries <= 0)
 	{
-		QByteArray byteArray;
-		QBuffer buffer(&byteArray);
-
-		iterator.value().pixmap(iconSize, iconSize).save(&buffer, "PNG");
-
-		styleHtml.append(QStringLiteral("tr td:first-child.icon_%1\n{\n\tbackground-image:url(\"data:image/png;base64,%2\");\n}\n").arg(Utils::createIdentifier(iterator.key())).arg(QString(byteArray.toBase64())));
+		return m_footerTemplate.toUtf8();
 	}
 
 	QHash<QString, QString> variables;
-	variables[QLatin1String("title")] = title.toHtmlEscaped();
-	variables[QLatin1String("description")] = tr("Directory Contents").toHtmlEscaped();
-	variables[QLatin1String("dir")] = (Application::isLeftToRight() ? QLatin1String("ltr") : QLatin1String("rtl"));
-	variables[QLatin1String("style")] = styleHtml;
-	variables[QLatin1String("navigation")] = navigationHtml;
-	variables[QLatin1String("entries")] = entriesHtml;
-	variables[QLatin1String("headerName")] = tr("Name").toHtmlEscaped();
-	variables[QLatin1String("headerType")] = tr("Type").toHtmlEscaped();
-	variables[QLatin1String("headerSize")] = tr("Size").toHtmlEscaped();
-	variables[QLatin1String("headerDate")] = tr("Date").toHtmlEscaped();
+	variables[QLatin1String("url")] = getMoreEntriesUrl().toString().toHtmlEscaped();
+	variables[QLatin1String("text")] = tr("Show More (%1 Entries Hidden)").arg(hiddenEntries).toHtmlEscaped();
 
-	return Utils::substitutePlaceholders(listingTemplate, variables).toUtf8();
+	return (Utils::substitutePlaceholders(m_moreTemplate, variables) + m_footerTemplate).toUtf8();
+}
+
+int ListingNetworkReply::getEntriesLimit() const
+{
+	const int limit(QUrlQuery(request().url()).queryItemValue(QLatin1String("limit")).toInt());
+
+	return ((limit > 0) ? limit : LISTING_ENTRIES_LIMIT);
 }
 
 }
@@ -21,6 +21,7 @@
 #define OTTER_LISTINGNETWORKREPLY_H
 
 #include <QtCore/QMimeType>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtNetwork/QNetworkReply>
 
@@ -60,7 +61,22 @@ protected:
 		bool isSymlink = false;
 	};
 
-	QByteArray createListing(const QString &title, const QVector<NavigationEntry> &navigation, const QVector<ListingEntry> &entries);
+	static void clearIconsData();
+	QString getIconData(const ListingEntry &entry) const;
+	QUrl getMoreEntriesUrl() const;
+	QByteArray createListingHeader(const QString &title, const QVector<NavigationEntry> &navigation);
+	QByteArray createListingEntries(const QVector<ListingEntry> &entries);
+	QByteArray createListingFooter(int hiddenEntries) const;
+	int getEntriesLimit() const;
+
+private:
+	QString m_entryTemplate;
+	QString m_moreTemplate;
+	QString m_footerTemplate;
+	QSet<QString> m_styledIcons;
+
+	static QHash<QString, QString> m_iconsData;
+	static bool m_isWatchingThemes;
 
 signals:
 	void listingError();
@@ -21,15 +21,20 @@
 #include "LocalListingNetworkReply.h"
 #include "Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QTimer>
 
+#define LISTING_BATCH_SIZE 250
+
 namespace Otter
 {
 
 LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent) : ListingNetworkReply(request, parent),
+	m_state(new ListingState()),
 	m_offset(0)
 {
 	setRequest(request);
@@ -64,6 +69,7 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 		setError(QNetworkReply::ContentAccessDenied, information.description.first());
 		setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
 		setHeader(QNetworkRequest::ContentLengthHeader, QVariant(m_content.size()));
+		setFinished(true);
 
 		QTimer::singleShot(0, this, [&]()
 		{
@@ -75,14 +81,10 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 		return;
 	}
 
-	QMimeDatabase mimeDatabase;
-	QVector<ListingEntry> entries;
+	const QString path(request.url().toLocalFile());
 	QVector<NavigationEntry> navigation;
 #ifdef Q_OS_WIN32
-	const bool isListingDevices(request.url().toLocalFile() == QLatin1String("/"));
-	const QFileInfoList rawEntries(isListingDevices ? QDir::drives() : directory.entryInfoList((QDir::AllEntries | QDir::Hidden), (QDir::Name | QDir::DirsFirst)));
-#else
-	const QFileInfoList rawEntries(directory.entryInfoList((QDir::AllEntries | QDir::Hidden), (QDir::Name | QDir::DirsFirst)));
+	const bool isListingDevices(path == QLatin1String("/"));
 #endif
 
 	do
@@ -112,46 +114,191 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 	navigation.prepend(entry);
 #endif
 
-	for (int i = 0; i < rawEntries.count(); ++i)
+	m_content = createListingHeader(QFileInfo(path).canonicalFilePath(), navigation);
+
+	QtConcurrent::run(&LocalListingNetworkReply::listEntries, m_state, this, path, getEntriesLimit());
+
+	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
+
+	QTimer::singleShot(0, this, [&]()
 	{
-		if (rawEntries.at(i).fileName() == QLatin1String(".") || rawEntries.at(i).fileName() == QLatin1String(".."))
+		emit readyRead();
+	});
+}
+
+LocalListingNetworkReply::~LocalListingNetworkReply()
+{
+	abort();
+}
+
+void LocalListingNetworkReply::listEntries(QSharedPointer<ListingState> state, LocalListingNetworkReply *reply, const QString &path, int limit)
+{
+	QMimeDatabase mimeDatabase;
+	QVector<ListingEntry> entries;
+	entries.reserve(LISTING_BATCH_SIZE);
+
+	const auto sortEntries([&]()
+	{
+		std::sort(entries.begin(), entries.end(), [&](const ListingEntry &first, const ListingEntry &second)
 		{
+			const bool isFirstFile(first.type == ListingEntry::FileType);
+
+			if (isFirstFile != (second.type == ListingEntry::FileType))
+			{
+				return !isFirstFile;
+			}
+
+			return (first.name < second.name);
+		});
+	});
+#ifdef Q_OS_WIN32
+	const bool isListingDevices(path == QLatin1String("/"));
+	const QFileInfoList drives(isListingDevices ? QDir::drives() : QFileInfoList());
+	int driveIndex(0);
+#endif
+	QDirIterator iterator(path, (QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot));
+	int amount(0);
+	int hiddenEntries(0);
+
+	while (true)
+	{
+		QFileInfo fileInfo;
+#ifdef Q_OS_WIN32
+		if (isListingDevices)
+		{
+			if (driveIndex >= drives.count())
+			{
+				break;
+			}
+
+			fileInfo = drives.at(driveIndex);
+
+			++driveIndex;
+		}
+		else
+#endif
+		if (iterator.hasNext())
+		{
+			iterator.next();
+
+			fileInfo = iterator.fileInfo();
+		}
+		else
+		{
+			break;
+		}
+
+		state->mutex.lock();
+
+		const bool isAborted(state->isAborted);
+
+		state->mutex.unlock();
+
+		if (isAborted)
+		{
+			return;
+		}
+
+		if (amount >= limit)
+		{
+			++hiddenEntries;
+
 			continue;
 		}
 
 		ListingEntry entry;
-		entry.name = rawEntries.at(i).fileName();
-		entry.url = QUrl::fromUserInput(rawEntries.at(i).filePath());
-		entry.timeModified = rawEntries.at(i).lastModified();
-		entry.mimeType = mimeDatabase.mimeTypeForFile(rawEntries.at(i).filePath());
-		entry.type = (rawEntries.at(i).isRoot() ? ListingEntry::DriveType : (rawEntries.at(i).isDir() ? ListingEntry::DirectoryType : ListingEntry::FileType));
-		entry.size = rawEntries.at(i).size();
-		entry.isSymlink = rawEntries.at(i).isSymLink();
+		entry.name = fileInfo.fileName();
+		entry.url = QUrl::fromUserInput(fileInfo.filePath());
+		entry.timeModified = fileInfo.lastModified();
+		entry.mimeType = mimeDatabase.mimeTypeForFile(fileInfo.filePath());
+		entry.type = (fileInfo.isRoot() ? ListingEntry::DriveType : (fileInfo.isDir() ? ListingEntry::DirectoryType : ListingEntry::FileType));
+		entry.size = fileInfo.size();
+		entry.isSymlink = fileInfo.isSymLink();
 
 #ifdef Q_OS_WIN32
 		if (isListingDevices)
 		{
-			entry.name = rawEntries.at(i).filePath().remove(QLatin1Char('/'));
+			entry.name = fileInfo.filePath().remove(QLatin1Char('/'));
 		}
 #endif
 
 		entries.append(entry);
+
+		++amount;
+
+		if (entries.count() >= LISTING_BATCH_SIZE)
+		{
+			sortEntries();
+
+			QMutexLocker locker(&state->mutex);
+
+			if (state->isAborted)
+			{
+				return;
+			}
+
+			state->pendingEntries.append(entries);
+
+			entries.clear();
+
+			QMetaObject::invokeMethod(reply, "processEntries", Qt::QueuedConnection);
+		}
 	}
 
-	m_content = createListing(QFileInfo(request.url().toLocalFile()).canonicalFilePath(), navigation, entries);
+	sortEntries();
 
-	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
-	setHeader(QNetworkRequest::ContentLengthHeader, QVariant(m_content.size()));
+	QMutexLocker locker(&state->mutex);
 
-	QTimer::singleShot(0, this, [&]()
+	if (state->isAborted)
+	{
+		return;
+	}
+
+	state->pendingEntries.append(entries);
+	state->hiddenEntries = hiddenEntries;
+	state->isListingFinished = true;
+
+	QMetaObject::invokeMethod(reply, "processEntries", Qt::QueuedConnection);
+}
+
+void LocalListingNetworkReply::processEntries()
+{
+	m_state->mutex.lock();
+
+	const QVector<ListingEntry> entries(m_state->pendingEntries);
+	const int hiddenEntries(m_state->hiddenEntries);
+	const bool isListingFinished(m_state->isListingFinished);
+
+	m_state->pendingEntries.clear();
+	m_state->isListingFinished = false;
+
+	m_state->mutex.unlock();
+
+	if (!entries.isEmpty())
+	{
+		m_content.append(createListingEntries(entries));
+	}
+
+	if (isListingFinished)
 	{
+		m_content.append(createListingFooter(hiddenEntries));
+
+		setFinished(true);
+
 		emit readyRead();
 		emit finished();
-	});
+	}
+	else if (!entries.isEmpty())
+	{
+		emit readyRead();
+	}
 }
 
 void LocalListingNetworkReply::abort()
 {
+	m_state->mutex.lock();
+	m_state->isAborted = true;
+	m_state->mutex.unlock();
 }
 
 qint64 LocalListingNetworkReply::bytesAvailable() const
@@ -169,10 +316,17 @@ qint64 LocalListingNetworkReply::readData(char *data, qint64 maxSize)
 
 		m_offset += number;
 
+		if (m_offset == m_content.size())
+		{
+			m_content.clear();
+
+			m_offset = 0;
+		}
+
 		return number;
 	}
 
-	return -1;
+	return (isFinished() ? -1 : 0);
 }
 
 bool LocalListingNetworkReply::isSequential() const
@@ -23,6 +23,9 @@
 
 #include "ListingNetworkReply.h"
 
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+
 namespace Otter
 {
 
@@ -32,6 +35,7 @@ class LocalListingNetworkReply final : public ListingNetworkReply
 
 public:
 	explicit LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent);
+	~LocalListingNetworkReply();
 
 	qint64 bytesAvailable() const override;
 	qint64 readData(char *data, qint64 maxSize) override;
@@ -40,8 +44,24 @@ public:
 public slots:
 	void abort() override;
 
+protected:
+	struct ListingState final
+	{
+		QVector<ListingEntry> pendingEntries;
+		QMutex mutex;
+		int hiddenEntries = 0;
+		bool isAborted = false;
+		bool isListingFinished = false;
+	};
+
+	static void listEntries(QSharedPointer<ListingState> state, LocalListingNetworkReply *reply, const QString &path, int limit);
+
+protected slots:
+	void processEntries();
+
 private:
 	QByteArray m_content;
+	QSharedPointer<ListingState> m_state;
 	qint64 m_offset;
 
 signals:
@@ -333,6 +333,7 @@ void NetworkAutomaticProxy::setPath(const QString &path)
 		if (url.isValid())
 		{
 			DataFetchJob *job(new DataFetchJob(url, this));
+			job->setPriority(FetchJob::UserPriority);
 
 			connect(job, &Job::jobFinished, this, [=](bool isSuccess)
 			{
@@ -176,37 +176,27 @@ QNetworkReply* NetworkManager::createRequest(QNetworkAccessManager::Operation op
 
 NetworkManager::ResourceType NetworkManager::getResourceType(const QNetworkRequest &request, const QUrl &firstPartyUrl)
 {
-	if (request.url() == firstPartyUrl)
-	{
-		return MainFrameType;
-	}
+	const QUrl url(request.url());
 
-	const QString path(request.url().path());
-	const QByteArray acceptHeader(request.rawHeader(QByteArrayLiteral("Accept")));
-
-	if (acceptHeader.contains(QByteArrayLiteral("text/html")) || acceptHeader.contains(QByteArrayLiteral("application/xhtml+xml")) || acceptHeader.contains(QByteArrayLiteral("application/xml")) || path.endsWith(QLatin1String(".htm")) || path.endsWith(QLatin1String(".html")))
+	if (url == firstPartyUrl)
 	{
-		return SubFrameType;
-	}
-
-	if (acceptHeader.contains(QByteArrayLiteral("image/")) || path.endsWith(QLatin1String(".png")) || path.endsWith(QLatin1String(".jpg")) || path.endsWith(QLatin1String(".gif")))
-	{
-		return ImageType;
+		return MainFrameType;
 	}
 
-	if (acceptHeader.contains(QByteArrayLiteral("script/")) || path.endsWith(QLatin1String(".js")))
-	{
-		return ScriptType;
-	}
+	const ResourceType acceptType(getAcceptResourceType(request.rawHeader(QByteArrayLiteral("Accept"))));
+	const ResourceType pathType(getPathResourceType(url.path()));
 
-	if (acceptHeader.contains(QByteArrayLiteral("text/css")) || path.endsWith(QLatin1String(".css")))
+	if (acceptType != OtherType || pathType != OtherType)
 	{
-		return StyleSheetType;
-	}
+		const ResourceType priorities[] = {SubFrameType, ImageType, ScriptType, StyleSheetType, ObjectType};
 
-	if (acceptHeader.contains(QByteArrayLiteral("object")))
-	{
-		return ObjectType;
+		for (const ResourceType type: priorities)
+		{
+			if (acceptType == type || pathType == type)
+			{
+				return type;
+			}
+		}
 	}
 
 	if (request.rawHeader(QByteArrayLiteral("X-Requested-With")) == QByteArrayLiteral("XMLHttpRequest"))
@@ -223,3 +213,5 @@ NetworkManager::ResourceType NetworkManager::getResourceType(const QNetworkReque
 }
 
 }
+
+}
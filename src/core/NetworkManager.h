@@ -22,6 +22,9 @@
 #ifndef OTTER_NETWORKMANAGER_H
 #define OTTER_NETWORKMANAGER_H
 
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QThreadStorage>
 #include <QtCore/QUrl>
 #include <QtNetwork/QNetworkAccessManager>
 
@@ -65,10 +68,30 @@ public:
 		ResourceType resourceType = OtherType;
 	};
 
+	struct RequestTimingInformation final
+	{
+		QUrl url;
+		QString method;
+		QString mimeType;
+		QDateTime startDateTime;
+		ResourceType resourceType = OtherType;
+		qint64 queuedTime = 0;
+		qint64 contentBlockingDuration = -1;
+		qint64 proxyResolutionDuration = -1;
+		qint64 firstByteTime = -1;
+		qint64 finishedTime = -1;
+		qint64 bytesReceived = 0;
+		int statusCode = 0;
+		bool isCached = false;
+		bool isBlocked = false;
+	};
+
 	explicit NetworkManager(bool isPrivate = false, QObject *parent = nullptr);
 
 	CookieJar* getCookieJar() const;
 	static ResourceType getResourceType(const QNetworkRequest &request, const QUrl &firstPartyUrl = {});
+	static ResourceType getAcceptResourceType(const QByteArray &acceptHeader);
+	static ResourceType getPathResourceType(const QString &path);
 
 protected:
 	QNetworkReply* createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData) override;
@@ -82,6 +105,8 @@ protected slots:
 private:
 	CookieJar *m_cookieJar;
 
+	static QThreadStorage<QHash<QByteArray, ResourceType> > m_acceptResourceTypes;
+
 friend class NetworkManagerFactory;
 };
 
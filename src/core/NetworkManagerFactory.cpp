@@ -639,11 +639,16 @@ CookieJar* NetworkManagerFactory::getCookieJar()
 
 QNetworkReply* NetworkManagerFactory::createRequest(const QUrl &url, QNetworkAccessManager::Operation operation, bool isPrivate, QIODevice *outgoingData)
 {
-	QNetworkRequest request(url);
-	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
-	request.setHeader(QNetworkRequest::UserAgentHeader, getUserAgent());
+	return createRequest(QNetworkRequest(url), operation, isPrivate, outgoingData);
+}
+
+QNetworkReply* NetworkManagerFactory::createRequest(const QNetworkRequest &request, QNetworkAccessManager::Operation operation, bool isPrivate, QIODevice *outgoingData)
+{
+	QNetworkRequest mutableRequest(request);
+	mutableRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+	mutableRequest.setHeader(QNetworkRequest::UserAgentHeader, getUserAgent());
 
-	return getNetworkManager(isPrivate)->createRequest(operation, request, outgoingData);
+	return getNetworkManager(isPrivate)->createRequest(operation, mutableRequest, outgoingData);
 }
 
 QString NetworkManagerFactory::getAcceptLanguage()
@@ -0,0 +1,134 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "NetworkManager.h"
+
+#define ACCEPT_RESOURCE_TYPES_LIMIT 100
+
+namespace Otter
+{
+
+QThreadStorage<QHash<QByteArray, NetworkManager::ResourceType> > NetworkManager::m_acceptResourceTypes;
+
+NetworkManager::ResourceType NetworkManager::getAcceptResourceType(const QByteArray &acceptHeader)
+{
+	if (acceptHeader.isEmpty())
+	{
+		return OtherType;
+	}
+
+	QHash<QByteArray, ResourceType> &acceptResourceTypes(m_acceptResourceTypes.localData());
+	const QHash<QByteArray, ResourceType>::const_iterator iterator(acceptResourceTypes.constFind(acceptHeader));
+
+	if (iterator != acceptResourceTypes.constEnd())
+	{
+		return iterator.value();
+	}
+
+	ResourceType type(OtherType);
+
+	if (acceptHeader.contains(QByteArrayLiteral("text/html")) || acceptHeader.contains(QByteArrayLiteral("application/xhtml+xml")) || acceptHeader.contains(QByteArrayLiteral("application/xml")))
+	{
+		type = SubFrameType;
+	}
+	else if (acceptHeader.contains(QByteArrayLiteral("image/")))
+	{
+		type = ImageType;
+	}
+	else if (acceptHeader.contains(QByteArrayLiteral("script/")))
+	{
+		type = ScriptType;
+	}
+	else if (acceptHeader.contains(QByteArrayLiteral("text/css")))
+	{
+		type = StyleSheetType;
+	}
+	else if (acceptHeader.contains(QByteArrayLiteral("object")))
+	{
+		type = ObjectType;
+	}
+
+	if (acceptResourceTypes.count() >= ACCEPT_RESOURCE_TYPES_LIMIT)
+	{
+		acceptResourceTypes.clear();
+	}
+
+	acceptResourceTypes[acceptHeader] = type;
+
+	return type;
+}
+
+NetworkManager::ResourceType NetworkManager::getPathResourceType(const QString &path)
+{
+	const int dotPosition(path.lastIndexOf(QLatin1Char('.')));
+
+	if (dotPosition < 0 || (path.length() - dotPosition) < 3 || (path.length() - dotPosition) > 5)
+	{
+		return OtherType;
+	}
+
+	const QStringRef extension(path.midRef(dotPosition + 1));
+	QLatin1String candidate("");
+	ResourceType type(OtherType);
+
+	switch ((extension.length() << 8) | extension.at(0).unicode())
+	{
+		case ((2 << 8) | 'j'):
+			candidate = QLatin1String("js");
+			type = ScriptType;
+
+			break;
+		case ((3 << 8) | 'c'):
+			candidate = QLatin1String("css");
+			type = StyleSheetType;
+
+			break;
+		case ((3 << 8) | 'g'):
+			candidate = QLatin1String("gif");
+			type = ImageType;
+
+			break;
+		case ((3 << 8) | 'h'):
+			candidate = QLatin1String("htm");
+			type = SubFrameType;
+
+			break;
+		case ((3 << 8) | 'j'):
+			candidate = QLatin1String("jpg");
+			type = ImageType;
+
+			break;
+		case ((3 << 8) | 'p'):
+			candidate = QLatin1String("png");
+			type = ImageType;
+
+			break;
+		case ((4 << 8) | 'h'):
+			candidate = QLatin1String("html");
+			type = SubFrameType;
+
+			break;
+		default:
+			return OtherType;
+	}
+
+	return ((extension == candidate) ? type : OtherType);
+}
+
+}
@@ -21,6 +21,8 @@
 #include "NetworkProxyFactory.h"
 #include "NetworkAutomaticProxy.h"
 
+#include <QtCore/QElapsedTimer>
+
 namespace Otter
 {
 
@@ -87,6 +89,27 @@ void NetworkProxyFactory::setProxy(const QString &identifier)
 }
 
 QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &query)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	const QList<QNetworkProxy> proxies(resolveProxy(query));
+
+	m_queryDurationsMutex.lock();
+
+	if (m_queryDurations.count() > 1000)
+	{
+		m_queryDurations.clear();
+	}
+
+	m_queryDurations[query.url()] = timer.nsecsElapsed();
+
+	m_queryDurationsMutex.unlock();
+
+	return proxies;
+}
+
+QList<QNetworkProxy> NetworkProxyFactory::resolveProxy(const QNetworkProxyQuery &query)
 {
 	switch (m_definition.type)
 	{
@@ -173,6 +196,18 @@ QNetworkProxy::ProxyType NetworkProxyFactory::getProxyType(ProxyDefinition::Prot
 	return QNetworkProxy::DefaultProxy;
 }
 
+qint64 NetworkProxyFactory::takeQueryDuration(const QUrl &url)
+{
+	m_queryDurationsMutex.lock();
+
+	const qint64 duration(m_queryDurations.value(url, -1));
+
+	m_queryDurations.remove(url);
+	m_queryDurationsMutex.unlock();
+
+	return duration;
+}
+
 bool NetworkProxyFactory::usesSystemAuthentication()
 {
 	return m_definition.usesSystemAuthentication;
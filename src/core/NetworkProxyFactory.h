@@ -23,6 +23,7 @@
 
 #include "NetworkManagerFactory.h"
 
+#include <QtCore/QMutex>
 #include <QtNetwork/QNetworkProxy>
 
 namespace Otter
@@ -40,15 +41,19 @@ public:
 
 	void setProxy(const QString &identifier);
 	QList<QNetworkProxy> queryProxy(const QNetworkProxyQuery &query) override;
+	qint64 takeQueryDuration(const QUrl &url);
 	bool usesSystemAuthentication();
 
 protected:
+	QList<QNetworkProxy> resolveProxy(const QNetworkProxyQuery &query);
 	QNetworkProxy::ProxyType getProxyType(ProxyDefinition::ProtocolType protocol);
 
 private:
 	NetworkAutomaticProxy *m_automaticProxy;
 	ProxyDefinition m_definition;
+	QMutex m_queryDurationsMutex;
 	QMap<int, QList<QNetworkProxy> > m_proxies;
+	QHash<QUrl, qint64> m_queryDurations;
 };
 
 }
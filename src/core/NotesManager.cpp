@@ -64,18 +64,33 @@ void NotesManager::scheduleSave()
 	}
 }
 
+void NotesManager::handleSaveFinished(const QString &path, bool isSuccess)
+{
+	Q_UNUSED(path)
+
+	if (!isSuccess && m_saveTimer == 0)
+	{
+		m_saveTimer = startTimer(30000);
+	}
+}
+
 NotesManager* NotesManager::getInstance()
 {
+	createInstance();
+
 	return m_instance;
 }
 
 BookmarksModel* NotesManager::getModel()
 {
-	if (!m_model && m_instance)
+	createInstance();
+
+	if (!m_model)
 	{
 		m_model = new BookmarksModel(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")), BookmarksModel::NotesMode, m_instance);
 
 		connect(m_model, &BookmarksModel::modelModified, m_instance, &NotesManager::scheduleSave);
+		connect(m_model, &BookmarksModel::saveFinished, m_instance, &NotesManager::handleSaveFinished);
 	}
 
 	return m_model;
@@ -44,6 +44,7 @@ protected:
 
 protected slots:
 	void scheduleSave();
+	void handleSaveFinished(const QString &path, bool isSuccess);
 
 private:
 	int m_saveTimer;
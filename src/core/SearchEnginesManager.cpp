@@ -21,8 +21,10 @@
 #include "ItemModel.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "StartupManager.h"
 #include "ThemesManager.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QXmlStreamReader>
@@ -77,18 +79,27 @@ void SearchEnginesManager::loadSearchEngines()
 
 	for (int i = 0; i < searchEnginesOrder.count(); ++i)
 	{
-		QFile file(SessionsManager::getReadableDataPath(QLatin1String("searchEngines/") + searchEnginesOrder.at(i) + QLatin1String(".xml")));
+		const QString path(SessionsManager::getReadableDataPath(QLatin1String("searchEngines/") + searchEnginesOrder.at(i) + QLatin1String(".xml")));
+		QByteArray data;
+		QBuffer buffer(&data);
+		QFile file(path);
+		QIODevice *device(&file);
 
-		if (!file.open(QIODevice::ReadOnly))
+		if (StartupManager::takePreloadedFile(path, &data))
+		{
+			device = &buffer;
+		}
+
+		if (!device->open(QIODevice::ReadOnly))
 		{
 			m_searchEnginesOrder.removeAll(searchEnginesOrder.at(i));
 
 			continue;
 		}
 
-		const SearchEngineDefinition searchEngine(loadSearchEngine(&file, searchEnginesOrder.at(i), true));
+		const SearchEngineDefinition searchEngine(loadSearchEngine(device, searchEnginesOrder.at(i), true));
 
-		file.close();
+		device->close();
 
 		if (searchEngine.isValid())
 		{
@@ -637,6 +648,8 @@ SearchEngineFetchJob::SearchEngineFetchJob(const QUrl &url, const QString &ident
 	m_needsToSaveSearchEngine(saveSearchEngine)
 {
 	m_searchEngine.identifier = identifier;
+
+	setPriority(UserPriority);
 }
 
 SearchEnginesManager::SearchEngineDefinition SearchEngineFetchJob::getSearchEngine() const
@@ -644,14 +657,14 @@ SearchEnginesManager::SearchEngineDefinition SearchEngineFetchJob::getSearchEngi
 	return m_searchEngine;
 }
 
-void SearchEngineFetchJob::handleSuccessfulReply(QNetworkReply *reply)
+void SearchEngineFetchJob::handleSuccessfulReply(QIODevice *device)
 {
 	if (m_searchEngine.identifier.isEmpty())
 	{
 		m_searchEngine.identifier = m_searchEngine.createIdentifier();
 	}
 
-	m_searchEngine = SearchEnginesManager::loadSearchEngine(reply, m_searchEngine.identifier);
+	m_searchEngine = SearchEnginesManager::loadSearchEngine(device, m_searchEngine.identifier);
 
 	if (!m_searchEngine.isValid())
 	{
@@ -662,12 +675,13 @@ void SearchEngineFetchJob::handleSuccessfulReply(QNetworkReply *reply)
 
 	if (m_searchEngine.selfUrl.isEmpty())
 	{
-		m_searchEngine.selfUrl = reply->request().url();
+		m_searchEngine.selfUrl = getUrl();
 	}
 
 	if (m_searchEngine.iconUrl.isValid())
 	{
 		IconFetchJob *job(new IconFetchJob(m_searchEngine.iconUrl, this));
+		job->setPriority(UserPriority);
 
 		connect(job, &IconFetchJob::jobFinished, this, [=]()
 		{
@@ -123,7 +123,7 @@ public:
 	SearchEnginesManager::SearchEngineDefinition getSearchEngine() const;
 
 protected:
-	void handleSuccessfulReply(QNetworkReply *reply) override;
+	void handleSuccessfulReply(QIODevice *device) override;
 
 private:
 	SearchEnginesManager::SearchEngineDefinition m_searchEngine;
@@ -17,7 +17,6 @@
 * along with this program. If not, see <http://www.gnu.org/licenses/>.
 *
 **************************************************************************/
-
 #include "SearchSuggester.h"
 #include "NetworkManager.h"
 #include "NetworkManagerFactory.h"
@@ -25,67 +24,218 @@
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimerEvent>
 
 namespace Otter
 {
 
+QCache<QString, QVector<SearchSuggester::SearchSuggestion> > SearchSuggester::m_cache(500);
+QHash<QString, SearchSuggester::PendingRequest> SearchSuggester::m_pendingRequests;
+SearchSuggester::SuggestionsStatistics SearchSuggester::m_statistics;
+
 SearchSuggester::SearchSuggester(const QString &searchEngine, QObject *parent) : QObject(parent),
-	m_networkReply(nullptr),
 	m_model(nullptr),
-	m_searchEngine(searchEngine)
+	m_searchEngine(searchEngine),
+	m_requestTimer(0),
+	m_keystrokeInterval(150)
+{
+	connect(SearchEnginesManager::getInstance(), &SearchEnginesManager::searchEnginesModified, this, &SearchSuggester::clearCache);
+}
+
+SearchSuggester::~SearchSuggester()
 {
+	detachRequest();
 }
 
-void SearchSuggester::handleReplyFinished()
+void SearchSuggester::timerEvent(QTimerEvent *event)
 {
-	if (!m_networkReply)
+	if (event->timerId() == m_requestTimer)
 	{
+		killTimer(m_requestTimer);
+
+		m_requestTimer = 0;
+
+		sendRequest();
+	}
+}
+
+void SearchSuggester::clearCache()
+{
+	m_cache.clear();
+}
+
+void SearchSuggester::sendRequest()
+{
+	const QString key(createCacheKey(m_searchEngine, m_query));
+
+	if (m_cache.contains(key))
+	{
+		updateFromCache();
+
 		return;
 	}
 
-	if (m_model)
+	m_requestKey = key;
+
+	if (m_pendingRequests.contains(key))
 	{
-		m_model->clear();
+		m_pendingRequests[key].suggesters.append(this);
+
+		++m_statistics.coalescedRequestsAmount;
+
+		return;
 	}
 
-	m_networkReply->deleteLater();
+	const SearchEnginesManager::SearchEngineDefinition searchEngine(SearchEnginesManager::getSearchEngine(m_searchEngine));
+
+	if (!searchEngine.isValid() || searchEngine.suggestionsUrl.url.isEmpty())
+	{
+		m_requestKey.clear();
+
+		return;
+	}
+
+	QNetworkRequest request;
+	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+
+	QNetworkAccessManager::Operation method;
+	QByteArray body;
+
+	SearchEnginesManager::setupQuery(m_query, searchEngine.suggestionsUrl, &request, &method, &body);
+
+	PendingRequest pendingRequest;
+	pendingRequest.reply = ((method == QNetworkAccessManager::PostOperation) ? NetworkManagerFactory::getNetworkManager()->post(request, body) : NetworkManagerFactory::getNetworkManager()->get(request));
+	pendingRequest.suggesters.append(this);
+	pendingRequest.query = m_query;
+	pendingRequest.timer.start();
+
+	m_pendingRequests[key] = pendingRequest;
+
+	++m_statistics.requestsAmount;
+
+	connect(pendingRequest.reply, &QNetworkReply::finished, pendingRequest.reply, [=]()
+	{
+		handleRequestFinished(key);
+	});
+}
 
-	if (m_networkReply->size() <= 0)
+void SearchSuggester::detachRequest()
+{
+	if (m_requestTimer != 0)
 	{
-		m_networkReply = nullptr;
+		killTimer(m_requestTimer);
+
+		m_requestTimer = 0;
+	}
 
+	if (m_requestKey.isEmpty())
+	{
 		return;
 	}
 
-	const QJsonDocument document(QJsonDocument::fromJson(m_networkReply->readAll()));
+	const QString key(m_requestKey);
+
+	m_requestKey.clear();
 
-	if (!document.isEmpty() && document.isArray() && document.array().count() > 1 && document.array().at(0).toString() == m_query)
+	if (!m_pendingRequests.contains(key))
 	{
-		const QJsonArray completionsArray(document.array().at(1).toArray());
-		const QJsonArray descriptionsArray(document.array().at(2).toArray());
-		const QJsonArray urlsArray(document.array().at(3).toArray());
+		return;
+	}
 
-		m_suggestions.reserve(completionsArray.count());
+	PendingRequest &request(m_pendingRequests[key]);
 
-		for (int i = 0; i < completionsArray.count(); ++i)
+	for (int i = (request.suggesters.count() - 1); i >= 0; --i)
+	{
+		if (!request.suggesters.at(i) || request.suggesters.at(i).data() == this)
 		{
-			SearchSuggestion suggestion;
-			suggestion.completion = completionsArray.at(i).toString();
-			suggestion.description = descriptionsArray.at(i).toString();
-			suggestion.url = urlsArray.at(i).toString();
+			request.suggesters.removeAt(i);
+		}
+	}
 
-			m_suggestions.append(suggestion);
+	if (!request.suggesters.isEmpty())
+	{
+		return;
+	}
 
-			if (m_model)
-			{
-				m_model->appendRow(new QStandardItem(suggestion.completion));
-			}
+	QNetworkReply *reply(m_pendingRequests.take(key).reply);
+
+	++m_statistics.abortedRequestsAmount;
+
+	reply->disconnect();
+	reply->abort();
+	reply->deleteLater();
+}
+
+void SearchSuggester::updateSuggestions(const QVector<SearchSuggestion> &suggestions)
+{
+	m_suggestions = suggestions;
+
+	if (m_model)
+	{
+		m_model->clear();
+
+		for (int i = 0; i < m_suggestions.count(); ++i)
+		{
+			m_model->appendRow(new QStandardItem(m_suggestions.at(i).completion));
 		}
+	}
+
+	emit suggestionsChanged(m_suggestions);
+}
+
+void SearchSuggester::handleRequestFinished(const QString &key)
+{
+	if (!m_pendingRequests.contains(key))
+	{
+		return;
+	}
+
+	const PendingRequest request(m_pendingRequests.take(key));
+
+	request.reply->deleteLater();
+
+	if (request.reply->error() != QNetworkReply::NoError)
+	{
+		return;
+	}
+
+	if (m_statistics.latencyLimits.isEmpty())
+	{
+		m_statistics.latencyLimits = {50, 100, 200, 500, 1000, 2000, 5000};
+		m_statistics.latencyCounts.fill(0, (m_statistics.latencyLimits.count() + 1));
+	}
+
+	const qint64 latency(request.timer.elapsed());
+	int bucket(0);
 
-		emit suggestionsChanged(m_suggestions);
+	while (bucket < m_statistics.latencyLimits.count() && latency > m_statistics.latencyLimits.at(bucket))
+	{
+		++bucket;
 	}
 
-	m_networkReply = nullptr;
+	++m_statistics.latencyCounts[bucket];
+
+	bool isValid(false);
+	const QVector<SearchSuggestion> suggestions(parseSuggestions(request.reply->readAll(), request.query, &isValid));
+
+	if (!isValid)
+	{
+		return;
+	}
+
+	m_cache.insert(key, new QVector<SearchSuggestion>(suggestions));
+
+	for (int i = 0; i < request.suggesters.count(); ++i)
+	{
+		SearchSuggester *suggester(request.suggesters.at(i).data());
+
+		if (suggester && suggester->m_requestKey == key)
+		{
+			suggester->m_requestKey.clear();
+			suggester->updateSuggestions(suggestions);
+		}
+	}
 }
 
 void SearchSuggester::setSearchEngine(const QString &searchEngine)
@@ -105,41 +255,38 @@ void SearchSuggester::setQuery(const QString &query)
 		return;
 	}
 
-	m_query = query;
-	m_suggestions.clear();
-
-	if (m_networkReply)
+	if (m_keystrokeTimer.isValid())
 	{
-		m_networkReply->abort();
-		m_networkReply->deleteLater();
-		m_networkReply = nullptr;
+		m_keystrokeInterval = static_cast<int>(((m_keystrokeInterval * 3) + qMin(m_keystrokeTimer.elapsed(), qint64(1000))) / 4);
 	}
 
-	const SearchEnginesManager::SearchEngineDefinition searchEngine(SearchEnginesManager::getSearchEngine(m_searchEngine));
+	m_keystrokeTimer.start();
 
-	if (!searchEngine.isValid() || searchEngine.suggestionsUrl.url.isEmpty())
-	{
-		return;
-	}
+	m_query = query;
 
-	QNetworkRequest request;
-	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+	detachRequest();
 
-	QNetworkAccessManager::Operation method;
-	QByteArray body;
+	if (query.isEmpty())
+	{
+		m_suggestions.clear();
 
-	SearchEnginesManager::setupQuery(query, searchEngine.suggestionsUrl, &request, &method, &body);
+		if (m_model)
+		{
+			m_model->clear();
+		}
 
-	if (method == QNetworkAccessManager::PostOperation)
-	{
-		m_networkReply = NetworkManagerFactory::getNetworkManager()->post(request, body);
+		return;
 	}
-	else
+
+	if (!updateFromCache())
 	{
-		m_networkReply = NetworkManagerFactory::getNetworkManager()->get(request);
+		m_requestTimer = startTimer(qBound(50, ((m_keystrokeInterval * 3) / 2), 400));
 	}
+}
 
-	connect(m_networkReply, &QNetworkReply::finished, this, &SearchSuggester::handleReplyFinished);
+QString SearchSuggester::createCacheKey(const QString &searchEngine, const QString &query)
+{
+	return searchEngine + QLatin1Char('\n') + query;
 }
 
 QStandardItemModel* SearchSuggester::getModel()
@@ -162,4 +309,121 @@ QVector<SearchSuggester::SearchSuggestion> SearchSuggester::getSuggestions() con
 	return m_suggestions;
 }
 
+QVector<SearchSuggester::SearchSuggestion> SearchSuggester::parseSuggestions(const QByteArray &data, const QString &query, bool *isValid)
+{
+	const QJsonDocument document(QJsonDocument::fromJson(data));
+	QVector<SearchSuggestion> suggestions;
+
+	*isValid = (!document.isEmpty() && document.isArray() && document.array().count() > 1 && document.array().at(0).toString() == query);
+
+	if (!*isValid)
+	{
+		return suggestions;
+	}
+
+	const QJsonArray completionsArray(document.array().at(1).toArray());
+	const QJsonArray descriptionsArray(document.array().at(2).toArray());
+	const QJsonArray urlsArray(document.array().at(3).toArray());
+
+	suggestions.reserve(completionsArray.count());
+
+	for (int i = 0; i < completionsArray.count(); ++i)
+	{
+		SearchSuggestion suggestion;
+		suggestion.completion = completionsArray.at(i).toString();
+		suggestion.description = descriptionsArray.at(i).toString();
+		suggestion.url = urlsArray.at(i).toString();
+
+		suggestions.append(suggestion);
+	}
+
+	return suggestions;
+}
+
+QString SearchSuggester::createReport()
+{
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignLeft);
+	stream << QLatin1String("Search Suggestions:\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Requests");
+	stream << m_statistics.requestsAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Coalesced Requests");
+	stream << m_statistics.coalescedRequestsAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Aborted Requests");
+	stream << m_statistics.abortedRequestsAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Cache Hits");
+	stream << m_statistics.cacheHitsAmount;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n");
+
+	for (int i = 0; i < m_statistics.latencyCounts.count(); ++i)
+	{
+		stream << QLatin1String("\t");
+		stream.setFieldWidth(30);
+		stream << ((i < m_statistics.latencyLimits.count()) ? QStringLiteral("Latency <= %1 ms").arg(m_statistics.latencyLimits.at(i)) : QStringLiteral("Latency > %1 ms").arg(m_statistics.latencyLimits.last()));
+		stream << m_statistics.latencyCounts.at(i);
+		stream.setFieldWidth(0);
+		stream << QLatin1String("\n");
+	}
+
+	stream << QLatin1String("\n");
+
+	return report;
+}
+
+bool SearchSuggester::updateFromCache()
+{
+	const QString key(createCacheKey(m_searchEngine, m_query));
+
+	if (m_cache.contains(key))
+	{
+		++m_statistics.cacheHitsAmount;
+
+		detachRequest();
+		updateSuggestions(*m_cache.object(key));
+
+		return true;
+	}
+
+	for (int i = (m_query.length() - 1); i > 0; --i)
+	{
+		const QVector<SearchSuggestion> *cachedSuggestions(m_cache.object(createCacheKey(m_searchEngine, m_query.left(i))));
+
+		if (!cachedSuggestions)
+		{
+			continue;
+		}
+
+		QVector<SearchSuggestion> suggestions;
+
+		for (int j = 0; j < cachedSuggestions->count(); ++j)
+		{
+			if (cachedSuggestions->at(j).completion.startsWith(m_query, Qt::CaseInsensitive))
+			{
+				suggestions.append(cachedSuggestions->at(j));
+			}
+		}
+
+		if (!suggestions.isEmpty())
+		{
+			updateSuggestions(suggestions);
+		}
+
+		break;
+	}
+
+	return false;
+}
+
 }
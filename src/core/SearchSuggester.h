@@ -21,7 +21,10 @@
 #ifndef OTTER_SEARCHSUGGESTER_H
 #define OTTER_SEARCHSUGGESTER_H
 
+#include <QtCore/QCache>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtGui/QStandardItemModel>
 #include <QtNetwork/QNetworkReply>
 
@@ -41,7 +44,10 @@ public:
 	};
 
 	explicit SearchSuggester(const QString &searchEngine, QObject *parent = nullptr);
+	~SearchSuggester();
 
+	static void clearCache();
+	static QString createReport();
 	QStandardItemModel* getModel();
 	QVector<SearchSuggestion> getSuggestions() const;
 
@@ -49,15 +55,47 @@ public slots:
 	void setSearchEngine(const QString &searchEngine);
 	void setQuery(const QString &query);
 
-protected slots:
-	void handleReplyFinished();
+protected:
+	struct PendingRequest final
+	{
+		QNetworkReply *reply = nullptr;
+		QVector<QPointer<SearchSuggester> > suggesters;
+		QString query;
+		QElapsedTimer timer;
+	};
+
+	struct SuggestionsStatistics final
+	{
+		QVector<int> latencyLimits;
+		QVector<int> latencyCounts;
+		int requestsAmount = 0;
+		int coalescedRequestsAmount = 0;
+		int abortedRequestsAmount = 0;
+		int cacheHitsAmount = 0;
+	};
+
+	void timerEvent(QTimerEvent *event) override;
+	void sendRequest();
+	void detachRequest();
+	void updateSuggestions(const QVector<SearchSuggestion> &suggestions);
+	static void handleRequestFinished(const QString &key);
+	static QString createCacheKey(const QString &searchEngine, const QString &query);
+	static QVector<SearchSuggestion> parseSuggestions(const QByteArray &data, const QString &query, bool *isValid);
+	bool updateFromCache();
 
 private:
-	QNetworkReply *m_networkReply;
 	QStandardItemModel *m_model;
 	QString m_searchEngine;
 	QString m_query;
+	QString m_requestKey;
+	QElapsedTimer m_keystrokeTimer;
 	QVector<SearchSuggestion> m_suggestions;
+	int m_requestTimer;
+	int m_keystrokeInterval;
+
+	static QCache<QString, QVector<SearchSuggestion> > m_cache;
+	static QHash<QString, PendingRequest> m_pendingRequests;
+	static SuggestionsStatistics m_statistics;
 
 signals:
 	void suggestionsChanged(const QVector<SearchSuggester::SearchSuggestion> &suggestions);
@@ -24,13 +24,52 @@
 #include "SessionModel.h"
 #include "../ui/MainWindow.h"
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
 
 namespace Otter
 {
 
+void SessionWindow::decodeHistory()
+{
+	if (encodedHistory.isEmpty())
+	{
+		return;
+	}
+
+	history = SessionsManager::decodeHistory(encodedHistory);
+
+	encodedHistory.clear();
+
+	if (historyIndex < 0 || historyIndex >= history.count())
+	{
+		historyIndex = (history.count() - 1);
+	}
+
+	if (historyIndex >= 0)
+	{
+		history[historyIndex].zoom = encodedEntry.zoom;
+	}
+
+	encodedEntry = WindowHistoryEntry();
+}
+
+QVector<WindowHistoryEntry> SessionWindow::getHistory() const
+{
+	if (encodedHistory.isEmpty())
+	{
+		return history;
+	}
+
+	SessionWindow window(*this);
+	window.decodeHistory();
+
+	return window.history;
+}
+
 SessionsManager* SessionsManager::m_instance(nullptr);
 SessionModel* SessionsManager::m_model(nullptr);
 QString SessionsManager::m_sessionPath;
@@ -202,10 +241,32 @@ QString SessionsManager::getSessionPath(const QString &path, bool isBound)
 	return QDir::toNativeSeparators(m_profilePath + QLatin1String("/sessions/") + cleanPath);
 }
 
+QString SessionsManager::getSnapshotPath(const QString &path)
+{
+	QString snapshotPath(path);
+
+	if (snapshotPath.endsWith(QLatin1String(".json")))
+	{
+		snapshotPath.chop(5);
+	}
+
+	return snapshotPath + QLatin1String(".session");
+}
+
 SessionInformation SessionsManager::getSession(const QString &path)
 {
 	SessionInformation session;
-	const JsonSettings settings(getSessionPath(path));
+	const QString sessionPath(getSessionPath(path));
+	const QString snapshotPath(getSnapshotPath(sessionPath));
+
+	if (QFile::exists(snapshotPath) && loadSnapshot(snapshotPath, &session))
+	{
+		session.path = path;
+
+		return session;
+	}
+
+	const JsonSettings settings(sessionPath);
 
 	if (settings.isNull())
 	{
@@ -374,6 +435,50 @@ SessionInformation SessionsManager::getSession(const QString &path)
 	return session;
 }
 
+QByteArray SessionsManager::encodeHistory(const QVector<WindowHistoryEntry> &history)
+{
+	QByteArray data;
+	QDataStream stream(&data, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_6);
+	stream << static_cast<quint32>(history.count());
+
+	for (int i = 0; i < history.count(); ++i)
+	{
+		const WindowHistoryEntry entry(history.at(i));
+
+		stream << entry.url << entry.title << entry.position << static_cast<qint32>(entry.zoom);
+	}
+
+	return data;
+}
+
+QVector<WindowHistoryEntry> SessionsManager::decodeHistory(const QByteArray &data)
+{
+	QDataStream stream(data);
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	quint32 amount(0);
+
+	stream >> amount;
+
+	QVector<WindowHistoryEntry> history;
+	history.reserve(static_cast<int>(qMin(amount, quint32(1000))));
+
+	for (quint32 i = 0; i < amount && stream.status() == QDataStream::Ok; ++i)
+	{
+		WindowHistoryEntry entry;
+		qint32 zoom(0);
+
+		stream >> entry.url >> entry.title >> entry.position >> zoom;
+
+		entry.zoom = zoom;
+
+		history.append(entry);
+	}
+
+	return history;
+}
+
 QStringList SessionsManager::getClosedWindows()
 {
 	QStringList closedWindows;
@@ -392,13 +497,18 @@ QStringList SessionsManager::getClosedWindows()
 
 QStringList SessionsManager::getSessions()
 {
-	const QList<QFileInfo> entries(QDir(m_profilePath + QLatin1String("/sessions/")).entryInfoList({QLatin1String("*.json")}, QDir::Files));
+	const QList<QFileInfo> entries(QDir(m_profilePath + QLatin1String("/sessions/")).entryInfoList({QLatin1String("*.json"), QLatin1String("*.session")}, QDir::Files));
 	QStringList sessions;
 	sessions.reserve(entries.count());
 
 	for (int i = 0; i < entries.count(); ++i)
 	{
-		sessions.append(entries.at(i).completeBaseName());
+		const QString session(entries.at(i).completeBaseName());
+
+		if (!sessions.contains(session))
+		{
+			sessions.append(session);
+		}
 	}
 
 	if (!m_sessionPath.isEmpty() && !entries.contains(m_sessionPath))
@@ -509,6 +619,146 @@ SessionsManager::OpenHints SessionsManager::calculateOpenHints(const QVariantMap
 	return hints;
 }
 
+bool SessionsManager::loadSnapshot(const QString &path, SessionInformation *session)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	quint32 magic(0);
+	quint16 version(0);
+	qint32 sessionIndex(0);
+	quint32 mainWindowsAmount(0);
+
+	stream >> magic >> version;
+
+	if (magic != 0x4f545353 || version != 1)
+	{
+		return false;
+	}
+
+	stream >> session->title >> sessionIndex >> session->isClean >> mainWindowsAmount;
+
+	session->index = sessionIndex;
+
+	for (quint32 i = 0; i < mainWindowsAmount && stream.status() == QDataStream::Ok; ++i)
+	{
+		QByteArray mainWindowRecord;
+
+		stream >> mainWindowRecord;
+
+		QDataStream mainWindowStream(mainWindowRecord);
+		mainWindowStream.setVersion(QDataStream::Qt_5_6);
+
+		SessionMainWindow sessionMainWindow;
+		qint32 mainWindowIndex(0);
+		quint32 toolBarsAmount(0);
+		quint32 windowsAmount(0);
+
+		mainWindowStream >> sessionMainWindow.geometry >> mainWindowIndex >> sessionMainWindow.splitters >> sessionMainWindow.hasToolBarsState >> toolBarsAmount;
+
+		sessionMainWindow.index = mainWindowIndex;
+
+		for (quint32 j = 0; j < toolBarsAmount && mainWindowStream.status() == QDataStream::Ok; ++j)
+		{
+			QString identifier;
+			qint32 location(0);
+			qint32 row(0);
+			qint32 normalVisibility(0);
+			qint32 fullScreenVisibility(0);
+
+			mainWindowStream >> identifier >> location >> row >> normalVisibility >> fullScreenVisibility;
+
+			ToolBarState toolBarState;
+			toolBarState.identifier = ToolBarsManager::getToolBarIdentifier(identifier);
+			toolBarState.location = static_cast<Qt::ToolBarArea>(location);
+			toolBarState.row = row;
+			toolBarState.normalVisibility = static_cast<ToolBarState::ToolBarVisibility>(normalVisibility);
+			toolBarState.fullScreenVisibility = static_cast<ToolBarState::ToolBarVisibility>(fullScreenVisibility);
+
+			sessionMainWindow.toolBars.append(toolBarState);
+		}
+
+		mainWindowStream >> windowsAmount;
+
+		for (quint32 j = 0; j < windowsAmount && mainWindowStream.status() == QDataStream::Ok; ++j)
+		{
+			QByteArray windowRecord;
+
+			mainWindowStream >> windowRecord;
+
+			QDataStream windowStream(windowRecord);
+			windowStream.setVersion(QDataStream::Qt_5_6);
+
+			SessionWindow sessionWindow;
+			QMap<QString, QVariant> options;
+			qint32 state(0);
+			qint32 parentGroup(0);
+			qint32 historyIndex(0);
+			qint32 zoom(0);
+
+			windowStream >> sessionWindow.state.geometry >> state >> options >> parentGroup >> historyIndex >> sessionWindow.isAlwaysOnTop >> sessionWindow.isPinned;
+			windowStream >> sessionWindow.encodedEntry.url >> sessionWindow.encodedEntry.title >> sessionWindow.encodedEntry.position >> zoom >> sessionWindow.encodedHistory;
+
+			if (windowStream.status() != QDataStream::Ok)
+			{
+				return false;
+			}
+
+			sessionWindow.state.state = static_cast<Qt::WindowState>(state);
+			sessionWindow.parentGroup = parentGroup;
+			sessionWindow.historyIndex = (sessionWindow.encodedHistory.isEmpty() ? -1 : historyIndex);
+			sessionWindow.encodedEntry.zoom = zoom;
+
+			QMap<QString, QVariant>::const_iterator iterator;
+
+			for (iterator = options.constBegin(); iterator != options.constEnd(); ++iterator)
+			{
+				const int optionIdentifier(SettingsManager::getOptionIdentifier(iterator.key()));
+
+				if (optionIdentifier >= 0)
+				{
+					sessionWindow.options[optionIdentifier] = iterator.value();
+				}
+			}
+
+			sessionMainWindow.windows.append(sessionWindow);
+		}
+
+		if (mainWindowStream.status() != QDataStream::Ok)
+		{
+			return false;
+		}
+
+		if (sessionMainWindow.index < 0 || sessionMainWindow.index >= sessionMainWindow.windows.count())
+		{
+			sessionMainWindow.index = (sessionMainWindow.windows.count() - 1);
+		}
+
+		session->windows.append(sessionMainWindow);
+	}
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		session->windows.clear();
+
+		return false;
+	}
+
+	if (session->index < 0 || session->index >= session->windows.count())
+	{
+		session->index = (session->windows.count() - 1);
+	}
+
+	return true;
+}
+
 bool SessionsManager::restoreClosedWindow(int index)
 {
 	if (index < 0 || index >= m_closedWindows.count())
@@ -586,12 +836,19 @@ bool SessionsManager::saveSession(const QString &path, const QString &title, Mai
 		windows = Application::getWindows();
 	}
 
+	const MainWindow *activeWindow(Application::getActiveWindow());
+
 	session.windows.reserve(windows.count());
 
 	for (int i = 0; i < windows.count(); ++i)
 	{
 		if (!windows.at(i)->isPrivate())
 		{
+			if (windows.at(i) == activeWindow)
+			{
+				session.index = session.windows.count();
+			}
+
 			session.windows.append(windows.at(i)->getSession());
 		}
 	}
@@ -618,7 +875,7 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 	{
 		path = sessionsPath + session.title + QLatin1String(".json");
 
-		if (QFile::exists(path))
+		if (QFile::exists(path) || QFile::exists(getSnapshotPath(path)))
 		{
 			int i(2);
 
@@ -628,13 +885,33 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 
 				++i;
 			}
-			while (QFile::exists(path));
+			while (QFile::exists(path) || QFile::exists(getSnapshotPath(path)));
 		}
 	}
 
+	if (!saveSnapshot(getSnapshotPath(path), session))
+	{
+		return false;
+	}
+
+	if (path.endsWith(QLatin1String(".json")) && QFile::exists(path))
+	{
+		QFile::remove(path);
+	}
+
+	return true;
+}
+
+bool SessionsManager::exportSession(const SessionInformation &session, const QString &path)
+{
+	if (session.windows.isEmpty())
+	{
+		return false;
+	}
+
 	const QStringList excludedOptions(SettingsManager::getOption(SettingsManager::Sessions_OptionsExludedFromSavingOption).toStringList());
 	QJsonArray mainWindowsArray;
-	QJsonObject sessionObject({{QLatin1String("title"), session.title}, {QLatin1String("currentIndex"), 1}});
+	QJsonObject sessionObject({{QLatin1String("title"), session.title}, {QLatin1String("currentIndex"), (session.index + 1)}});
 
 	if (!session.isClean)
 	{
@@ -705,12 +982,13 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 				windowObject.insert(QLatin1String("isPinned"), true);
 			}
 
+			const QVector<WindowHistoryEntry> history(sessionEntry.windows.at(j).getHistory());
 			QJsonArray windowHistoryArray;
 
-			for (int k = 0; k < sessionEntry.windows.at(j).history.count(); ++k)
+			for (int k = 0; k < history.count(); ++k)
 			{
-				const QPoint position(sessionEntry.windows.at(j).history.at(k).position);
-				QJsonObject historyEntryObject({{QLatin1String("url"), sessionEntry.windows.at(j).history.at(k).url}, {QLatin1String("title"), sessionEntry.windows.at(j).history.at(k).title}, {QLatin1String("zoom"), sessionEntry.windows.at(j).history.at(k).zoom}});
+				const QPoint position(history.at(k).position);
+				QJsonObject historyEntryObject({{QLatin1String("url"), history.at(k).url}, {QLatin1String("title"), history.at(k).title}, {QLatin1String("zoom"), history.at(k).zoom}});
 
 				if (!position.isNull())
 				{
@@ -817,10 +1095,86 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 	return settings.save(path);
 }
 
+bool SessionsManager::saveSnapshot(const QString &path, const SessionInformation &session)
+{
+	QSaveFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	const QStringList excludedOptions(SettingsManager::getOption(SettingsManager::Sessions_OptionsExludedFromSavingOption).toStringList());
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_6);
+	stream << static_cast<quint32>(0x4f545353) << static_cast<quint16>(1) << session.title << static_cast<qint32>(session.index) << session.isClean << static_cast<quint32>(session.windows.count());
+
+	for (int i = 0; i < session.windows.count(); ++i)
+	{
+		const SessionMainWindow sessionEntry(session.windows.at(i));
+		QByteArray mainWindowRecord;
+		QDataStream mainWindowStream(&mainWindowRecord, QIODevice::WriteOnly);
+		mainWindowStream.setVersion(QDataStream::Qt_5_6);
+		mainWindowStream << sessionEntry.geometry << static_cast<qint32>(sessionEntry.index) << sessionEntry.splitters << sessionEntry.hasToolBarsState << static_cast<quint32>(sessionEntry.toolBars.count());
+
+		for (int j = 0; j < sessionEntry.toolBars.count(); ++j)
+		{
+			const ToolBarState toolBarState(sessionEntry.toolBars.at(j));
+
+			mainWindowStream << ToolBarsManager::getToolBarName(toolBarState.identifier) << static_cast<qint32>(toolBarState.location) << static_cast<qint32>(toolBarState.row) << static_cast<qint32>(toolBarState.normalVisibility) << static_cast<qint32>(toolBarState.fullScreenVisibility);
+		}
+
+		mainWindowStream << static_cast<quint32>(sessionEntry.windows.count());
+
+		for (int j = 0; j < sessionEntry.windows.count(); ++j)
+		{
+			const SessionWindow sessionWindow(sessionEntry.windows.at(j));
+			const WindowHistoryEntry *currentEntry(sessionWindow.getCurrentEntry());
+			const WindowHistoryEntry entry(currentEntry ? *currentEntry : WindowHistoryEntry());
+			QMap<QString, QVariant> options;
+			QHash<int, QVariant>::const_iterator iterator;
+
+			for (iterator = sessionWindow.options.constBegin(); iterator != sessionWindow.options.constEnd(); ++iterator)
+			{
+				const QString optionName(SettingsManager::getOptionName(iterator.key()));
+
+				if (!optionName.isEmpty() && !excludedOptions.contains(optionName))
+				{
+					options[optionName] = iterator.value();
+				}
+			}
+
+			QByteArray windowRecord;
+			QDataStream windowStream(&windowRecord, QIODevice::WriteOnly);
+			windowStream.setVersion(QDataStream::Qt_5_6);
+			windowStream << sessionWindow.state.geometry << static_cast<qint32>(sessionWindow.state.state) << options << static_cast<qint32>(sessionWindow.parentGroup) << static_cast<qint32>(sessionWindow.historyIndex) << sessionWindow.isAlwaysOnTop << sessionWindow.isPinned;
+			windowStream << entry.url << entry.title << entry.position << static_cast<qint32>(entry.zoom) << (sessionWindow.encodedHistory.isEmpty() ? (sessionWindow.history.isEmpty() ? QByteArray() : encodeHistory(sessionWindow.history)) : sessionWindow.encodedHistory);
+
+			mainWindowStream << windowRecord;
+		}
+
+		stream << mainWindowRecord;
+	}
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		file.cancelWriting();
+
+		return false;
+	}
+
+	return file.commit();
+}
+
 bool SessionsManager::deleteSession(const QString &path)
 {
 	const QString cleanPath(getSessionPath(path, true));
 
+	if (QFile::exists(getSnapshotPath(cleanPath)))
+	{
+		QFile::remove(getSnapshotPath(cleanPath));
+	}
+
 	if (QFile::exists(cleanPath))
 	{
 		return QFile::remove(cleanPath);
@@ -132,31 +132,35 @@ struct SessionWindow final
 	WindowState state;
 	QHash<int, QVariant> options;
 	QVector<WindowHistoryEntry> history;
+	QByteArray encodedHistory;
+	WindowHistoryEntry encodedEntry;
 	int parentGroup = 0;
 	int historyIndex = -1;
 	bool isAlwaysOnTop = false;
 	bool isPinned = false;
 
+	void decodeHistory();
+	QVector<WindowHistoryEntry> getHistory() const;
+
 	QString getUrl() const
 	{
-		if (historyIndex >= 0 && historyIndex < history.count())
-		{
-			return history.at(historyIndex).url;
-		}
+		const WindowHistoryEntry *entry(getCurrentEntry());
 
-		return {};
+		return (entry ? entry->url : QString());
 	}
 
 	QString getTitle() const
 	{
-		if (historyIndex >= 0 && historyIndex < history.count())
+		const WindowHistoryEntry *entry(getCurrentEntry());
+
+		if (entry)
 		{
-			if (!history.at(historyIndex).title.isEmpty())
+			if (!entry->title.isEmpty())
 			{
-				return history.at(historyIndex).title;
+				return entry->title;
 			}
 
-			if (history.at(historyIndex).url == QLatin1String("about:start") && SettingsManager::getOption(SettingsManager::StartPage_EnableStartPageOption).toBool())
+			if (entry->url == QLatin1String("about:start") && SettingsManager::getOption(SettingsManager::StartPage_EnableStartPageOption).toBool())
 			{
 				return QCoreApplication::translate("main", "Start Page");
 			}
@@ -167,12 +171,24 @@ struct SessionWindow final
 
 	int getZoom() const
 	{
+		const WindowHistoryEntry *entry(getCurrentEntry());
+
+		return (entry ? entry->zoom : SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
+	}
+
+	const WindowHistoryEntry* getCurrentEntry() const
+	{
+		if (!encodedHistory.isEmpty())
+		{
+			return &encodedEntry;
+		}
+
 		if (historyIndex >= 0 && historyIndex < history.count())
 		{
-			return history.at(historyIndex).zoom;
+			return &history.at(historyIndex);
 		}
 
-		return SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt();
+		return nullptr;
 	}
 };
 
@@ -243,7 +259,9 @@ public:
 	static QString getReadableDataPath(const QString &path, bool forceBundled = false);
 	static QString getWritableDataPath(const QString &path);
 	static QString getSessionPath(const QString &path, bool isBound = false);
+	static QString getSnapshotPath(const QString &path);
 	static SessionInformation getSession(const QString &path);
+	static QVector<WindowHistoryEntry> decodeHistory(const QByteArray &data);
 	static QStringList getClosedWindows();
 	static QStringList getSessions();
 	static SessionsManager::OpenHints calculateOpenHints(OpenHints hints, Qt::MouseButton button, Qt::KeyboardModifiers modifiers);
@@ -253,6 +271,7 @@ public:
 	static bool restoreSession(const SessionInformation &session, MainWindow *mainWindow = nullptr, bool isPrivate = false);
 	static bool saveSession(const QString &path = {}, const QString &title = {}, MainWindow *mainWindow = nullptr, bool isClean = true);
 	static bool saveSession(const SessionInformation &session);
+	static bool exportSession(const SessionInformation &session, const QString &path);
 	static bool deleteSession(const QString &path = {});
 	static bool isPrivate();
 	static bool isReadOnly();
@@ -263,6 +282,9 @@ protected:
 
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
+	static QByteArray encodeHistory(const QVector<WindowHistoryEntry> &history);
+	static bool loadSnapshot(const QString &path, SessionInformation *session);
+	static bool saveSnapshot(const QString &path, const SessionInformation &session);
 
 private:
 	int m_saveTimer;
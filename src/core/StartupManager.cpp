@@ -0,0 +1,318 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "StartupManager.h"
+#include "Console.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimer>
+
+namespace Otter
+{
+
+StartupManager* StartupManager::m_instance(nullptr);
+QElapsedTimer StartupManager::m_timer;
+QMutex StartupManager::m_timelineMutex;
+QVector<StartupManager::TaskDefinition> StartupManager::m_tasks;
+QVector<StartupManager::TaskDefinition> StartupManager::m_deferredTasks;
+QVector<StartupManager::PhaseInformation> StartupManager::m_timeline;
+QHash<QString, QFuture<QByteArray> > StartupManager::m_preloadedFiles;
+bool StartupManager::m_isStartupFinished(false);
+
+StartupManager::StartupManager(QObject *parent) : QObject(parent)
+{
+}
+
+void StartupManager::createInstance()
+{
+	if (!m_instance)
+	{
+		m_timer.start();
+
+		m_instance = new StartupManager(QCoreApplication::instance());
+	}
+}
+
+void StartupManager::addTask(const QString &name, const std::function<void()> &function, const QStringList &dependencies, TaskType type)
+{
+	TaskDefinition task;
+	task.name = name;
+	task.dependencies = dependencies;
+	task.function = function;
+	task.type = type;
+
+	m_tasks.append(task);
+}
+
+void StartupManager::runTasks()
+{
+	QVector<TaskDefinition> pendingTasks(m_tasks);
+	QSet<QString> registeredTasks;
+	QSet<QString> completedTasks;
+
+	m_tasks.clear();
+
+	for (int i = 0; i < pendingTasks.count(); ++i)
+	{
+		registeredTasks.insert(pendingTasks.at(i).name);
+	}
+
+	while (!pendingTasks.isEmpty())
+	{
+		int readyTask(-1);
+
+		for (int i = 0; i < pendingTasks.count(); ++i)
+		{
+			const QStringList dependencies(pendingTasks.at(i).dependencies);
+			bool isReady(true);
+
+			for (int j = 0; j < dependencies.count(); ++j)
+			{
+				if (registeredTasks.contains(dependencies.at(j)) && !completedTasks.contains(dependencies.at(j)))
+				{
+					isReady = false;
+
+					break;
+				}
+			}
+
+			if (isReady)
+			{
+				readyTask = i;
+
+				break;
+			}
+		}
+
+		if (readyTask < 0)
+		{
+			Console::addMessage(QCoreApplication::translate("main", "Circular dependency between startup tasks detected, falling back to registration order"), Console::OtherCategory, Console::WarningLevel);
+
+			readyTask = 0;
+		}
+
+		const TaskDefinition task(pendingTasks.takeAt(readyTask));
+
+		if (task.type == DeferredTask)
+		{
+			m_deferredTasks.append(task);
+		}
+		else
+		{
+			runTask(task, MainThreadPhase);
+		}
+
+		completedTasks.insert(task.name);
+	}
+
+	if (!m_deferredTasks.isEmpty())
+	{
+		QTimer::singleShot(0, m_instance, &StartupManager::runDeferredTasks);
+	}
+}
+
+void StartupManager::runDeferredTasks()
+{
+	if (m_deferredTasks.isEmpty())
+	{
+		return;
+	}
+
+	runTask(m_deferredTasks.takeFirst(), DeferredPhase);
+
+	if (!m_deferredTasks.isEmpty())
+	{
+		QTimer::singleShot(0, m_instance, &StartupManager::runDeferredTasks);
+	}
+}
+
+void StartupManager::runTask(const TaskDefinition &task, PhaseType type)
+{
+	PhaseInformation phase;
+	phase.name = task.name;
+	phase.type = type;
+	phase.startTime = m_timer.nsecsElapsed();
+
+	task.function();
+
+	phase.duration = (m_timer.nsecsElapsed() - phase.startTime);
+
+	addPhase(phase);
+}
+
+void StartupManager::preloadFile(const QString &path)
+{
+	if (m_isStartupFinished || m_preloadedFiles.contains(path) || !QFile::exists(path))
+	{
+		return;
+	}
+
+	m_preloadedFiles[path] = QtConcurrent::run([=]() -> QByteArray
+	{
+		PhaseInformation phase;
+		phase.name = QLatin1String("Preload: ") + path;
+		phase.type = WorkerThreadPhase;
+		phase.startTime = m_timer.nsecsElapsed();
+
+		QFile file(path);
+		QByteArray data;
+
+		if (file.open(QIODevice::ReadOnly))
+		{
+			data = file.readAll();
+
+			file.close();
+		}
+
+		phase.duration = (m_timer.nsecsElapsed() - phase.startTime);
+
+		addPhase(phase);
+
+		return data;
+	});
+}
+
+void StartupManager::markMilestone(const QString &name)
+{
+	PhaseInformation phase;
+	phase.name = name;
+	phase.type = MilestonePhase;
+	phase.startTime = m_timer.nsecsElapsed();
+
+	addPhase(phase);
+}
+
+void StartupManager::markStartupFinished()
+{
+	if (m_isStartupFinished)
+	{
+		return;
+	}
+
+	m_isStartupFinished = true;
+
+	markMilestone(QLatin1String("Startup finished"));
+
+	m_preloadedFiles.clear();
+}
+
+void StartupManager::addPhase(const PhaseInformation &phase)
+{
+	m_timelineMutex.lock();
+	m_timeline.append(phase);
+	m_timelineMutex.unlock();
+
+	if (m_instance)
+	{
+		QMetaObject::invokeMethod(m_instance, "timelineChanged", Qt::QueuedConnection);
+	}
+}
+
+StartupManager* StartupManager::getInstance()
+{
+	return m_instance;
+}
+
+QString StartupManager::createReport()
+{
+	const QVector<PhaseInformation> timeline(getTimeline());
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignRight);
+	stream << QLatin1String("Startup timeline:\n");
+
+	for (int i = 0; i < timeline.count(); ++i)
+	{
+		const PhaseInformation phase(timeline.at(i));
+		QString type;
+
+		switch (phase.type)
+		{
+			case WorkerThreadPhase:
+				type = QLatin1String("worker");
+
+				break;
+			case DeferredPhase:
+				type = QLatin1String("deferred");
+
+				break;
+			case MilestonePhase:
+				type = QLatin1String("milestone");
+
+				break;
+			default:
+				type = QLatin1String("main");
+
+				break;
+		}
+
+		stream << QLatin1Char('\t');
+		stream.setFieldWidth(10);
+		stream << QString::number((phase.startTime / 1000000.0), 'f', 2);
+		stream.setFieldWidth(0);
+		stream << QLatin1String(" ms");
+		stream.setFieldWidth(10);
+		stream << QString::number((phase.duration / 1000000.0), 'f', 2);
+		stream.setFieldWidth(0);
+		stream << QLatin1String(" ms\t") << type << QLatin1Char('\t') << phase.name << QLatin1Char('\n');
+	}
+
+	stream.flush();
+
+	return report;
+}
+
+QVector<StartupManager::PhaseInformation> StartupManager::getTimeline()
+{
+	m_timelineMutex.lock();
+
+	QVector<PhaseInformation> timeline(m_timeline);
+
+	m_timelineMutex.unlock();
+
+	std::stable_sort(timeline.begin(), timeline.end(), [&](const PhaseInformation &first, const PhaseInformation &second)
+	{
+		return (first.startTime < second.startTime);
+	});
+
+	return timeline;
+}
+
+bool StartupManager::takePreloadedFile(const QString &path, QByteArray *data)
+{
+	if (!m_preloadedFiles.contains(path))
+	{
+		return false;
+	}
+
+	*data = m_preloadedFiles.take(path).result();
+
+	return !data->isNull();
+}
+
+bool StartupManager::isStartupFinished()
+{
+	return m_isStartupFinished;
+}
+
+}
@@ -0,0 +1,107 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_STARTUPMANAGER_H
+#define OTTER_STARTUPMANAGER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include <functional>
+
+namespace Otter
+{
+
+class StartupManager final : public QObject
+{
+	Q_OBJECT
+
+public:
+	enum TaskType
+	{
+		ImmediateTask = 0,
+		DeferredTask
+	};
+
+	enum PhaseType
+	{
+		MainThreadPhase = 0,
+		WorkerThreadPhase,
+		DeferredPhase,
+		MilestonePhase
+	};
+
+	struct PhaseInformation final
+	{
+		QString name;
+		PhaseType type = MainThreadPhase;
+		qint64 startTime = 0;
+		qint64 duration = 0;
+	};
+
+	static void createInstance();
+	static void addTask(const QString &name, const std::function<void()> &function, const QStringList &dependencies = {}, TaskType type = ImmediateTask);
+	static void runTasks();
+	static void preloadFile(const QString &path);
+	static void markMilestone(const QString &name);
+	static void markStartupFinished();
+	static StartupManager* getInstance();
+	static QString createReport();
+	static QVector<PhaseInformation> getTimeline();
+	static bool takePreloadedFile(const QString &path, QByteArray *data);
+	static bool isStartupFinished();
+
+protected:
+	struct TaskDefinition final
+	{
+		QString name;
+		QStringList dependencies;
+		std::function<void()> function;
+		TaskType type = ImmediateTask;
+	};
+
+	explicit StartupManager(QObject *parent = nullptr);
+
+	static void runTask(const TaskDefinition &task, PhaseType type);
+	static void addPhase(const PhaseInformation &phase);
+
+protected slots:
+	void runDeferredTasks();
+
+private:
+	static StartupManager *m_instance;
+	static QElapsedTimer m_timer;
+	static QMutex m_timelineMutex;
+	static QVector<TaskDefinition> m_tasks;
+	static QVector<TaskDefinition> m_deferredTasks;
+	static QVector<PhaseInformation> m_timeline;
+	static QHash<QString, QFuture<QByteArray> > m_preloadedFiles;
+	static bool m_isStartupFinished;
+
+signals:
+	void timelineChanged();
+};
+
+}
+
+#endif
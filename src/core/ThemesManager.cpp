@@ -104,7 +104,10 @@ ThemesManager* ThemesManager::m_instance(nullptr);
 Palette* ThemesManager::m_palette(nullptr);
 QWidget* ThemesManager::m_probeWidget(nullptr);
 QString ThemesManager::m_iconThemePath(QLatin1String(":/icons/theme/"));
+QHash<QString, QIcon> ThemesManager::m_icons;
+QSet<QString> ThemesManager::m_iconThemeFiles;
 bool ThemesManager::m_useSystemIconTheme(false);
+bool ThemesManager::m_isIconThemeListed(false);
 
 ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
 {
@@ -153,6 +156,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 				{
 					m_iconThemePath = path;
 
+					clearIconsCache();
+
 					emit iconThemeChanged();
 				}
 			}
@@ -163,6 +168,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 			{
 				m_useSystemIconTheme = value.toBool();
 
+				clearIconsCache();
+
 				emit iconThemeChanged();
 			}
 		default:
@@ -170,6 +177,34 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 	}
 }
 
+void ThemesManager::clearIconsCache()
+{
+	m_icons.clear();
+	m_iconThemeFiles.clear();
+
+	m_isIconThemeListed = false;
+}
+
+void ThemesManager::rasterizeIcon(const QIcon &icon)
+{
+	const QStyle *style(QApplication::style());
+
+	if (!style)
+	{
+		return;
+	}
+
+	const int smallIconSize(style->pixelMetric(QStyle::PM_SmallIconSize));
+	const int toolBarIconSize(style->pixelMetric(QStyle::PM_ToolBarIconSize));
+
+	icon.pixmap(smallIconSize, smallIconSize);
+
+	if (toolBarIconSize != smallIconSize)
+	{
+		icon.pixmap(toolBarIconSize, toolBarIconSize);
+	}
+}
+
 ThemesManager* ThemesManager::getInstance()
 {
 	return m_instance;
@@ -203,14 +238,14 @@ QString ThemesManager::getAnimationPath(const QString &name)
 	const QString iconPath(m_iconThemePath + name);
 	const QString svgPath(iconPath + QLatin1String(".svg"));
 
-	if (QFile::exists(svgPath))
+	if (hasIconThemeFile(svgPath))
 	{
 		return svgPath;
 	}
 
 	const QString gifPath(iconPath + QLatin1String(".gif"));
 
-	if (QFile::exists(gifPath))
+	if (hasIconThemeFile(gifPath))
 	{
 		return gifPath;
 	}
@@ -230,32 +265,75 @@ QIcon ThemesManager::createIcon(const QString &name, bool fromTheme)
 		return QIcon(Utils::loadPixmapFromDataUri(name));
 	}
 
+	const QString key((fromTheme ? QLatin1String("theme:") : QLatin1String("bundled:")) + name);
+
+	if (m_icons.contains(key))
+	{
+		return m_icons[key];
+	}
+
+	QIcon icon;
+
 	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
 	{
-		return QIcon::fromTheme(name);
+		icon = QIcon::fromTheme(name);
 	}
+	else
+	{
+		const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
+		const QString svgPath(iconPath + QLatin1String(".svg"));
+		const QString rasterPath(iconPath + QLatin1String(".png"));
 
-	const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
-	const QString svgPath(iconPath + QLatin1String(".svg"));
-	const QString rasterPath(iconPath + QLatin1String(".png"));
+		if (hasIconThemeFile(svgPath))
+		{
+			icon = QIcon(svgPath);
+
+			rasterizeIcon(icon);
+		}
+		else if (hasIconThemeFile(rasterPath))
+		{
+			icon = QIcon(rasterPath);
+		}
+	}
+
+	m_icons[key] = icon;
 
-	if (QFile::exists(svgPath))
+	return icon;
+}
+
+bool ThemesManager::hasIconThemeFile(const QString &path)
+{
+	if (!path.startsWith(m_iconThemePath) || path.indexOf(QLatin1Char('/'), m_iconThemePath.length()) >= 0 || path.indexOf(QDir::separator(), m_iconThemePath.length()) >= 0)
 	{
-		return QIcon(svgPath);
+		return QFile::exists(path);
 	}
 
-	if (QFile::exists(rasterPath))
+	if (!m_isIconThemeListed)
 	{
-		return QIcon(rasterPath);
+		const QStringList entries(QDir(m_iconThemePath).entryList(QDir::Files));
+
+		m_iconThemeFiles = QSet<QString>::fromList(entries);
+		m_isIconThemeListed = true;
 	}
 
-	return {};
+	return m_iconThemeFiles.contains(path.mid(m_iconThemePath.length()));
 }
 
 bool ThemesManager::eventFilter(QObject *object, QEvent *event)
 {
-	if (object == m_probeWidget && event->type() == QEvent::StyleChange)
+	if (object == m_probeWidget && event->type() == QEvent::ThemeChange)
 	{
+		clearIconsCache();
+
+		if (m_useSystemIconTheme)
+		{
+			emit iconThemeChanged();
+		}
+	}
+	else if (object == m_probeWidget && event->type() == QEvent::StyleChange)
+	{
+		clearIconsCache();
+
 		if (!QApplication::style()->inherits("Otter::Style"))
 		{
 			const QList<QStyle*> children(QApplication::style()->findChildren<QStyle*>());
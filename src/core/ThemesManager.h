@@ -21,7 +21,10 @@
 #define OTTER_THEMESMANAGER_H
 
 #include <QtCore/QAbstractNativeEventFilter>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtGui/QIcon>
 #include <QtWidgets/QStyle>
 
 namespace Otter
@@ -104,6 +107,9 @@ public:
 protected:
 	explicit ThemesManager(QObject *parent);
 
+	static void clearIconsCache();
+	static void rasterizeIcon(const QIcon &icon);
+	static bool hasIconThemeFile(const QString &path);
 	bool eventFilter(QObject *object, QEvent *event) override;
 #ifdef Q_OS_WIN32
 	bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) override;
@@ -117,7 +123,10 @@ private:
 	static Palette *m_palette;
 	static QWidget *m_probeWidget;
 	static QString m_iconThemePath;
+	static QHash<QString, QIcon> m_icons;
+	static QSet<QString> m_iconThemeFiles;
 	static bool m_useSystemIconTheme;
+	static bool m_isIconThemeListed;
 
 signals:
 	void iconThemeChanged();
@@ -26,24 +26,37 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
-#include <QtCore/QRegularExpression>
 #include <QtCore/QTextStream>
 
 namespace Otter
 {
 
+QHash<QString, QVector<UserScript*> > UserScript::m_hostIndex;
+QVector<UserScript*> UserScript::m_genericIndex;
+bool UserScript::m_isIndexValid(false);
+
 UserScript::UserScript(const QString &path, const QUrl &url, QObject *parent) : QObject(parent), Addon(),
 	m_iconFetchJob(nullptr),
 	m_path(path),
 	m_downloadUrl(url),
 	m_injectionTime(DocumentReadyTime),
-	m_shouldRunOnSubFrames(true)
+	m_shouldRunOnSubFrames(true),
+	m_isIndexed(false)
 {
 	reload();
 }
 
+UserScript::~UserScript()
+{
+	removeFromIndex();
+}
+
 void UserScript::reload()
 {
+	const bool wasIndexed(m_isIndexed);
+
+	removeFromIndex();
+
 	m_source.clear();
 	m_title.clear();
 	m_description.clear();
@@ -55,6 +68,9 @@ void UserScript::reload()
 	m_excludeRules.clear();
 	m_includeRules.clear();
 	m_matchRules.clear();
+	m_compiledExcludeRules.clear();
+	m_compiledIncludeRules.clear();
+	m_compiledMatchRules.clear();
 	m_injectionTime = DocumentReadyTime;
 	m_shouldRunOnSubFrames = true;
 
@@ -68,6 +84,7 @@ void UserScript::reload()
 	}
 
 	QTextStream stream(&file);
+	const QRegularExpression matchRuleExpression(QLatin1String("^.+://.*/.*"));
 	bool hasHeader(false);
 
 	while (!stream.atEnd())
@@ -130,7 +147,7 @@ void UserScript::reload()
 		{
 			line = line.section(QLatin1Char(' '), 1, -1);
 
-			if (QRegularExpression(QLatin1String("^.+://.*/.*")).match(line).hasMatch() && (!line.startsWith(QLatin1Char('*')) || line.at(1) == QLatin1Char(':')))
+			if (matchRuleExpression.match(line).hasMatch() && (!line.startsWith(QLatin1Char('*')) || line.at(1) == QLatin1Char(':')))
 			{
 				const QString scheme(line.left(line.indexOf(QLatin1String("://"))));
 
@@ -192,6 +209,26 @@ void UserScript::reload()
 
 	file.close();
 
+	for (int i = 0; i < m_excludeRules.count(); ++i)
+	{
+		m_compiledExcludeRules.append(compileRule(m_excludeRules.at(i)));
+	}
+
+	for (int i = 0; i < m_includeRules.count(); ++i)
+	{
+		m_compiledIncludeRules.append(compileRule(m_includeRules.at(i)));
+	}
+
+	for (int i = 0; i < m_matchRules.count(); ++i)
+	{
+		m_compiledMatchRules.append(compileRule(m_matchRules.at(i)));
+	}
+
+	if (wasIndexed)
+	{
+		addToIndex();
+	}
+
 	if (m_title.isEmpty())
 	{
 		m_title = QFileInfo(file).completeBaseName();
@@ -231,6 +268,126 @@ void UserScript::reload()
 	emit metaDataChanged();
 }
 
+void UserScript::addToIndex()
+{
+	if (!m_isIndexValid || m_isIndexed)
+	{
+		return;
+	}
+
+	m_isIndexed = true;
+
+	QStringList hosts;
+
+	if (!m_matchRules.isEmpty() || !m_includeRules.isEmpty())
+	{
+		const QStringList rules(m_matchRules + m_includeRules);
+
+		for (int i = 0; i < rules.count(); ++i)
+		{
+			const QString host(getRuleHost(rules.at(i), (i < m_matchRules.count())));
+
+			if (host.isEmpty())
+			{
+				hosts.clear();
+
+				break;
+			}
+
+			if (!hosts.contains(host))
+			{
+				hosts.append(host);
+			}
+		}
+	}
+
+	m_indexedHosts = hosts;
+
+	if (hosts.isEmpty())
+	{
+		m_genericIndex.append(this);
+
+		return;
+	}
+
+	for (int i = 0; i < hosts.count(); ++i)
+	{
+		m_hostIndex[hosts.at(i)].append(this);
+	}
+}
+
+void UserScript::removeFromIndex()
+{
+	if (!m_isIndexed)
+	{
+		return;
+	}
+
+	m_isIndexed = false;
+
+	if (m_indexedHosts.isEmpty())
+	{
+		m_genericIndex.removeAll(this);
+
+		return;
+	}
+
+	for (int i = 0; i < m_indexedHosts.count(); ++i)
+	{
+		QVector<UserScript*> &scripts(m_hostIndex[m_indexedHosts.at(i)]);
+		scripts.removeAll(this);
+
+		if (scripts.isEmpty())
+		{
+			m_hostIndex.remove(m_indexedHosts.at(i));
+		}
+	}
+
+	m_indexedHosts.clear();
+}
+
+void UserScript::buildIndex()
+{
+	const QStringList scriptNames(AddonsManager::getUserScripts());
+
+	m_hostIndex.clear();
+	m_genericIndex.clear();
+	m_isIndexValid = true;
+
+	for (int i = 0; i < scriptNames.count(); ++i)
+	{
+		UserScript *script(AddonsManager::getUserScript(scriptNames.at(i)));
+
+		if (script)
+		{
+			script->m_isIndexed = false;
+			script->addToIndex();
+		}
+	}
+}
+
+void UserScript::invalidateIndex()
+{
+	const QList<QVector<UserScript*> > hostScripts(m_hostIndex.values());
+
+	for (int i = 0; i < hostScripts.count(); ++i)
+	{
+		for (int j = 0; j < hostScripts.at(i).count(); ++j)
+		{
+			hostScripts.at(i).at(j)->m_isIndexed = false;
+		}
+	}
+
+	for (int i = 0; i < m_genericIndex.count(); ++i)
+	{
+		m_genericIndex.at(i)->m_isIndexed = false;
+	}
+
+	m_hostIndex.clear();
+	m_genericIndex.clear();
+	m_isIndexValid = false;
+}
+
 QString UserScript::getName() const
 {
 	return QFileInfo(m_path).completeBaseName();
@@ -275,49 +432,6 @@ QString UserScript::getSource()
 	return m_source;
 }
 
-QString UserScript::checkUrlSubString(const QString &rule, const QString &urlSubString, QString generatedUrl, int position) const
-{
-	if (rule.isEmpty())
-	{
-		return urlSubString;
-	}
-
-	for (int i = 0; i < urlSubString.length(); ++i)
-	{
-		const QChar character(urlSubString.at(i));
-
-		if (rule.at(position) == QLatin1Char('*'))
-		{
-			const QString wildcardString(urlSubString.mid(i));
-
-			for (int j = 1; j < wildcardString.length(); ++j)
-			{
-				const QString result(checkUrlSubString(rule, urlSubString.right(wildcardString.length() - j), generatedUrl + wildcardString.left(j), (position + 1)));
-
-				if (!result.isEmpty())
-				{
-					return result;
-				}
-			}
-		}
-		else if (rule.at(position) != character)
-		{
-			return {};
-		}
-
-		++position;
-
-		generatedUrl += character;
-
-		if (position == rule.length())
-		{
-			return generatedUrl;
-		}
-	}
-
-	return {};
-}
-
 QUrl UserScript::getHomePage() const
 {
 	return m_homePage;
@@ -348,22 +462,161 @@ QStringList UserScript::getMatchRules() const
 	return m_matchRules;
 }
 
+QString UserScript::getRuleHost(const QString &rule, bool isMatchRule)
+{
+	if (rule.startsWith(QLatin1Char('/')) && rule.endsWith(QLatin1Char('/')))
+	{
+		return {};
+	}
+
+	const int schemeSeparatorPosition(rule.indexOf(QLatin1String("://")));
+
+	if (schemeSeparatorPosition < 0)
+	{
+		return {};
+	}
+
+	const QString pathAndDomain(rule.mid(schemeSeparatorPosition + 3));
+	QString host(pathAndDomain.left(pathAndDomain.indexOf(QLatin1Char('/'))).toLower());
+
+	if (isMatchRule && host.startsWith(QLatin1String("*.")))
+	{
+		host = host.mid(2);
+	}
+
+	if (host.contains(QLatin1Char('@')) || host.contains(QLatin1Char('*')) || host.contains(QLatin1String(".tld")))
+	{
+		return {};
+	}
+
+	return host.section(QLatin1Char(':'), 0, 0);
+}
+
+UserScript::UrlRule UserScript::compileRule(const QString &rule)
+{
+	UrlRule compiledRule;
+
+	if (rule.length() > 1 && rule.startsWith(QLatin1Char('/')) && rule.endsWith(QLatin1Char('/')))
+	{
+		compiledRule.expression = QRegularExpression(rule.mid(1, rule.length() - 2));
+		compiledRule.expression.optimize();
+
+		return compiledRule;
+	}
+
+	QString pattern(rule);
+	bool useExactMatch(true);
+
+	if (pattern.endsWith(QLatin1Char('*')))
+	{
+		useExactMatch = false;
+
+		pattern.chop(1);
+	}
+
+	QString expression(QLatin1String("^"));
+	QStringList topLevelDomainSegments;
+	int position(0);
+
+	while (position < pattern.length())
+	{
+		const int wildcardPosition(pattern.indexOf(QLatin1Char('*'), position));
+		const int topLevelDomainPosition(pattern.indexOf(QLatin1String(".tld"), position, Qt::CaseInsensitive));
+		int nextPosition(pattern.length());
+
+		if (wildcardPosition >= 0)
+		{
+			nextPosition = wildcardPosition;
+		}
+
+		if (topLevelDomainPosition >= 0 && topLevelDomainPosition < nextPosition)
+		{
+			nextPosition = topLevelDomainPosition;
+		}
+
+		expression.append(QRegularExpression::escape(pattern.mid(position, (nextPosition - position))));
+
+		if (nextPosition == pattern.length())
+		{
+			break;
+		}
+
+		if (nextPosition == wildcardPosition)
+		{
+			expression.append(QLatin1String("(?:.+)"));
+
+			position = (nextPosition + 1);
+		}
+		else
+		{
+			topLevelDomainSegments.append(expression);
+
+			expression.clear();
+
+			position = (nextPosition + 4);
+		}
+	}
+
+	if (useExactMatch)
+	{
+		expression.append(QLatin1Char('$'));
+	}
+
+	if (topLevelDomainSegments.isEmpty())
+	{
+		compiledRule.expression = QRegularExpression(expression);
+		compiledRule.expression.optimize();
+	}
+	else
+	{
+		topLevelDomainSegments.append(expression);
+
+		compiledRule.topLevelDomainSegments = topLevelDomainSegments;
+	}
+
+	return compiledRule;
+}
+
 QVector<UserScript*> UserScript::getUserScriptsForUrl(const QUrl &url, UserScript::InjectionTime injectionTime, bool isSubFrame)
 {
-	const QStringList scriptNames(AddonsManager::getUserScripts());
-	QVector<UserScript*> scripts;
+	if (!m_isIndexValid)
+	{
+		buildIndex();
+	}
 
-	for (int i = 0; i < scriptNames.count(); ++i)
+	QVector<UserScript*> candidates(m_genericIndex);
+	QString host(url.host().toLower());
+
+	while (!host.isEmpty())
 	{
-		UserScript *script(AddonsManager::getUserScript(scriptNames.at(i)));
+		if (m_hostIndex.contains(host))
+		{
+			candidates += m_hostIndex[host];
+		}
+
+		const int separatorPosition(host.indexOf(QLatin1Char('.')));
+
+		if (separatorPosition < 0)
+		{
+			break;
+		}
+
+		host = host.mid(separatorPosition + 1);
+	}
+
+	QMap<QString, UserScript*> scripts;
+
+	for (int i = 0; i < candidates.count(); ++i)
+	{
+		UserScript *script(candidates.at(i));
 
 		if (script->isEnabled() && (injectionTime == AnyTime || script->getInjectionTime() == injectionTime) && (!isSubFrame || script->shouldRunOnSubFrames()) && script->isEnabledForUrl(url))
 		{
-			scripts.append(script);
+			scripts[script->getName()] = script;
 		}
 	}
 
-	return scripts;
+	return scripts.values().toVector();
 }
 
 UserScript::InjectionTime UserScript::getInjectionTime() const
@@ -383,19 +636,19 @@ bool UserScript::isEnabledForUrl(const QUrl &url)
 		return false;
 	}
 
-	bool isEnabled(!(m_includeRules.length() > 0 || m_matchRules.length() > 0));
+	bool isEnabled(!(m_compiledIncludeRules.length() > 0 || m_compiledMatchRules.length() > 0));
 
-	if (checkUrl(url, m_matchRules))
+	if (checkUrl(url, m_compiledMatchRules))
 	{
 		isEnabled = true;
 	}
 
-	if (!isEnabled && checkUrl(url, m_includeRules))
+	if (!isEnabled && checkUrl(url, m_compiledIncludeRules))
 	{
 		isEnabled = true;
 	}
 
-	if (isEnabled && checkUrl(url, m_excludeRules))
+	if (isEnabled && checkUrl(url, m_compiledExcludeRules))
 	{
 		isEnabled = false;
 	}
@@ -408,33 +661,40 @@ bool UserScript::canRemove() const
 	return true;
 }
 
-bool UserScript::checkUrl(const QUrl &url, const QStringList &rules) const
+bool UserScript::checkUrl(const QUrl &url, const QVector<UrlRule> &rules) const
 {
+	if (rules.isEmpty())
+	{
+		return false;
+	}
+
+	const QString urlString(url.url());
+
 	for (int i = 0; i < rules.count(); ++i)
 	{
-		QString rule(rules.at(i));
+		const UrlRule &rule(rules.at(i));
 
-		if (rule.startsWith(QLatin1Char('/')) && rule.endsWith(QLatin1Char('/')))
+		if (rule.topLevelDomainSegments.isEmpty())
 		{
-			return QRegularExpression(rule.mid(1, rule.length() - 2)).match(url.url()).hasMatch();
-		}
+			if (rule.expression.match(urlString).hasMatch())
+			{
+				return true;
+			}
 
-		if (rule.contains(QLatin1String(".tld"), Qt::CaseInsensitive))
-		{
-			rule.replace(QLatin1String(".tld"), url.topLevelDomain(), Qt::CaseInsensitive);
+			continue;
 		}
 
-		bool useExactMatch(true);
+		const QString topLevelDomain(url.topLevelDomain().toLower());
 
-		if (rule.endsWith(QLatin1Char('*')))
+		if (!rule.topLevelDomainExpressions.contains(topLevelDomain))
 		{
-			useExactMatch = false;
-			rule = rule.left(rule.length() - 1);
-		}
+			QRegularExpression expression(rule.topLevelDomainSegments.join(QRegularExpression::escape(topLevelDomain)));
+			expression.optimize();
 
-		const QString result(checkUrlSubString(rule, url.url(), {}));
+			rule.topLevelDomainExpressions[topLevelDomain] = expression;
+		}
 
-		if (!result.isEmpty() && ((useExactMatch && url.url() == result) || (!useExactMatch && url.url().startsWith(result))))
+		if (rule.topLevelDomainExpressions[topLevelDomain].match(urlString).hasMatch())
 		{
 			return true;
 		}
@@ -23,6 +23,8 @@
 
 #include "AddonsManager.h"
 
+#include <QtCore/QRegularExpression>
+
 namespace Otter
 {
 
@@ -42,6 +44,9 @@ public:
 	};
 
 	explicit UserScript(const QString &path, const QUrl &url = {}, QObject *parent = nullptr);
+	~UserScript();
+
+	static void invalidateIndex();
 
 	QString getName() const override;
 	QString getTitle() const override;
@@ -67,8 +72,19 @@ public slots:
 	void reload();
 
 protected:
-	QString checkUrlSubString(const QString &rule, const QString &urlSubString, QString generatedUrl, int position = 0) const;
-	bool checkUrl(const QUrl &url, const QStringList &rules) const;
+	struct UrlRule final
+	{
+		QRegularExpression expression;
+		QStringList topLevelDomainSegments;
+		mutable QHash<QString, QRegularExpression> topLevelDomainExpressions;
+	};
+
+	void addToIndex();
+	void removeFromIndex();
+	static void buildIndex();
+	static QString getRuleHost(const QString &rule, bool isMatchRule);
+	static UrlRule compileRule(const QString &rule);
+	bool checkUrl(const QUrl &url, const QVector<UrlRule> &rules) const;
 
 private:
 	IconFetchJob *m_iconFetchJob;
@@ -85,8 +101,17 @@ private:
 	QStringList m_excludeRules;
 	QStringList m_includeRules;
 	QStringList m_matchRules;
+	QStringList m_indexedHosts;
+	QVector<UrlRule> m_compiledExcludeRules;
+	QVector<UrlRule> m_compiledIncludeRules;
+	QVector<UrlRule> m_compiledMatchRules;
 	InjectionTime m_injectionTime;
 	bool m_shouldRunOnSubFrames;
+	bool m_isIndexed;
+
+	static QHash<QString, QVector<UserScript*> > m_hostIndex;
+	static QVector<UserScript*> m_genericIndex;
+	static bool m_isIndexValid;
 
 signals:
 	void metaDataChanged();
@@ -42,6 +42,16 @@ WebBackend::WebBackend(QObject *parent) : QObject(parent), Addon()
 {
 }
 
+void WebBackend::preconnect(const QUrl &url)
+{
+	Q_UNUSED(url)
+}
+
+QString WebBackend::createReport() const
+{
+	return {};
+}
+
 QVector<SpellCheckManager::DictionaryInformation> WebBackend::getDictionaries() const
 {
 	return {};
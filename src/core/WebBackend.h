@@ -75,7 +75,9 @@ public:
 
 	explicit WebBackend(QObject *parent = nullptr);
 
+	virtual void preconnect(const QUrl &url);
 	virtual WebWidget* createWidget(const QVariantMap &parameters, ContentsWidget *parent = nullptr) = 0;
+	virtual QString createReport() const;
 	virtual QString getEngineVersion() const = 0;
 	virtual QString getSslVersion() const = 0;
 	virtual QString getUserAgent(const QString &pattern = {}) const = 0;
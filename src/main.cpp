@@ -21,6 +21,7 @@
 #include "core/Application.h"
 #include "core/SessionsManager.h"
 #include "core/SettingsManager.h"
+#include "core/StartupManager.h"
 #include "ui/MainWindow.h"
 #include "ui/StartupDialog.h"
 #ifdef OTTER_ENABLE_CRASHREPORTS
@@ -214,5 +215,13 @@ int main(int argc, char *argv[])
 		Application::createWindow(parameters);
 	}
 
+	StartupManager::markStartupFinished();
+
+	if (Application::getCommandLineParser()->isSet(QLatin1String("startup-timeline")))
+	{
+		QTextStream stream(stdout);
+		stream << StartupManager::createReport();
+	}
+
 	return application.exec();
 }
@@ -184,7 +184,7 @@ void QtWebEnginePage::handleLoadFinished()
 				}
 			}
 
-			const QStringList blockedRequests(qobject_cast<QtWebEngineWebBackend*>(m_widget->getBackend())->getBlockedElements(url.host()));
+			const QStringList blockedRequests(qobject_cast<QtWebEngineWebBackend*>(m_widget->getBackend())->getBlockedElements(url));
 
 			if (!blockedRequests.isEmpty())
 			{
@@ -27,86 +27,199 @@
 
 #include <QtCore/QCoreApplication>
 
+#define BLOCKED_ELEMENTS_LIMIT 1000
+
 namespace Otter
 {
 
 QtWebEngineUrlRequestInterceptor::QtWebEngineUrlRequestInterceptor(QObject *parent) : QWebEngineUrlRequestInterceptor(parent),
-	m_clearTimer(0),
-	m_areImagesEnabled(SettingsManager::getOption(SettingsManager::Permissions_EnableImagesOption).toString() != QLatin1String("disabled"))
+	m_clearTimer(0)
 {
 	m_clearTimer = startTimer(1800000);
 
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &QtWebEngineUrlRequestInterceptor::handleOptionChanged);
-	connect(SettingsManager::getInstance(), &SettingsManager::hostOptionChanged, this, &QtWebEngineUrlRequestInterceptor::handleOptionChanged);
+	connect(SettingsManager::getInstance(), &SettingsManager::hostOptionChanged, this, &QtWebEngineUrlRequestInterceptor::handleHostOptionChanged);
+	connect(ContentFiltersManager::getInstance(), &ContentFiltersManager::profileModified, this, &QtWebEngineUrlRequestInterceptor::handleProfileModified);
 }
 
 void QtWebEngineUrlRequestInterceptor::timerEvent(QTimerEvent *event)
 {
 	if (event->timerId() == m_clearTimer)
 	{
-		clearContentBlockingInformation();
+		m_policiesMutex.lock();
+
+		QHash<QString, HostPolicy>::iterator iterator(m_policies.begin());
+
+		while (iterator != m_policies.end())
+		{
+			if (iterator->isUsed)
+			{
+				iterator->isUsed = false;
+
+				++iterator;
+			}
+			else
+			{
+				iterator = m_policies.erase(iterator);
+			}
+		}
+
+		m_policiesMutex.unlock();
 	}
 }
 
-void QtWebEngineUrlRequestInterceptor::clearContentBlockingInformation()
+void QtWebEngineUrlRequestInterceptor::invalidatePolicies(int identifier, const QString &host)
 {
-	m_blockedElements.clear();
-	m_contentBlockingProfiles.clear();
+	const bool isContentBlockingOption(identifier == SettingsManager::ContentBlocking_EnableContentBlockingOption || identifier == SettingsManager::ContentBlocking_ProfilesOption);
+
+	if (!isContentBlockingOption && identifier != SettingsManager::Network_DoNotTrackPolicyOption && identifier != SettingsManager::Network_EnableReferrerOption && identifier != SettingsManager::Permissions_EnableImagesOption)
+	{
+		return;
+	}
+
+	const QString wildcardSuffix(host.startsWith(QLatin1String("*.")) ? host.mid(1) : QString());
+
+	m_policiesMutex.lock();
+
+	QHash<QString, HostPolicy>::iterator iterator;
+
+	for (iterator = m_policies.begin(); iterator != m_policies.end(); ++iterator)
+	{
+		if (!host.isEmpty() && iterator.key() != host && (wildcardSuffix.isEmpty() || !iterator.key().endsWith(wildcardSuffix)))
+		{
+			continue;
+		}
+
+		iterator->isUpToDate = false;
+
+		if (isContentBlockingOption)
+		{
+			iterator->blockedElements.clear();
+		}
+	}
+
+	m_policiesMutex.unlock();
 }
 
-void QtWebEngineUrlRequestInterceptor::handleOptionChanged(int identifier)
+void QtWebEngineUrlRequestInterceptor::updatePolicy(HostPolicy *policy, const QString &host) const
 {
-	switch (identifier)
+	if (SettingsManager::getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption, host).toBool())
+	{
+		policy->contentBlockingProfiles = ContentFiltersManager::getProfileIdentifiers(SettingsManager::getOption(SettingsManager::ContentBlocking_ProfilesOption, host).toStringList());
+	}
+	else
 	{
-		case SettingsManager::ContentBlocking_ProfilesOption:
-			clearContentBlockingInformation();
+		policy->contentBlockingProfiles.clear();
+	}
 
-			break;
-		case SettingsManager::Permissions_EnableImagesOption:
-			m_areImagesEnabled = (SettingsManager::getOption(SettingsManager::Permissions_EnableImagesOption).toString() != QLatin1String("disabled"));
+	const QString doNotTrackPolicyValue(SettingsManager::getOption(SettingsManager::Network_DoNotTrackPolicyOption, host).toString());
 
-			break;
-		default:
-			break;
+	if (doNotTrackPolicyValue == QLatin1String("allow"))
+	{
+		policy->doNotTrackPolicy = NetworkManagerFactory::AllowToTrackPolicy;
+	}
+	else if (doNotTrackPolicyValue == QLatin1String("doNotAllow"))
+	{
+		policy->doNotTrackPolicy = NetworkManagerFactory::DoNotAllowToTrackPolicy;
+	}
+	else
+	{
+		policy->doNotTrackPolicy = NetworkManagerFactory::SkipTrackPolicy;
 	}
+
+	policy->areImagesEnabled = (SettingsManager::getOption(SettingsManager::Permissions_EnableImagesOption, host).toString() != QLatin1String("disabled"));
+	policy->canSendReferrer = SettingsManager::getOption(SettingsManager::Network_EnableReferrerOption, host).toBool();
+	policy->isUpToDate = true;
 }
 
-QStringList QtWebEngineUrlRequestInterceptor::getBlockedElements(const QString &domain) const
+void QtWebEngineUrlRequestInterceptor::handleOptionChanged(int identifier)
 {
-	return m_blockedElements.value(domain);
+	invalidatePolicies(identifier);
 }
 
-void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo &request)
+void QtWebEngineUrlRequestInterceptor::handleProfileModified(const QString &profile)
 {
-	if (!m_areImagesEnabled && request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeImage)
+	const QVector<int> identifiers(ContentFiltersManager::getProfileIdentifiers({profile}));
+
+	if (identifiers.isEmpty())
 	{
-		request.block(true);
+		invalidatePolicies(SettingsManager::ContentBlocking_ProfilesOption);
 
 		return;
 	}
 
-	if (!m_contentBlockingProfiles.contains(request.firstPartyUrl().host()))
-	{
-		const QString host(Utils::extractHost(request.firstPartyUrl()));
+	const int identifier(identifiers.first());
 
-		if (SettingsManager::getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption, host).toBool())
-		{
-			m_contentBlockingProfiles[host] = ContentFiltersManager::getProfileIdentifiers(SettingsManager::getOption(SettingsManager::ContentBlocking_ProfilesOption, host).toStringList());
-		}
-		else
+	m_policiesMutex.lock();
+
+	QHash<QString, HostPolicy>::iterator iterator;
+
+	for (iterator = m_policies.begin(); iterator != m_policies.end(); ++iterator)
+	{
+		if (!iterator->isUpToDate || iterator->contentBlockingProfiles.contains(identifier))
 		{
-			m_contentBlockingProfiles[host] = {};
+			iterator->isUpToDate = false;
+			iterator->blockedElements.clear();
 		}
 	}
 
-	const QVector<int> contentBlockingProfiles(m_contentBlockingProfiles.value(request.firstPartyUrl().host()));
+	m_policiesMutex.unlock();
+}
+
+void QtWebEngineUrlRequestInterceptor::handleHostOptionChanged(int identifier, const QVariant &value, const QString &host)
+{
+	Q_UNUSED(value)
+
+	invalidatePolicies(identifier, host);
+}
+
+QStringList QtWebEngineUrlRequestInterceptor::getBlockedElements(const QUrl &url) const
+{
+	m_policiesMutex.lock();
+
+	const QStringList blockedElements(m_policies.value(Utils::extractHost(url)).blockedElements.values());
+
+	m_policiesMutex.unlock();
+
+	return blockedElements;
+}
+
+void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo &request)
+{
+	const QString host(Utils::extractHost(request.firstPartyUrl()));
+	const QWebEngineUrlRequestInfo::ResourceType requestResourceType(request.resourceType());
+
+	m_policiesMutex.lock();
+
+	HostPolicy &policy(m_policies[host]);
+
+	if (!policy.isUpToDate)
+	{
+		updatePolicy(&policy, host);
+	}
+
+	policy.isUsed = true;
+
+	const QVector<int> contentBlockingProfiles(policy.contentBlockingProfiles);
+	const NetworkManagerFactory::DoNotTrackPolicy doNotTrackPolicy(policy.doNotTrackPolicy);
+	const bool areImagesEnabled(policy.areImagesEnabled);
+	const bool canSendReferrer(policy.canSendReferrer);
+
+	m_policiesMutex.unlock();
+
+	if (!areImagesEnabled && requestResourceType == QWebEngineUrlRequestInfo::ResourceTypeImage)
+	{
+		request.block(true);
+
+		return;
+	}
 
 	if (!contentBlockingProfiles.isEmpty())
 	{
 		NetworkManager::ResourceType resourceType(NetworkManager::OtherType);
 		bool storeBlockedUrl(true);
 
-		switch (request.resourceType())
+		switch (requestResourceType)
 		{
 			case QWebEngineUrlRequestInfo::ResourceTypeMainFrame:
 				resourceType = NetworkManager::MainFrameType;
@@ -145,6 +258,8 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 
 				break;
 			default:
+				resourceType = NetworkManager::getPathResourceType(request.requestUrl().path());
+
 				break;
 		}
 
@@ -156,9 +271,18 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 
 			Console::addMessage(QCoreApplication::translate("main", "Request blocked by rule from profile %1:\n%2").arg(profile ? profile->getTitle() : QCoreApplication::translate("main", "(Unknown)")).arg(result.rule), Console::NetworkCategory, Console::LogLevel, request.requestUrl().toString(), -1);
 
-			if (storeBlockedUrl && !m_blockedElements.value(request.firstPartyUrl().host()).contains(request.requestUrl().url()))
+			if (storeBlockedUrl)
 			{
-				m_blockedElements[request.firstPartyUrl().host()].append(request.requestUrl().url());
+				m_policiesMutex.lock();
+
+				QSet<QString> &blockedElements(m_policies[host].blockedElements);
+
+				if (blockedElements.count() < BLOCKED_ELEMENTS_LIMIT)
+				{
+					blockedElements.insert(request.requestUrl().url());
+				}
+
+				m_policiesMutex.unlock();
 			}
 
 			request.block(true);
@@ -167,14 +291,12 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 		}
 	}
 
-	const NetworkManagerFactory::DoNotTrackPolicy doNotTrackPolicy(NetworkManagerFactory::getDoNotTrackPolicy());
-
 	if (doNotTrackPolicy != NetworkManagerFactory::SkipTrackPolicy)
 	{
 		request.setHttpHeader(QStringLiteral("DNT").toLatin1(), ((doNotTrackPolicy == NetworkManagerFactory::DoNotAllowToTrackPolicy) ? QStringLiteral("1") : QStringLiteral("0")).toLatin1());
 	}
 
-	if (!SettingsManager::getOption(SettingsManager::Network_EnableReferrerOption).toBool())
+	if (!canSendReferrer)
 	{
 		request.setHttpHeader(QStringLiteral("Referer").toLatin1(), QByteArray());
 	}
@@ -21,7 +21,11 @@
 #ifndef OTTER_QTWEBENGINEURLREQUESTINTERCEPTOR_H
 #define OTTER_QTWEBENGINEURLREQUESTINTERCEPTOR_H
 
-#include <QtCore/QMap>
+#include "../../../../core/NetworkManagerFactory.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QVector>
 #include <QtWebEngineCore/QWebEngineUrlRequestInterceptor>
 
@@ -36,20 +40,33 @@ public:
 	explicit QtWebEngineUrlRequestInterceptor(QObject *parent = nullptr);
 
 	void interceptRequest(QWebEngineUrlRequestInfo &request) override;
-	QStringList getBlockedElements(const QString &domain) const;
+	QStringList getBlockedElements(const QUrl &url) const;
 
 protected:
+	struct HostPolicy final
+	{
+		QVector<int> contentBlockingProfiles;
+		QSet<QString> blockedElements;
+		NetworkManagerFactory::DoNotTrackPolicy doNotTrackPolicy = NetworkManagerFactory::SkipTrackPolicy;
+		bool areImagesEnabled = true;
+		bool canSendReferrer = true;
+		bool isUpToDate = false;
+		bool isUsed = true;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
-	void clearContentBlockingInformation();
+	void invalidatePolicies(int identifier, const QString &host = {});
+	void updatePolicy(HostPolicy *policy, const QString &host) const;
 
 protected slots:
 	void handleOptionChanged(int identifier);
+	void handleProfileModified(const QString &profile);
+	void handleHostOptionChanged(int identifier, const QVariant &value, const QString &host);
 
 private:
-	QMap<QString, QStringList> m_blockedElements;
-	QMap<QString, QVector<int> > m_contentBlockingProfiles;
+	QHash<QString, HostPolicy> m_policies;
+	mutable QMutex m_policiesMutex;
 	int m_clearTimer;
-	bool m_areImagesEnabled;
 };
 
 }
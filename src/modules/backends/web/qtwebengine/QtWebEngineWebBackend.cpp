@@ -281,9 +281,9 @@ QString QtWebEngineWebBackend::getUserAgent(const QString &pattern) const
 	return ((userAgent.value.isEmpty()) ? QString() : getUserAgent(userAgent.value));
 }
 
-QStringList QtWebEngineWebBackend::getBlockedElements(const QString &domain) const
+QStringList QtWebEngineWebBackend::getBlockedElements(const QUrl &url) const
 {
-	return (m_requestInterceptor ? m_requestInterceptor->getBlockedElements(domain) : QStringList());
+	return (m_requestInterceptor ? m_requestInterceptor->getBlockedElements(url) : QStringList());
 }
 
 QUrl QtWebEngineWebBackend::getHomePage() const
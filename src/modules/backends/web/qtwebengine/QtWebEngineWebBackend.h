@@ -46,7 +46,7 @@ public:
 	QString getEngineVersion() const override;
 	QString getSslVersion() const override;
 	QString getUserAgent(const QString &pattern = {}) const override;
-	QStringList getBlockedElements(const QString &domain) const;
+	QStringList getBlockedElements(const QUrl &url) const;
 	QUrl getHomePage() const override;
 	WebBackend::BackendCapabilities getCapabilities() const override;
 	bool requestThumbnail(const QUrl &url, const QSize &size) override;
@@ -23,6 +23,7 @@
 #include "../../../../core/BookmarksManager.h"
 #include "../../../../core/Console.h"
 #include "../../../../core/GesturesManager.h"
+#include "../../../../core/HistoryManager.h"
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
 #include "../../../../core/NotesManager.h"
@@ -1125,6 +1126,11 @@ void QtWebEngineWebWidget::notifyUrlChanged(const QUrl &url)
 
 void QtWebEngineWebWidget::notifyIconChanged()
 {
+	if (!isPrivate())
+	{
+		HistoryManager::setIcon(getUrl(), m_page->icon());
+	}
+
 	emit iconChanged(getIcon());
 }
 
@@ -23,13 +23,17 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QMimeDatabase>
+#include <QtCore/QTimer>
+
+#define LISTING_BATCH_SIZE 250
 
 namespace Otter
 {
 
 QtWebKitFtpListingNetworkReply::QtWebKitFtpListingNetworkReply(const QNetworkRequest &request, QObject *parent) : ListingNetworkReply(request, parent),
 	m_ftp(new QFtp(this)),
-	m_offset(0)
+	m_offset(0),
+	m_processedEntries(0)
 {
 	connect(m_ftp, &QFtp::listInfo, this, &QtWebKitFtpListingNetworkReply::addEntry);
 	connect(m_ftp, &QFtp::readyRead, this, &QtWebKitFtpListingNetworkReply::processData);
@@ -110,11 +114,8 @@ void QtWebKitFtpListingNetworkReply::processCommand(int command, bool isError)
 			{
 				open(ReadOnly | Unbuffered);
 
-				QUrl url(request().url());
-				QMimeDatabase mimeDatabase;
-				QVector<ListingEntry> entries;
+				QUrl url(request().url().adjusted(QUrl::RemoveQuery));
 				QVector<NavigationEntry> navigation;
-				const QVector<QUrlInfo> rawEntries(m_symlinks + m_directories + m_files);
 
 				if (url.path().isEmpty())
 				{
@@ -141,41 +142,22 @@ void QtWebKitFtpListingNetworkReply::processCommand(int command, bool isError)
 					url = url.adjusted(QUrl::RemoveFilename);
 				}
 
-				for (int i = 0; i < rawEntries.count(); ++i)
-				{
-					ListingEntry entry;
-					entry.name = rawEntries.at(i).name();
-					entry.url = Utils::normalizeUrl(request().url()).url() + QLatin1Char('/') + rawEntries.at(i).name();
-					entry.timeModified = rawEntries.at(i).lastModified();
-					entry.type = (rawEntries.at(i).isSymLink() ? ListingEntry::UnknownType : (rawEntries.at(i).isDir() ? ListingEntry::DirectoryType : ListingEntry::FileType));
-					entry.size = rawEntries.at(i).size();
-					entry.isSymlink = rawEntries.at(i).isSymLink();
-
-					if (rawEntries.at(i).isSymLink())
-					{
-						entry.mimeType = mimeDatabase.mimeTypeForName(QLatin1String("text/uri-list"));
-					}
-					else if (rawEntries.at(i).isDir())
-					{
-						entry.mimeType = mimeDatabase.mimeTypeForName(QLatin1String("inode/directory"));
-					}
-					else
-					{
-						entry.mimeType = mimeDatabase.mimeTypeForUrl(request().url().url() + rawEntries.at(i).name());
-					}
+				const QUrl directoryUrl(request().url().adjusted(QUrl::RemoveQuery));
 
-					entries.append(entry);
-				}
+				m_pendingEntries = (m_symlinks + m_directories + m_files);
+				m_content = createListingHeader(directoryUrl.toString() + (directoryUrl.path().endsWith(QLatin1Char('/')) ? QChar() : QLatin1Char('/')), navigation);
 
-				m_content = createListing(request().url().toString() + (request().url().path().endsWith(QLatin1Char('/')) ? QChar() : QLatin1Char('/')), navigation, entries);
+				m_symlinks.clear();
+				m_directories.clear();
+				m_files.clear();
 
 				setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
-				setHeader(QNetworkRequest::ContentLengthHeader, QVariant(m_content.size()));
 
 				emit readyRead();
-				emit finished();
 
 				m_ftp->close();
+
+				QTimer::singleShot(0, this, &QtWebKitFtpListingNetworkReply::processEntries);
 			}
 
 			break;
@@ -210,6 +192,69 @@ void QtWebKitFtpListingNetworkReply::addEntry(const QUrlInfo &entry)
 	}
 }
 
+void QtWebKitFtpListingNetworkReply::processEntries()
+{
+	if (isFinished())
+	{
+		return;
+	}
+
+	const QUrl url(Utils::normalizeUrl(request().url()).adjusted(QUrl::RemoveQuery));
+	const int limit(qMin(getEntriesLimit(), m_pendingEntries.count()));
+	const int amount(qMin((m_processedEntries + LISTING_BATCH_SIZE), limit));
+	QMimeDatabase mimeDatabase;
+	QVector<ListingEntry> entries;
+	entries.reserve(amount - m_processedEntries);
+
+	for (int i = m_processedEntries; i < amount; ++i)
+	{
+		const QUrlInfo rawEntry(m_pendingEntries.at(i));
+		ListingEntry entry;
+		entry.name = rawEntry.name();
+		entry.url = url.url() + QLatin1Char('/') + rawEntry.name();
+		entry.timeModified = rawEntry.lastModified();
+		entry.type = (rawEntry.isSymLink() ? ListingEntry::UnknownType : (rawEntry.isDir() ? ListingEntry::DirectoryType : ListingEntry::FileType));
+		entry.size = rawEntry.size();
+		entry.isSymlink = rawEntry.isSymLink();
+
+		if (rawEntry.isSymLink())
+		{
+			entry.mimeType = mimeDatabase.mimeTypeForName(QLatin1String("text/uri-list"));
+		}
+		else if (rawEntry.isDir())
+		{
+			entry.mimeType = mimeDatabase.mimeTypeForName(QLatin1String("inode/directory"));
+		}
+		else
+		{
+			entry.mimeType = mimeDatabase.mimeTypeForUrl(request().url().adjusted(QUrl::RemoveQuery).url() + rawEntry.name());
+		}
+
+		entries.append(entry);
+	}
+
+	m_processedEntries = amount;
+	m_content.append(createListingEntries(entries));
+
+	if (m_processedEntries < limit)
+	{
+		emit readyRead();
+
+		QTimer::singleShot(0, this, &QtWebKitFtpListingNetworkReply::processEntries);
+
+		return;
+	}
+
+	m_content.append(createListingFooter(m_pendingEntries.count() - m_processedEntries));
+
+	m_pendingEntries.clear();
+
+	setFinished(true);
+
+	emit readyRead();
+	emit finished();
+}
+
 void QtWebKitFtpListingNetworkReply::processData()
 {
 	m_content += m_ftp->readAll();
@@ -221,6 +266,10 @@ void QtWebKitFtpListingNetworkReply::abort()
 {
 	m_ftp->close();
 
+	m_pendingEntries.clear();
+
+	setFinished(true);
+
 	emit finished();
 }
 
@@ -242,7 +291,7 @@ qint64 QtWebKitFtpListingNetworkReply::readData(char *data, qint64 maxSize)
 		return number;
 	}
 
-	return -1;
+	return ((isFinished() || m_pendingEntries.isEmpty()) ? -1 : 0);
 }
 
 bool QtWebKitFtpListingNetworkReply::isSequential() const
@@ -46,6 +46,7 @@ protected slots:
 	void processCommand(int command, bool isError);
 	void addEntry(const QUrlInfo &entry);
 	void processData();
+	void processEntries();
 
 private:
 	QFtp *m_ftp;
@@ -53,7 +54,9 @@ private:
 	QVector<QUrlInfo> m_directories;
 	QVector<QUrlInfo> m_files;
 	QVector<QUrlInfo> m_symlinks;
+	QVector<QUrlInfo> m_pendingEntries;
 	qint64 m_offset;
+	int m_processedEntries;
 
 signals:
 	void listingError();
@@ -19,38 +19,234 @@
 
 #include "QtWebKitHistoryInterface.h"
 #include "../../../../core/HistoryManager.h"
+#include "../../../../core/Utils.h"
 
 namespace Otter
 {
 
-QtWebKitHistoryInterface::QtWebKitHistoryInterface(QObject *parent) : QWebHistoryInterface(parent)
+QtWebKitHistoryInterface::QtWebKitHistoryInterface(QObject *parent) : QWebHistoryInterface(parent),
+	m_amount(0),
+	m_occupiedAmount(0)
 {
-	connect(HistoryManager::getBrowsingHistoryModel(), &HistoryModel::cleared, this, &QtWebKitHistoryInterface::clear);
+	HistoryModel *model(HistoryManager::getBrowsingHistoryModel());
+
+	resize(1024);
+
+	for (int i = 0; i < model->rowCount(); ++i)
+	{
+		handleEntryAdded(static_cast<HistoryModel::Entry*>(model->item(i, 0)));
+	}
+
+	connect(model, &HistoryModel::cleared, this, &QtWebKitHistoryInterface::clear);
+	connect(model, &HistoryModel::entryAdded, this, &QtWebKitHistoryInterface::handleEntryAdded);
+	connect(model, &HistoryModel::entryUrlModified, this, &QtWebKitHistoryInterface::handleEntryUrlModified);
+	connect(model, &HistoryModel::entryRemoved, this, &QtWebKitHistoryInterface::handleEntryRemoved);
 }
 
 void QtWebKitHistoryInterface::clear()
 {
-	m_urls.clear();
+	m_hashes.fill(m_emptyHash);
+	m_visitedHashes.clear();
+
+	m_amount = 0;
+	m_occupiedAmount = 0;
 }
 
-void QtWebKitHistoryInterface::addHistoryEntry(const QString &url)
+void QtWebKitHistoryInterface::insertHash(quint64 hash)
+{
+	if (((m_occupiedAmount + 1) * 4) >= (m_hashes.count() * 3))
+	{
+		resize((m_amount * 2) > m_hashes.count() ? (m_hashes.count() * 2) : m_hashes.count());
+	}
+
+	const int mask(m_hashes.count() - 1);
+	int index(static_cast<int>(hash & static_cast<quint64>(mask)));
+	int removedIndex(-1);
+
+	while (m_hashes.at(index) != m_emptyHash)
+	{
+		if (m_hashes.at(index) == hash)
+		{
+			return;
+		}
+
+		if (m_hashes.at(index) == m_removedHash && removedIndex < 0)
+		{
+			removedIndex = index;
+		}
+
+		index = ((index + 1) & mask);
+	}
+
+	if (removedIndex >= 0)
+	{
+		index = removedIndex;
+	}
+	else
+	{
+		++m_occupiedAmount;
+	}
+
+	m_hashes[index] = hash;
+
+	++m_amount;
+}
+
+void QtWebKitHistoryInterface::removeHash(quint64 hash)
+{
+	const int mask(m_hashes.count() - 1);
+	int index(static_cast<int>(hash & static_cast<quint64>(mask)));
+
+	while (m_hashes.at(index) != m_emptyHash)
+	{
+		if (m_hashes.at(index) == hash)
+		{
+			m_hashes[index] = m_removedHash;
+
+			--m_amount;
+
+			return;
+		}
+
+		index = ((index + 1) & mask);
+	}
+}
+
+void QtWebKitHistoryInterface::resize(int capacity)
+{
+	const QVector<quint64> hashes(m_hashes);
+
+	m_hashes = QVector<quint64>(capacity, m_emptyHash);
+	m_amount = 0;
+	m_occupiedAmount = 0;
+
+	for (int i = 0; i < hashes.count(); ++i)
+	{
+		if (hashes.at(i) != m_emptyHash && hashes.at(i) != m_removedHash)
+		{
+			insertHash(hashes.at(i));
+		}
+	}
+}
+
+void QtWebKitHistoryInterface::handleEntryAdded(HistoryModel::Entry *entry)
+{
+	if (entry)
+	{
+		insertHash(hashUrl(entry->getUrl()));
+	}
+}
+
+void QtWebKitHistoryInterface::handleEntryUrlModified(HistoryModel::Entry *entry, const QUrl &previousUrl)
 {
-	if (m_urls.contains(url))
+	if (!entry)
 	{
 		return;
 	}
 
-	m_urls.append(url);
+	const QUrl normalizedUrl(Utils::normalizeUrl(previousUrl));
+
+	if (!normalizedUrl.isEmpty() && !HistoryManager::getBrowsingHistoryModel()->hasEntry(normalizedUrl))
+	{
+		removeHash(hashUrl(previousUrl));
+	}
+
+	insertHash(hashUrl(entry->getUrl()));
+}
 
-	if (m_urls.length() > 100)
+void QtWebKitHistoryInterface::handleEntryRemoved(HistoryModel::Entry *entry)
+{
+	if (entry && !HistoryManager::getBrowsingHistoryModel()->hasEntry(Utils::normalizeUrl(entry->getUrl())))
 	{
-		m_urls.removeAt(0);
+		removeHash(hashUrl(entry->getUrl()));
 	}
 }
 
+void QtWebKitHistoryInterface::addHistoryEntry(const QString &url)
+{
+	m_visitedHashes.insert(hashUrl(url));
+}
+
+quint64 QtWebKitHistoryInterface::hashUrl(const QUrl &url)
+{
+	return hashNormalizedUrl(Utils::normalizeUrl(url).toString(QUrl::FullyEncoded));
+}
+
+quint64 QtWebKitHistoryInterface::hashUrl(const QString &url)
+{
+	if (url.contains(QLatin1String("/.")))
+	{
+		return hashUrl(QUrl(url));
+	}
+
+	return hashNormalizedUrl(url);
+}
+
+quint64 QtWebKitHistoryInterface::hashNormalizedUrl(const QString &url)
+{
+	const QChar *data(url.constData());
+	int length(url.length());
+	int queryPosition(-1);
+
+	for (int i = 0; i < length; ++i)
+	{
+		if (data[i] == QLatin1Char('#'))
+		{
+			length = i;
+
+			break;
+		}
+
+		if (data[i] == QLatin1Char('?') && queryPosition < 0)
+		{
+			queryPosition = i;
+		}
+	}
+
+	const int pathEnd((queryPosition < 0) ? length : queryPosition);
+	const int skippedPosition((pathEnd > 0 && data[pathEnd - 1] == QLatin1Char('/')) ? (pathEnd - 1) : -1);
+	quint64 hash(14695981039346656037ULL);
+
+	for (int i = 0; i < length; ++i)
+	{
+		if (i != skippedPosition)
+		{
+			hash ^= data[i].unicode();
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	return ((hash <= m_removedHash) ? (hash + 2) : hash);
+}
+
 bool QtWebKitHistoryInterface::historyContains(const QString &url) const
 {
-	return (m_urls.contains(url) || HistoryManager::hasEntry(url));
+	const quint64 hash(hashUrl(url));
+
+	if (m_visitedHashes.contains(hash))
+	{
+		return true;
+	}
+
+	if (!HistoryManager::isEnabled())
+	{
+		return false;
+	}
+
+	const int mask(m_hashes.count() - 1);
+	int index(static_cast<int>(hash & static_cast<quint64>(mask)));
+
+	while (m_hashes.at(index) != m_emptyHash)
+	{
+		if (m_hashes.at(index) == hash)
+		{
+			return true;
+		}
+
+		index = ((index + 1) & mask);
+	}
+
+	return false;
 }
 
 }
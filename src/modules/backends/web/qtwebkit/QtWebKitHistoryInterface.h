@@ -20,7 +20,9 @@
 #ifndef OTTER_QTWEBKITHISTORYINTERFACE_H
 #define OTTER_QTWEBKITHISTORYINTERFACE_H
 
-#include <QtCore/QStringList>
+#include "../../../../core/HistoryModel.h"
+
+#include <QtCore/QSet>
 #include <QtWebKit/QWebHistoryInterface>
 
 namespace Otter
@@ -36,11 +38,28 @@ public:
 	void addHistoryEntry(const QString &url) override;
 	bool historyContains(const QString &url) const override;
 
+protected:
+	void insertHash(quint64 hash);
+	void removeHash(quint64 hash);
+	void resize(int capacity);
+	static quint64 hashUrl(const QUrl &url);
+	static quint64 hashUrl(const QString &url);
+	static quint64 hashNormalizedUrl(const QString &url);
+
 protected slots:
 	void clear();
+	void handleEntryAdded(HistoryModel::Entry *entry);
+	void handleEntryUrlModified(HistoryModel::Entry *entry, const QUrl &previousUrl);
+	void handleEntryRemoved(HistoryModel::Entry *entry);
 
 private:
-	QStringList m_urls;
+	QVector<quint64> m_hashes;
+	QSet<quint64> m_visitedHashes;
+	int m_amount;
+	int m_occupiedAmount;
+
+	static const quint64 m_emptyHash = 0;
+	static const quint64 m_removedHash = 1;
 };
 
 }
@@ -23,6 +23,7 @@
 #include "QtWebKitCookieJar.h"
 #include "QtWebKitFtpListingNetworkReply.h"
 #include "QtWebKitPage.h"
+#include "QtWebKitTransportManager.h"
 #include "../../../../core/AddonsManager.h"
 #include "../../../../core/Console.h"
 #include "../../../../core/CookieJar.h"
@@ -44,6 +45,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QMimeDatabase>
+#include <QtNetwork/QNetworkCookie>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 
@@ -57,6 +59,7 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_cookieJar(nullptr),
 	m_cookieJarProxy(cookieJarProxy),
 	m_proxyFactory(nullptr),
+	m_transportManager(nullptr),
 	m_baseReply(nullptr),
 	m_contentState(WebWidget::UnknownContentState),
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
@@ -64,7 +67,8 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_bytesReceivedDifference(0),
 	m_loadingSpeedTimer(0),
 	m_areImagesEnabled(true),
-	m_canSendReferrer(true)
+	m_canSendReferrer(true),
+	m_isPrivate(isPrivate)
 {
 	NetworkManagerFactory::initialize();
 
@@ -95,6 +99,8 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 
 	setCookieJar(m_cookieJarProxy);
 
+	m_statisticsTimer.start();
+
 	connect(this, &QtWebKitNetworkManager::finished, this, &QtWebKitNetworkManager::handleRequestFinished);
 	connect(this, &QtWebKitNetworkManager::authenticationRequired, this, &QtWebKitNetworkManager::handleAuthenticationRequired);
 	connect(this, &QtWebKitNetworkManager::proxyAuthenticationRequired, this, &QtWebKitNetworkManager::handleProxyAuthenticationRequired);
@@ -132,7 +138,9 @@ void QtWebKitNetworkManager::resetStatistics()
 	m_contentBlockingProfiles.clear();
 	m_contentBlockingExceptions.clear();
 	m_blockedRequests.clear();
+	m_requestTimings.clear();
 	m_replies.clear();
+	m_pendingRequestTimings.clear();
 	m_headers.clear();
 	m_pageInformation.clear();
 	m_pageInformation[WebWidget::DocumentBytesReceivedInformation] = quint64(0);
@@ -146,6 +154,8 @@ void QtWebKitNetworkManager::resetStatistics()
 	m_isSecureValue = UnknownValue;
 	m_bytesReceivedDifference = 0;
 
+	m_statisticsTimer.start();
+
 	updateLoadingSpeed();
 
 	for (int i = 0; i < keys.count(); ++i)
@@ -168,6 +178,16 @@ void QtWebKitNetworkManager::registerTransfer(QNetworkReply *reply)
 	}
 }
 
+void QtWebKitNetworkManager::addRequestTiming(const NetworkManager::RequestTimingInformation &timing)
+{
+	if (m_requestTimings.count() >= 1000)
+	{
+		m_requestTimings.removeFirst();
+	}
+
+	m_requestTimings.append(timing);
+}
+
 void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
 {
 	QNetworkReply *reply(qobject_cast<QNetworkReply*>(sender()));
@@ -191,6 +211,11 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 		return;
 	}
 
+	if (bytesReceived > 0 && m_pendingRequestTimings.contains(reply) && m_pendingRequestTimings[reply].firstByteTime < 0)
+	{
+		m_pendingRequestTimings[reply].firstByteTime = m_statisticsTimer.nsecsElapsed();
+	}
+
 	const QUrl url(reply->url());
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
@@ -228,6 +253,28 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 
 	const QUrl url(reply->url());
 
+	if (m_pendingRequestTimings.contains(reply))
+	{
+		NetworkManager::RequestTimingInformation timing(m_pendingRequestTimings.take(reply));
+		timing.finishedTime = m_statisticsTimer.nsecsElapsed();
+		timing.bytesReceived = m_replies[reply].first;
+		timing.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		timing.mimeType = reply->header(QNetworkRequest::ContentTypeHeader).toString().section(QLatin1Char(';'), 0, 0).trimmed();
+		timing.isCached = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+
+		if (timing.firstByteTime < 0)
+		{
+			timing.firstByteTime = timing.finishedTime;
+		}
+
+		if (m_proxyFactory)
+		{
+			timing.proxyResolutionDuration = m_proxyFactory->takeQueryDuration(timing.url);
+		}
+
+		addRequestTiming(timing);
+	}
+
 	m_replies.remove(reply);
 
 	setPageInformation(WebWidget::RequestsFinishedInformation, (m_pageInformation[WebWidget::RequestsFinishedInformation].toInt() + 1));
@@ -436,6 +483,14 @@ void QtWebKitNetworkManager::updateLoadingSpeed()
 	m_bytesReceivedDifference = 0;
 }
 
+void QtWebKitNetworkManager::prefetchHost(const QUrl &url)
+{
+	if (!m_proxyFactory && !m_isPrivate)
+	{
+		QtWebKitTransportManager::prefetchHost(url, false);
+	}
+}
+
 void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 {
 	if (!m_backend)
@@ -570,7 +625,7 @@ void QtWebKitNetworkManager::setWidget(QtWebKitWebWidget *widget)
 
 QtWebKitNetworkManager* QtWebKitNetworkManager::clone() const
 {
-	return new QtWebKitNetworkManager((cache() == nullptr), m_cookieJarProxy->clone(nullptr), nullptr);
+	return new QtWebKitNetworkManager(m_isPrivate, m_cookieJarProxy->clone(nullptr), nullptr);
 }
 
 QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
@@ -654,6 +709,39 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		return QNetworkAccessManager::createRequest(QNetworkAccessManager::GetOperation, QNetworkRequest(QUrl()));
 	}
 
+	NetworkManager::RequestTimingInformation timing;
+	timing.url = request.url();
+	timing.startDateTime = QDateTime::currentDateTimeUtc();
+	timing.queuedTime = m_statisticsTimer.nsecsElapsed();
+
+	switch (operation)
+	{
+		case HeadOperation:
+			timing.method = QLatin1String("HEAD");
+
+			break;
+		case PutOperation:
+			timing.method = QLatin1String("PUT");
+
+			break;
+		case PostOperation:
+			timing.method = QLatin1String("POST");
+
+			break;
+		case DeleteOperation:
+			timing.method = QLatin1String("DELETE");
+
+			break;
+		case CustomOperation:
+			timing.method = QString::fromLatin1(request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray());
+
+			break;
+		default:
+			timing.method = QLatin1String("GET");
+
+			break;
+	}
+
 	if (m_widget && (m_contentBlockingExceptions.isEmpty() || !m_contentBlockingExceptions.contains(request.url())))
 	{
 		const QUrl baseUrl(m_widget->isNavigating() ? request.url() : m_widget->getUrl());
@@ -669,6 +757,9 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		{
 			const ContentFiltersManager::CheckResult result(ContentFiltersManager::checkUrl(m_contentBlockingProfiles, baseUrl, request.url(), resourceType));
 
+			timing.resourceType = resourceType;
+			timing.contentBlockingDuration = (m_statisticsTimer.nsecsElapsed() - timing.queuedTime);
+
 			if (result.isBlocked)
 			{
 				const ContentFiltersProfile *profile(ContentFiltersManager::getProfile(result.profile));
@@ -677,7 +768,7 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 				if (resourceType != NetworkManager::ScriptType && resourceType != NetworkManager::StyleSheetType)
 				{
-					m_blockedElements.append(request.url().url());
+					m_blockedElements.insert(request.url().url());
 				}
 
 				NetworkManager::ResourceInformation resource;
@@ -688,6 +779,11 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 				m_blockedRequests.append(resource);
 
+				timing.finishedTime = m_statisticsTimer.nsecsElapsed();
+				timing.isBlocked = true;
+
+				addRequestTiming(timing);
+
 				emit requestBlocked(resource);
 
 				return QNetworkAccessManager::createRequest(QNetworkAccessManager::GetOperation, QNetworkRequest());
@@ -764,6 +860,43 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 			}
 		}
 	}
+	else if (!m_proxyFactory && (request.url().scheme() == QLatin1String("http") || request.url().scheme() == QLatin1String("https")))
+	{
+		const QList<QNetworkCookie> cookies(m_cookieJarProxy->cookiesForUrl(request.url()));
+
+		if (!cookies.isEmpty())
+		{
+			QStringList cookieValues;
+			cookieValues.reserve(cookies.count());
+
+			for (int i = 0; i < cookies.count(); ++i)
+			{
+				cookieValues.append(QString::fromLatin1(cookies.at(i).toRawForm(QNetworkCookie::NameAndValueOnly)));
+			}
+
+			mutableRequest.setRawHeader(QByteArrayLiteral("Cookie"), cookieValues.join(QLatin1String("; ")).toLatin1());
+		}
+
+		mutableRequest.setAttribute(QNetworkRequest::CookieLoadControlAttribute, QNetworkRequest::Manual);
+		mutableRequest.setAttribute(QNetworkRequest::CookieSaveControlAttribute, QNetworkRequest::Manual);
+
+		if (!m_transportManager)
+		{
+			m_transportManager = (m_isPrivate ? QtWebKitTransportManager::createPrivateInstance(this) : QtWebKitTransportManager::getInstance());
+		}
+
+		reply = m_transportManager->createTransportRequest(this, operation, mutableRequest, outgoingData);
+
+		connect(reply, &QNetworkReply::metaDataChanged, this, [=]()
+		{
+			const QVariant cookiesHeader(reply->header(QNetworkRequest::SetCookieHeader));
+
+			if (cookiesHeader.isValid())
+			{
+				m_cookieJarProxy->setCookiesFromUrl(cookiesHeader.value<QList<QNetworkCookie> >(), reply->url());
+			}
+		});
+	}
 	else
 	{
 		reply = QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
@@ -796,8 +929,16 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	}
 
 	m_replies[reply] = {0, false};
+	m_pendingRequestTimings[reply] = timing;
 
 	connect(reply, &QNetworkReply::downloadProgress, this, &QtWebKitNetworkManager::handleDownloadProgress);
+	connect(reply, &QNetworkReply::metaDataChanged, this, [=]()
+	{
+		if (m_pendingRequestTimings.contains(reply) && m_pendingRequestTimings[reply].firstByteTime < 0)
+		{
+			m_pendingRequestTimings[reply].firstByteTime = m_statisticsTimer.nsecsElapsed();
+		}
+	});
 
 	if (m_loadingSpeedTimer == 0)
 	{
@@ -837,7 +978,7 @@ QVariant QtWebKitNetworkManager::getOption(int identifier, const QUrl &url) cons
 	return (m_widget ? m_widget->getOption(identifier, url) : SettingsManager::getOption(identifier, Utils::extractHost(url)));
 }
 
-QStringList QtWebKitNetworkManager::getBlockedElements() const
+QSet<QString> QtWebKitNetworkManager::getBlockedElements() const
 {
 	return m_blockedElements;
 }
@@ -847,6 +988,11 @@ QVector<NetworkManager::ResourceInformation> QtWebKitNetworkManager::getBlockedR
 	return m_blockedRequests;
 }
 
+QVector<NetworkManager::RequestTimingInformation> QtWebKitNetworkManager::getRequestTimings() const
+{
+	return m_requestTimings;
+}
+
 QMap<QByteArray, QByteArray> QtWebKitNetworkManager::getHeaders() const
 {
 	return m_headers;
@@ -26,6 +26,7 @@
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtNetwork/QNetworkRequest>
 
 namespace Otter
@@ -33,6 +34,7 @@ namespace Otter
 
 class NetworkProxyFactory;
 class QtWebKitCookieJar;
+class QtWebKitTransportManager;
 class WebBackend;
 
 class QtWebKitNetworkManager final : public QNetworkAccessManager
@@ -45,8 +47,9 @@ public:
 	CookieJar* getCookieJar() const;
 	QVariant getPageInformation(WebWidget::PageInformation key) const;
 	WebWidget::SslInformation getSslInformation() const;
-	QStringList getBlockedElements() const;
+	QSet<QString> getBlockedElements() const;
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const;
+	QVector<NetworkManager::RequestTimingInformation> getRequestTimings() const;
 	QMap<QByteArray, QByteArray> getHeaders() const;
 	WebWidget::ContentStates getContentState() const;
 
@@ -55,7 +58,9 @@ protected:
 	void addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType);
 	void resetStatistics();
 	void registerTransfer(QNetworkReply *reply);
+	void addRequestTiming(const NetworkManager::RequestTimingInformation &timing);
 	void updateLoadingSpeed();
+	void prefetchHost(const QUrl &url);
 	void updateOptions(const QUrl &url);
 	void setPageInformation(WebWidget::PageInformation key, const QVariant &value);
 	void setFormRequest(const QUrl &url);
@@ -81,19 +86,23 @@ private:
 	CookieJar *m_cookieJar;
 	QtWebKitCookieJar *m_cookieJarProxy;
 	NetworkProxyFactory *m_proxyFactory;
+	QtWebKitTransportManager *m_transportManager;
 	QNetworkReply *m_baseReply;
 	QString m_acceptLanguage;
 	QString m_userAgent;
 	QUrl m_formRequestUrl;
 	QUrl m_mainRequestUrl;
 	WebWidget::SslInformation m_sslInformation;
-	QStringList m_blockedElements;
+	QElapsedTimer m_statisticsTimer;
+	QSet<QString> m_blockedElements;
 	QStringList m_unblockedHosts;
 	QVector<QNetworkReply*> m_transfers;
 	QVector<NetworkManager::ResourceInformation> m_blockedRequests;
+	QVector<NetworkManager::RequestTimingInformation> m_requestTimings;
 	QVector<int> m_contentBlockingProfiles;
 	QSet<QUrl> m_contentBlockingExceptions;
 	QHash<QNetworkReply*, QPair<qint64, bool> > m_replies;
+	QHash<QNetworkReply*, NetworkManager::RequestTimingInformation> m_pendingRequestTimings;
 	QMap<QByteArray, QByteArray> m_headers;
 	QMap<WebWidget::PageInformation, QVariant> m_pageInformation;
 	WebWidget::ContentStates m_contentState;
@@ -103,6 +112,7 @@ private:
 	int m_loadingSpeedTimer;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
+	bool m_isPrivate;
 
 	static WebBackend *m_backend;
 
@@ -112,6 +122,7 @@ signals:
 	void contentStateChanged(WebWidget::ContentStates state);
 
 friend class QtWebKitPage;
+friend class QtWebKitTransportManager;
 friend class QtWebKitWebWidget;
 };
 
@@ -63,22 +63,6 @@ void QtWebKitFrame::runUserScripts(const QUrl &url) const
 	}
 }
 
-void QtWebKitFrame::applyContentBlockingRules(const QStringList &rules, bool isHiding)
-{
-	const QString value(isHiding ? QLatin1String("none !important") : QString());
-	const QWebElementCollection elements(m_frame->documentElement().findAll(rules.join(QLatin1Char(','))));
-
-	for (int i = 0; i < elements.count(); ++i)
-	{
-		QWebElement element(elements.at(i));
-
-		if (!element.isNull())
-		{
-			element.setStyleProperty(QLatin1String("display"), value);
-		}
-	}
-}
-
 void QtWebKitFrame::handleIsDisplayingErrorPageChanged(QWebFrame *frame, bool isDisplayingErrorPage)
 {
 	if (frame == m_frame)
@@ -126,30 +110,20 @@ void QtWebKitFrame::handleLoadFinished()
 		return;
 	}
 
-	const ContentFiltersManager::CosmeticFiltersResult cosmeticFilters(ContentFiltersManager::getCosmeticFilters(ContentFiltersManager::getProfileIdentifiers(m_widget->getOption(SettingsManager::ContentBlocking_ProfilesOption).toStringList()), m_widget->getUrl()));
-
-	applyContentBlockingRules(cosmeticFilters.rules, true);
-	applyContentBlockingRules(cosmeticFilters.exceptions, false);
+	const QSet<QString> blockedRequests(m_widget->getBlockedElements());
 
-	const QStringList blockedRequests(m_widget->getBlockedElements());
-
-	if (blockedRequests.count() > 0)
+	if (!blockedRequests.isEmpty())
 	{
+		const QUrl baseUrl(m_frame->baseUrl());
 		const QWebElementCollection elements(m_frame->documentElement().findAll(QLatin1String("[src]")));
 
 		for (int i = 0; i < elements.count(); ++i)
 		{
 			QWebElement element(elements.at(i));
-			const QUrl url(element.attribute(QLatin1String("src")));
 
-			for (int j = 0; j < blockedRequests.count(); ++j)
+			if (blockedRequests.contains(baseUrl.resolved(QUrl(element.attribute(QLatin1String("src")))).url()))
 			{
-				if (url.matches(QUrl(blockedRequests.at(j)), QUrl::None) || blockedRequests.at(j).endsWith(url.url()))
-				{
-					element.setStyleProperty(QLatin1String("display"), QLatin1String("none !important"));
-
-					break;
-				}
+				element.setStyleProperty(QLatin1String("display"), QLatin1String("none !important"));
 			}
 		}
 	}
@@ -177,7 +151,7 @@ QtWebKitPage::QtWebKitPage(QtWebKitNetworkManager *networkManager, QtWebKitWebWi
 	connect(this, &QtWebKitPage::consoleMessageReceived, this, &QtWebKitPage::handleConsoleMessage);
 	connect(mainFrame(), &QWebFrame::loadStarted, this, [&]()
 	{
-		updateStyleSheets();
+		updateStyleSheets(mainFrame()->requestedUrl());
 	});
 	connect(mainFrame(), &QWebFrame::loadFinished, this, [&]()
 	{
@@ -397,6 +371,11 @@ void QtWebKitPage::updateStyleSheets(const QUrl &url)
 		}
 	}
 
+	if (m_widget && getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption).toBool())
+	{
+		styleSheet.append(ContentFiltersManager::getCosmeticFiltersStyleSheet(ContentFiltersManager::getProfileIdentifiers(getOption(SettingsManager::ContentBlocking_ProfilesOption).toStringList()), (url.isEmpty() ? mainFrame()->url() : url)));
+	}
+
 	settings()->setUserStyleSheetUrl(QUrl(QLatin1String("data:text/css;charset=utf-8;base64,") + styleSheet.toUtf8().toBase64()));
 }
 
@@ -47,9 +47,6 @@ public:
 public slots:
 	void handleIsDisplayingErrorPageChanged(QWebFrame *frame, bool isDisplayingErrorPage);
 
-protected:
-	void applyContentBlockingRules(const QStringList &rules, bool isHiding);
-
 protected slots:
 	void handleLoadFinished();
 
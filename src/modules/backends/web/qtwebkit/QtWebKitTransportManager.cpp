@@ -0,0 +1,357 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "QtWebKitTransportManager.h"
+#include "QtWebKitNetworkManager.h"
+#include "../../../../core/NetworkManagerFactory.h"
+#include "../../../../core/SettingsManager.h"
+#include "../../../../core/Utils.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QTextStream>
+#include <QtNetwork/QNetworkDiskCache>
+#include <QtNetwork/QNetworkProxyFactory>
+#include <QtNetwork/QNetworkReply>
+
+#define MAXIMUM_STATISTICS_HOSTS 1000
+#define MAXIMUM_REPORTED_HOSTS 20
+
+namespace Otter
+{
+
+QtWebKitTransportManager* QtWebKitTransportManager::m_instance(nullptr);
+QHash<QString, QtWebKitTransportManager::HostStatistics> QtWebKitTransportManager::m_statistics;
+QHash<QString, qint64> QtWebKitTransportManager::m_preconnectTimes;
+
+QtWebKitTransportManager::QtWebKitTransportManager(bool isPrivate, QObject *parent) : QNetworkAccessManager(parent),
+	m_isPrivate(isPrivate)
+{
+	NetworkManagerFactory::initialize();
+
+	if (!isPrivate)
+	{
+		QNetworkDiskCache *cache(NetworkManagerFactory::getCache());
+
+		setCache(cache);
+
+		cache->setParent(QCoreApplication::instance());
+	}
+
+	connect(this, &QtWebKitTransportManager::finished, this, &QtWebKitTransportManager::handleRequestFinished);
+	connect(this, &QtWebKitTransportManager::authenticationRequired, this, &QtWebKitTransportManager::handleAuthenticationRequired);
+	connect(this, &QtWebKitTransportManager::proxyAuthenticationRequired, this, &QtWebKitTransportManager::handleProxyAuthenticationRequired);
+	connect(this, &QtWebKitTransportManager::sslErrors, this, &QtWebKitTransportManager::handleSslErrors);
+	connect(NetworkManagerFactory::getInstance(), &NetworkManagerFactory::onlineStateChanged, this, &QtWebKitTransportManager::handleOnlineStateChanged);
+}
+
+void QtWebKitTransportManager::prefetchHost(const QUrl &url, bool shouldPreconnect)
+{
+	const QString host(url.host().toLower());
+
+	if (host.isEmpty() || (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")) || NetworkManagerFactory::isWorkingOffline() || SettingsManager::hasOverride(host, SettingsManager::Network_ProxyOption))
+	{
+		return;
+	}
+
+	const QString key((shouldPreconnect ? QLatin1String("connect:") : QLatin1String("lookup:")) + host);
+	const qint64 currentTime(QDateTime::currentMSecsSinceEpoch());
+
+	if ((currentTime - m_preconnectTimes.value(key, 0)) < 10000)
+	{
+		return;
+	}
+
+	m_preconnectTimes[key] = currentTime;
+
+	if (m_preconnectTimes.count() > 1000)
+	{
+		m_preconnectTimes.clear();
+	}
+
+	QtWebKitTransportManager *manager(getInstance());
+
+	if (!shouldPreconnect)
+	{
+		++getHostStatistics(host).hostLookups;
+
+		QHostInfo::lookupHost(host, manager, SLOT(handleHostLookup(QHostInfo)));
+
+		return;
+	}
+
+	++getHostStatistics(host).preconnects;
+
+	if (url.scheme() == QLatin1String("https"))
+	{
+		manager->connectToHostEncrypted(host, static_cast<quint16>(url.port(443)));
+	}
+	else
+	{
+		manager->connectToHost(host, static_cast<quint16>(url.port(80)));
+	}
+}
+
+QNetworkReply* QtWebKitTransportManager::createTransportRequest(QtWebKitNetworkManager *owner, Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+	QNetworkReply *reply(QNetworkAccessManager::createRequest(operation, request, outgoingData));
+
+	m_owners[reply] = owner;
+
+	if (!m_isPrivate)
+	{
+		++getHostStatistics(request.url().host().toLower()).requests;
+
+		m_bytesReceived[reply] = 0;
+
+		connect(reply, &QNetworkReply::downloadProgress, this, [=](qint64 bytesReceived)
+		{
+			if (m_bytesReceived.contains(reply))
+			{
+				m_bytesReceived[reply] = bytesReceived;
+			}
+		});
+	}
+
+	return reply;
+}
+
+void QtWebKitTransportManager::handleRequestFinished(QNetworkReply *reply)
+{
+	if (!reply)
+	{
+		return;
+	}
+
+	const qint64 bytesReceived(m_bytesReceived.take(reply));
+
+	if (!m_isPrivate)
+	{
+		HostStatistics &statistics(getHostStatistics(reply->url().host().toLower()));
+
+		if (reply->error() != QNetworkReply::NoError && reply->error() != QNetworkReply::OperationCanceledError)
+		{
+			++statistics.failedRequests;
+		}
+
+		if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+		{
+			++statistics.cachedRequests;
+		}
+		else
+		{
+			statistics.bytesReceived += bytesReceived;
+		}
+
+		if (reply->attribute(QNetworkRequest::ConnectionEncryptedAttribute).toBool())
+		{
+			++statistics.encryptedRequests;
+		}
+	}
+
+	const QPointer<QtWebKitNetworkManager> owner(m_owners.take(reply));
+
+	if (owner)
+	{
+		owner->handleRequestFinished(reply);
+	}
+}
+
+void QtWebKitTransportManager::handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator)
+{
+	const QPointer<QtWebKitNetworkManager> owner(m_owners.value(reply));
+
+	if (owner)
+	{
+		owner->handleAuthenticationRequired(reply, authenticator);
+	}
+}
+
+void QtWebKitTransportManager::handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator)
+{
+	const QList<QNetworkReply*> replies(findChildren<QNetworkReply*>(QString(), Qt::FindDirectChildrenOnly));
+	QPointer<QtWebKitNetworkManager> fallbackOwner;
+
+	for (int i = 0; i < replies.count(); ++i)
+	{
+		QNetworkReply *reply(replies.at(i));
+		const QPointer<QtWebKitNetworkManager> owner(m_owners.value(reply));
+
+		if (!owner || reply->isFinished() || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid())
+		{
+			continue;
+		}
+
+		const QList<QNetworkProxy> proxies(QNetworkProxyFactory::proxyForQuery(QNetworkProxyQuery(reply->url())));
+
+		for (int j = 0; j < proxies.count(); ++j)
+		{
+			if (proxies.at(j).hostName() == proxy.hostName() && proxies.at(j).port() == proxy.port())
+			{
+				owner->handleProxyAuthenticationRequired(proxy, authenticator);
+
+				return;
+			}
+		}
+
+		if (!fallbackOwner)
+		{
+			fallbackOwner = owner;
+		}
+	}
+
+	if (fallbackOwner)
+	{
+		fallbackOwner->handleProxyAuthenticationRequired(proxy, authenticator);
+	}
+}
+
+void QtWebKitTransportManager::handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
+{
+	const QPointer<QtWebKitNetworkManager> owner(m_owners.value(reply));
+
+	if (owner)
+	{
+		owner->handleSslErrors(reply, errors);
+	}
+}
+
+void QtWebKitTransportManager::handleHostLookup(const QHostInfo &information)
+{
+	if (information.error() != QHostInfo::NoError)
+	{
+		++getHostStatistics(information.hostName().toLower()).failedHostLookups;
+	}
+}
+
+void QtWebKitTransportManager::handleOnlineStateChanged(bool isOnline)
+{
+	if (isOnline)
+	{
+		setNetworkAccessible(QNetworkAccessManager::Accessible);
+	}
+}
+
+QtWebKitTransportManager* QtWebKitTransportManager::createPrivateInstance(QObject *parent)
+{
+	return new QtWebKitTransportManager(true, parent);
+}
+
+QtWebKitTransportManager* QtWebKitTransportManager::getInstance()
+{
+	if (!m_instance)
+	{
+		m_instance = new QtWebKitTransportManager(false, QCoreApplication::instance());
+	}
+
+	return m_instance;
+}
+
+QtWebKitTransportManager::HostStatistics& QtWebKitTransportManager::getHostStatistics(const QString &host)
+{
+	if (m_statistics.count() >= MAXIMUM_STATISTICS_HOSTS && !m_statistics.contains(host))
+	{
+		m_statistics.clear();
+	}
+
+	return m_statistics[host];
+}
+
+QString QtWebKitTransportManager::createReport()
+{
+	HostStatistics totalStatistics;
+	QVector<QPair<int, QString> > hosts;
+	hosts.reserve(m_statistics.count());
+
+	QHash<QString, HostStatistics>::const_iterator iterator;
+
+	for (iterator = m_statistics.constBegin(); iterator != m_statistics.constEnd(); ++iterator)
+	{
+		const HostStatistics &statistics(iterator.value());
+
+		totalStatistics.bytesReceived += statistics.bytesReceived;
+		totalStatistics.requests += statistics.requests;
+		totalStatistics.cachedRequests += statistics.cachedRequests;
+		totalStatistics.encryptedRequests += statistics.encryptedRequests;
+		totalStatistics.failedRequests += statistics.failedRequests;
+		totalStatistics.hostLookups += statistics.hostLookups;
+		totalStatistics.failedHostLookups += statistics.failedHostLookups;
+		totalStatistics.preconnects += statistics.preconnects;
+
+		hosts.append({statistics.requests, iterator.key()});
+	}
+
+	std::sort(hosts.begin(), hosts.end(), [&](const QPair<int, QString> &first, const QPair<int, QString> &second)
+	{
+		return (first.first > second.first);
+	});
+
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignLeft);
+	stream << QLatin1String("Network Transport:\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Hosts");
+	stream << m_statistics.count();
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Requests (cached / encrypted)");
+	stream.setFieldWidth(0);
+	stream << QStringLiteral("%1 (%2 / %3)").arg(totalStatistics.requests).arg(totalStatistics.cachedRequests).arg(totalStatistics.encryptedRequests);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Failed Requests");
+	stream << totalStatistics.failedRequests;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Bytes Received");
+	stream << totalStatistics.bytesReceived;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Host Lookups (failed)");
+	stream.setFieldWidth(0);
+	stream << QStringLiteral("%1 (%2)").arg(totalStatistics.hostLookups).arg(totalStatistics.failedHostLookups);
+	stream << QLatin1String("\n\t");
+	stream.setFieldWidth(30);
+	stream << QLatin1String("Preconnects");
+	stream << totalStatistics.preconnects;
+	stream.setFieldWidth(0);
+	stream << QLatin1String("\n");
+
+	for (int i = 0; i < qMin(hosts.count(), MAXIMUM_REPORTED_HOSTS); ++i)
+	{
+		const HostStatistics statistics(m_statistics.value(hosts.at(i).second));
+
+		stream << QLatin1String("\t");
+		stream.setFieldWidth(30);
+		stream << hosts.at(i).second;
+		stream.setFieldWidth(0);
+		stream << QStringLiteral("%1 requests, %2 cached, %3 failed, %4 bytes").arg(statistics.requests).arg(statistics.cachedRequests).arg(statistics.failedRequests).arg(statistics.bytesReceived);
+		stream << QLatin1String("\n");
+	}
+
+	stream << QLatin1String("\n");
+
+	return report;
+}
+
+}
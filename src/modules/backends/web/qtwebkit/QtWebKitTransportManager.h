@@ -0,0 +1,80 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_QTWEBKITTRANSPORTMANAGER_H
+#define OTTER_QTWEBKITTRANSPORTMANAGER_H
+
+#include <QtCore/QPointer>
+#include <QtNetwork/QHostInfo>
+#include <QtNetwork/QNetworkAccessManager>
+
+namespace Otter
+{
+
+class QtWebKitNetworkManager;
+
+class QtWebKitTransportManager final : public QNetworkAccessManager
+{
+	Q_OBJECT
+
+public:
+	struct HostStatistics final
+	{
+		qint64 bytesReceived = 0;
+		int requests = 0;
+		int cachedRequests = 0;
+		int encryptedRequests = 0;
+		int failedRequests = 0;
+		int hostLookups = 0;
+		int failedHostLookups = 0;
+		int preconnects = 0;
+	};
+
+	static void prefetchHost(const QUrl &url, bool shouldPreconnect);
+	static QtWebKitTransportManager* createPrivateInstance(QObject *parent);
+	static QtWebKitTransportManager* getInstance();
+	static QString createReport();
+	QNetworkReply* createTransportRequest(QtWebKitNetworkManager *owner, Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
+
+protected:
+	explicit QtWebKitTransportManager(bool isPrivate, QObject *parent);
+
+	static HostStatistics& getHostStatistics(const QString &host);
+
+protected slots:
+	void handleRequestFinished(QNetworkReply *reply);
+	void handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator);
+	void handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
+	void handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
+	void handleHostLookup(const QHostInfo &information);
+	void handleOnlineStateChanged(bool isOnline);
+
+private:
+	QHash<QNetworkReply*, QPointer<QtWebKitNetworkManager> > m_owners;
+	QHash<QNetworkReply*, qint64> m_bytesReceived;
+	bool m_isPrivate;
+
+	static QtWebKitTransportManager *m_instance;
+	static QHash<QString, HostStatistics> m_statistics;
+	static QHash<QString, qint64> m_preconnectTimes;
+};
+
+}
+
+#endif
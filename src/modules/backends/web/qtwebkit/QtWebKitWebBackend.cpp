@@ -21,6 +21,7 @@
 #include "QtWebKitWebBackend.h"
 #include "QtWebKitHistoryInterface.h"
 #include "QtWebKitPage.h"
+#include "QtWebKitTransportManager.h"
 #include "QtWebKitWebWidget.h"
 #include "../../../../core/NetworkManagerFactory.h"
 #include "../../../../core/SettingsManager.h"
@@ -137,6 +138,11 @@ void QtWebKitWebBackend::setActiveWidget(WebWidget *widget)
 	emit activeDictionaryChanged(getActiveDictionary());
 }
 
+void QtWebKitWebBackend::preconnect(const QUrl &url)
+{
+	QtWebKitTransportManager::prefetchHost(url, true);
+}
+
 WebWidget* QtWebKitWebBackend::createWidget(const QVariantMap &parameters, ContentsWidget *parent)
 {
 	if (!m_isInitialized)
@@ -172,6 +178,11 @@ WebWidget* QtWebKitWebBackend::createWidget(const QVariantMap &parameters, Conte
 	return widget;
 }
 
+QString QtWebKitWebBackend::createReport() const
+{
+	return QtWebKitTransportManager::createReport();
+}
+
 QtWebKitWebBackend* QtWebKitWebBackend::getInstance()
 {
 	return m_instance;
@@ -42,7 +42,9 @@ public:
 
 	explicit QtWebKitWebBackend(QObject *parent = nullptr);
 
+	void preconnect(const QUrl &url) override;
 	WebWidget* createWidget(const QVariantMap &parameters, ContentsWidget *parent = nullptr) override;
+	QString createReport() const override;
 	QString getName() const override;
 	QString getTitle() const override;
 	QString getDescription() const override;
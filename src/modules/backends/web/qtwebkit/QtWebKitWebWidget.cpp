@@ -134,6 +134,13 @@ QtWebKitWebWidget::QtWebKitWebWidget(const QVariantMap &parameters, WebBackend *
 	connect(m_page, &QtWebKitPage::downloadRequested, this, &QtWebKitWebWidget::handleDownloadRequested);
 	connect(m_page, &QtWebKitPage::unsupportedContent, this, &QtWebKitWebWidget::handleUnsupportedContent);
 	connect(m_page, &QtWebKitPage::linkHovered, this, &QtWebKitWebWidget::setStatusMessageOverride);
+	connect(m_page, &QtWebKitPage::linkHovered, this, [&](const QString &link)
+	{
+		if (!link.isEmpty())
+		{
+			m_networkManager->prefetchHost(QUrl(link));
+		}
+	});
 	connect(m_page, &QtWebKitPage::microFocusChanged, [&]()
 	{
 		emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::EditingCategory});
@@ -711,6 +718,11 @@ void QtWebKitWebWidget::notifyUrlChanged(const QUrl &url)
 
 void QtWebKitWebWidget::notifyIconChanged()
 {
+	if (!isPrivate())
+	{
+		HistoryManager::setIcon(getUrl(), m_page->mainFrame()->icon());
+	}
+
 	emit iconChanged(getIcon());
 }
 
@@ -2478,7 +2490,7 @@ WebWidget::HitTestResult QtWebKitWebWidget::getHitTestResult(const QPoint &posit
 	return result;
 }
 
-QStringList QtWebKitWebWidget::getBlockedElements() const
+QSet<QString> QtWebKitWebWidget::getBlockedElements() const
 {
 	return m_networkManager->getBlockedElements();
 }
@@ -2570,6 +2582,11 @@ QVector<NetworkManager::ResourceInformation> QtWebKitWebWidget::getBlockedReques
 	return m_networkManager->getBlockedRequests();
 }
 
+QVector<NetworkManager::RequestTimingInformation> QtWebKitWebWidget::getRequestTimings() const
+{
+	return m_networkManager->getRequestTimings();
+}
+
 QMap<QByteArray, QByteArray> QtWebKitWebWidget::getHeaders() const
 {
 	return m_networkManager->getHeaders();
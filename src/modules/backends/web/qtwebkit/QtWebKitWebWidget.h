@@ -24,6 +24,7 @@
 #include "../../../../ui/WebWidget.h"
 
 #include <QtCore/QQueue>
+#include <QtCore/QSet>
 #include <QtNetwork/QNetworkReply>
 #include <QtWebKitWidgets/QWebPage>
 #include <QtWebKitWidgets/QWebView>
@@ -55,7 +56,7 @@ public:
 	QString getActiveStyleSheet() const override;
 	QString getSelectedText() const override;
 	QVariant getPageInformation(PageInformation key) const override;
-	QStringList getBlockedElements() const;
+	QSet<QString> getBlockedElements() const;
 	QUrl getUrl() const override;
 	QIcon getIcon() const override;
 	QPixmap createThumbnail(const QSize &size = {}) override;
@@ -73,6 +74,7 @@ public:
 	QVector<LinkUrl> getLinks() const override;
 	QVector<LinkUrl> getSearchEngines() const override;
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const override;
+	QVector<NetworkManager::RequestTimingInformation> getRequestTimings() const override;
 	QMap<QByteArray, QByteArray> getHeaders() const override;
 	QMultiMap<QString, QString> getMetaData() const override;
 	ContentStates getContentState() const override;
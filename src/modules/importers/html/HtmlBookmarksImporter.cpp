@@ -17,151 +17,188 @@
 * along with this program. If not, see <http://www.gnu.org/licenses/>.
 *
 **************************************************************************/
-
 #include "HtmlBookmarksImporter.h"
 #include "../../../core/BookmarksManager.h"
 #include "../../../ui/BookmarksImporterWidget.h"
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
-#ifdef OTTER_ENABLE_QTWEBKIT
-//TODO QtWebKit should not be used directly
-#include <QtWebKitWidgets/QWebPage>
-#include <QtWebKitWidgets/QWebFrame>
-#include <QtWebKit/QWebElementCollection>
-#endif
+#include <QtCore/QTextCodec>
+#include <QtCore/QTextStream>
 
 namespace Otter
 {
 
 HtmlBookmarksImporter::HtmlBookmarksImporter(QObject *parent) : BookmarksImporter(parent),
 	m_optionsWidget(nullptr),
-	m_currentAmount(0),
-	m_totalAmount(-1)
+	m_lastBookmark(nullptr),
+	m_pendingFolder(nullptr),
+	m_context(NoContext)
 {
 }
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-void HtmlBookmarksImporter::processElement(const QWebElement &element)
+void HtmlBookmarksImporter::processTag(const QString &tag)
 {
-	QWebElement entryElement(element.findFirst(QLatin1String("dt, hr")));
+	int nameLength(0);
 
-	while (!entryElement.isNull())
+	while (nameLength < tag.length() && !tag.at(nameLength).isSpace() && (nameLength == 0 || tag.at(nameLength) != QLatin1Char('/')))
 	{
-		if (entryElement.tagName().toLower() == QLatin1String("hr"))
-		{
-			BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, {}, getCurrentFolder());
+		++nameLength;
+	}
 
-			++m_currentAmount;
+	const QString name(tag.left(nameLength).toLower());
 
-			emit importProgress(BookmarksImport, m_totalAmount, m_currentAmount);
-		}
-		else
+	if (name == QLatin1String("dt"))
+	{
+		finishDescription();
+
+		m_pendingFolder = nullptr;
+	}
+	else if (name == QLatin1String("h3") || name == QLatin1String("a"))
+	{
+		finishDescription();
+
+		m_context = ((name == QLatin1String("h3")) ? FolderContext : BookmarkContext);
+		m_attributes = parseAttributes(tag.mid(nameLength));
+		m_text.clear();
+	}
+	else if (name == QLatin1String("/h3") || name == QLatin1String("/a"))
+	{
+		if (m_context == ((name == QLatin1String("/h3")) ? FolderContext : BookmarkContext))
 		{
-			BookmarksModel::BookmarkType type(BookmarksModel::UnknownBookmark);
-			QWebElement matchedElement(entryElement.findFirst(QLatin1String("dt > h3")));
+			addPendingBookmark();
+		}
+	}
+	else if (name == QLatin1String("dd"))
+	{
+		finishDescription();
 
-			if (matchedElement.isNull())
-			{
-				matchedElement = entryElement.findFirst(QLatin1String("dt > a"));
+		m_context = DescriptionContext;
+		m_text.clear();
+	}
+	else if (name == QLatin1String("hr"))
+	{
+		finishDescription();
 
-				if (!matchedElement.isNull())
-				{
-					type = (matchedElement.hasAttribute(QLatin1String("FEEDURL")) ? BookmarksModel::FeedBookmark : BookmarksModel::UrlBookmark);
-				}
-			}
-			else
-			{
-				type = BookmarksModel::FolderBookmark;
-			}
+		m_pendingFolder = nullptr;
+		m_lastBookmark = nullptr;
 
-			if (type != BookmarksModel::UnknownBookmark && !matchedElement.isNull())
-			{
-				QMap<int, QVariant> metaData({{BookmarksModel::TitleRole, matchedElement.toPlainText()}});
-				const bool isUrlBookmark(type == BookmarksModel::UrlBookmark || BookmarksModel::FeedBookmark);
+		BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, {}, getCurrentFolder());
+	}
+	else if (name == QLatin1String("dl"))
+	{
+		finishDescription();
 
-				if (isUrlBookmark)
-				{
-					const QUrl url(matchedElement.attribute(QLatin1String("HREF")));
+		m_folders.append(m_pendingFolder != nullptr);
 
-					if (!areDuplicatesAllowed() && BookmarksManager::hasBookmark(url))
-					{
-						entryElement = entryElement.nextSibling();
+		if (m_pendingFolder)
+		{
+			setCurrentFolder(m_pendingFolder);
 
-						continue;
-					}
+			m_pendingFolder = nullptr;
+		}
+	}
+	else if (name == QLatin1String("/dl"))
+	{
+		finishDescription();
 
-					metaData[BookmarksModel::UrlRole] = url;
-				}
+		m_pendingFolder = nullptr;
 
-				if (matchedElement.hasAttribute(QLatin1String("SHORTCUTURL")))
-				{
-					const QString keyword(matchedElement.attribute(QLatin1String("SHORTCUTURL")));
+		if (!m_folders.isEmpty() && m_folders.takeLast())
+		{
+			goToParent();
+		}
+	}
+}
 
-					if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
-					{
-						metaData[BookmarksModel::KeywordRole] = keyword;
-					}
-				}
+void HtmlBookmarksImporter::processText(const QString &text)
+{
+	if (m_context != NoContext)
+	{
+		m_text.append(text);
+	}
+}
 
-				if (matchedElement.hasAttribute(QLatin1String("ADD_DATE")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("ADD_DATE")));
+void HtmlBookmarksImporter::addPendingBookmark()
+{
+	const BookmarksModel::BookmarkType type((m_context == FolderContext) ? BookmarksModel::FolderBookmark : (m_attributes.contains(QLatin1String("FEEDURL")) ? BookmarksModel::FeedBookmark : BookmarksModel::UrlBookmark));
+	const bool isUrlBookmark(type != BookmarksModel::FolderBookmark);
+	QMap<int, QVariant> metaData({{BookmarksModel::TitleRole, decodeEntities(m_text).simplified()}});
 
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeAddedRole] = dateTime;
-						metaData[BookmarksModel::TimeModifiedRole] = dateTime;
-					}
-				}
+	m_context = NoContext;
+	m_text.clear();
+	m_lastBookmark = nullptr;
 
-				if (matchedElement.hasAttribute(QLatin1String("LAST_MODIFIED")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("LAST_MODIFIED")));
+	if (isUrlBookmark)
+	{
+		const QUrl url(m_attributes.value(QLatin1String("HREF")));
 
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeModifiedRole] = dateTime;
-					}
-				}
+		if (!areDuplicatesAllowed() && BookmarksManager::getModel()->hasBookmark(url))
+		{
+			return;
+		}
 
-				if (isUrlBookmark && matchedElement.hasAttribute(QLatin1String("LAST_VISITED")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("LAST_VISITED")));
+		metaData[BookmarksModel::UrlRole] = url;
+	}
 
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeVisitedRole] = dateTime;
-					}
-				}
+	const QString keyword(m_attributes.value(QLatin1String("SHORTCUTURL")));
 
-				BookmarksModel::Bookmark *bookmark(BookmarksManager::addBookmark(type, metaData, getCurrentFolder()));
+	if (!keyword.isEmpty() && !BookmarksManager::getModel()->hasKeyword(keyword))
+	{
+		metaData[BookmarksModel::KeywordRole] = keyword;
+	}
 
-				++m_currentAmount;
+	const QDateTime timeAdded(getDateTime(m_attributes, QLatin1String("ADD_DATE")));
 
-				emit importProgress(BookmarksImport, m_totalAmount, m_currentAmount);
+	if (timeAdded.isValid())
+	{
+		metaData[BookmarksModel::TimeAddedRole] = timeAdded;
+		metaData[BookmarksModel::TimeModifiedRole] = timeAdded;
+	}
 
-				if (type == BookmarksModel::FolderBookmark)
-				{
-					setCurrentFolder(bookmark);
-					processElement(entryElement);
-				}
+	const QDateTime timeModified(getDateTime(m_attributes, QLatin1String("LAST_MODIFIED")));
 
-				if (entryElement.nextSibling().tagName().toLower() == QLatin1String("dd"))
-				{
-					bookmark->setItemData(entryElement.nextSibling().toPlainText(), BookmarksModel::DescriptionRole);
+	if (timeModified.isValid())
+	{
+		metaData[BookmarksModel::TimeModifiedRole] = timeModified;
+	}
 
-					entryElement = entryElement.nextSibling();
-				}
-			}
+	if (isUrlBookmark)
+	{
+		const QDateTime timeVisited(getDateTime(m_attributes, QLatin1String("LAST_VISITED")));
+
+		if (timeVisited.isValid())
+		{
+			metaData[BookmarksModel::TimeVisitedRole] = timeVisited;
 		}
+	}
 
-		entryElement = entryElement.nextSibling();
+	m_lastBookmark = BookmarksManager::addBookmark(type, metaData, getCurrentFolder());
+
+	if (type == BookmarksModel::FolderBookmark)
+	{
+		m_pendingFolder = m_lastBookmark;
 	}
+}
 
-	goToParent();
+void HtmlBookmarksImporter::finishDescription()
+{
+	if (m_context == DescriptionContext && m_lastBookmark)
+	{
+		const QString description(decodeEntities(m_text).trimmed());
+
+		if (!description.isEmpty())
+		{
+			m_lastBookmark->setItemData(description, BookmarksModel::DescriptionRole);
+		}
+	}
+
+	if (m_context == DescriptionContext)
+	{
+		m_context = NoContext;
+		m_text.clear();
+	}
 }
-#endif
 
 QWidget* HtmlBookmarksImporter::createOptionsWidget(QWidget *parent)
 {
@@ -173,6 +210,90 @@ QWidget* HtmlBookmarksImporter::createOptionsWidget(QWidget *parent)
 	return m_optionsWidget;
 }
 
+QString HtmlBookmarksImporter::decodeEntities(const QString &text)
+{
+	if (!text.contains(QLatin1Char('&')))
+	{
+		return text;
+	}
+
+	QString result;
+	result.reserve(text.length());
+
+	for (int i = 0; i < text.length(); ++i)
+	{
+		const int end((text.at(i) == QLatin1Char('&')) ? text.indexOf(QLatin1Char(';'), i) : -1);
+
+		if (end < 0 || (end - i) > 10)
+		{
+			result.append(text.at(i));
+
+			continue;
+		}
+
+		const QString entity(text.mid((i + 1), (end - i - 1)));
+		QChar character;
+
+		if (entity.startsWith(QLatin1Char('#')))
+		{
+			bool isValid(false);
+			const uint code((entity.length() > 1 && entity.at(1).toLower() == QLatin1Char('x')) ? entity.mid(2).toUInt(&isValid, 16) : entity.mid(1).toUInt(&isValid));
+
+			if (isValid && code > 0)
+			{
+				if (QChar::requiresSurrogates(code))
+				{
+					result.append(QChar(QChar::highSurrogate(code)));
+					result.append(QChar(QChar::lowSurrogate(code)));
+
+					i = end;
+
+					continue;
+				}
+
+				character = QChar(code);
+			}
+		}
+		else if (entity == QLatin1String("amp"))
+		{
+			character = QLatin1Char('&');
+		}
+		else if (entity == QLatin1String("lt"))
+		{
+			character = QLatin1Char('<');
+		}
+		else if (entity == QLatin1String("gt"))
+		{
+			character = QLatin1Char('>');
+		}
+		else if (entity == QLatin1String("quot"))
+		{
+			character = QLatin1Char('"');
+		}
+		else if (entity == QLatin1String("apos"))
+		{
+			character = QLatin1Char('\'');
+		}
+		else if (entity == QLatin1String("nbsp"))
+		{
+			character = QChar(0xA0);
+		}
+
+		if (character.isNull())
+		{
+			result.append(text.at(i));
+		}
+		else
+		{
+			result.append(character);
+
+			i = end;
+		}
+	}
+
+	return result;
+}
+
 QString HtmlBookmarksImporter::getTitle() const
 {
 	return tr("HTML Bookmarks");
@@ -208,29 +329,149 @@ QUrl HtmlBookmarksImporter::getHomePage() const
 	return QUrl(QLatin1String("https://otter-browser.org/"));
 }
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-QDateTime HtmlBookmarksImporter::getDateTime(const QWebElement &element, const QString &attribute)
+QDateTime HtmlBookmarksImporter::getDateTime(const QHash<QString, QString> &attributes, const QString &attribute)
 {
+	if (!attributes.contains(attribute))
+	{
+		return {};
+	}
+
 #if QT_VERSION < 0x050800
-	const uint seconds(element.attribute(attribute).toUInt());
+	const uint seconds(attributes.value(attribute).toUInt());
 
 	return ((seconds > 0) ? QDateTime::fromTime_t(seconds) : QDateTime());
 #else
-	const qint64 seconds(element.attribute(attribute).toLongLong());
+	const qint64 seconds(attributes.value(attribute).toLongLong());
 
 	return ((seconds != 0) ? QDateTime::fromSecsSinceEpoch(seconds) : QDateTime());
 #endif
 }
-#endif
+
+QHash<QString, QString> HtmlBookmarksImporter::parseAttributes(const QString &tag)
+{
+	QHash<QString, QString> attributes;
+	int position(0);
+
+	while (position < tag.length())
+	{
+		while (position < tag.length() && (tag.at(position).isSpace() || tag.at(position) == QLatin1Char('/')))
+		{
+			++position;
+		}
+
+		const int nameStart(position);
+
+		while (position < tag.length() && !tag.at(position).isSpace() && tag.at(position) != QLatin1Char('=') && tag.at(position) != QLatin1Char('/'))
+		{
+			++position;
+		}
+
+		if (position == nameStart)
+		{
+			break;
+		}
+
+		const QString name(tag.mid(nameStart, (position - nameStart)).toUpper());
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		if (position >= tag.length() || tag.at(position) != QLatin1Char('='))
+		{
+			attributes[name] = QString();
+
+			continue;
+		}
+
+		++position;
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		int valueStart(position);
+		int valueEnd(-1);
+
+		if (position < tag.length() && (tag.at(position) == QLatin1Char('"') || tag.at(position) == QLatin1Char('\'')))
+		{
+			++valueStart;
+
+			valueEnd = tag.indexOf(tag.at(position), valueStart);
+
+			if (valueEnd < 0)
+			{
+				valueEnd = tag.length();
+			}
+
+			position = (valueEnd + 1);
+		}
+		else
+		{
+			while (position < tag.length() && !tag.at(position).isSpace())
+			{
+				++position;
+			}
+
+			valueEnd = position;
+		}
+
+		if (name != QLatin1String("ICON") && name != QLatin1String("ICON_URI"))
+		{
+			attributes[name] = decodeEntities(tag.mid(valueStart, (valueEnd - valueStart)));
+		}
+	}
+
+	return attributes;
+}
 
 QStringList HtmlBookmarksImporter::getFileFilters() const
 {
 	return {tr("HTML files (*.htm *.html)")};
 }
 
+int HtmlBookmarksImporter::findTagEnd(const QString &buffer, int position)
+{
+	if (buffer.midRef(position, 4) == QLatin1String("<!--"))
+	{
+		const int end(buffer.indexOf(QLatin1String("-->"), (position + 4)));
+
+		return ((end < 0) ? -1 : (end + 2));
+	}
+
+	QChar quote;
+
+	for (int i = (position + 1); i < buffer.length(); ++i)
+	{
+		const QChar character(buffer.at(i));
+
+		if (!quote.isNull())
+		{
+			if (character == quote)
+			{
+				quote = QChar();
+			}
+		}
+		else if (character == QLatin1Char('"') || character == QLatin1Char('\''))
+		{
+			if (buffer.at(i - 1) == QLatin1Char('='))
+			{
+				quote = character;
+			}
+		}
+		else if (character == QLatin1Char('>'))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 bool HtmlBookmarksImporter::import(const QString &path)
 {
-#ifdef OTTER_ENABLE_QTWEBKIT
 	QFile file(getSuggestedPath(path));
 
 	if (!file.open(QIODevice::ReadOnly))
@@ -258,28 +499,92 @@ bool HtmlBookmarksImporter::import(const QString &path)
 		}
 	}
 
-	QWebPage page;
-	page.settings()->setAttribute(QWebSettings::JavascriptEnabled, false);
-	page.mainFrame()->setHtml(file.readAll());
+	const int totalSize(qMax(1, static_cast<int>(file.size() / 1024)));
+	const int estimatedAmount(static_cast<int>(file.size() / 200));
+
+	m_lastBookmark = nullptr;
+	m_pendingFolder = nullptr;
+	m_context = NoContext;
+	m_text.clear();
+	m_folders.clear();
+
+	emit importStarted(BookmarksImport, totalSize);
+
+	BookmarksManager::getModel()->beginImport(getImportFolder(), estimatedAmount, qMin(estimatedAmount, 100));
+
+	QTextStream stream(&file);
+	stream.setCodec(QTextCodec::codecForHtml(file.peek(4096), QTextCodec::codecForName("UTF-8")));
+
+	QString buffer;
+
+	while (!stream.atEnd())
+	{
+		buffer.append(stream.read(65536));
+
+		int position(0);
+
+		while (position < buffer.length())
+		{
+			const int tagStart(buffer.indexOf(QLatin1Char('<'), position));
 
-	m_totalAmount = page.mainFrame()->findAllElements(QLatin1String("dt, hr")).count();
+			if (tagStart < 0)
+			{
+				processText(buffer.mid(position));
 
-	emit importStarted(BookmarksImport, m_totalAmount);
+				position = buffer.length();
 
-	BookmarksManager::getModel()->beginImport(getImportFolder(), page.mainFrame()->findAllElements(QLatin1String("a[href]")).count(), page.mainFrame()->findAllElements(QLatin1String("a[shortcuturl]")).count());
+				break;
+			}
 
-	processElement(page.mainFrame()->documentElement().findFirst(QLatin1String("dl")));
+			if (tagStart > position)
+			{
+				processText(buffer.mid(position, (tagStart - position)));
+			}
+
+			const int tagEnd(findTagEnd(buffer, tagStart));
+
+			if (tagEnd < 0)
+			{
+				position = tagStart;
+
+				break;
+			}
+
+			if (buffer.at(tagStart + 1) != QLatin1Char('!'))
+			{
+				processTag(buffer.mid((tagStart + 1), (tagEnd - tagStart - 1)).trimmed());
+			}
+
+			position = (tagEnd + 1);
+		}
+
+		buffer.remove(0, position);
+
+		if (buffer.length() > 1048576)
+		{
+			processText(buffer);
+
+			buffer.clear();
+		}
+
+		emit importProgress(BookmarksImport, totalSize, static_cast<int>(file.pos() / 1024));
+	}
+
+	finishDescription();
 
 	BookmarksManager::getModel()->endImport();
 
-	emit importFinished(BookmarksImport, SuccessfullImport, m_totalAmount);
+	m_lastBookmark = nullptr;
+	m_pendingFolder = nullptr;
+	m_attributes.clear();
+	m_text.clear();
+	m_folders.clear();
+
+	emit importFinished(BookmarksImport, SuccessfullImport, totalSize);
 
 	file.close();
 
 	return true;
-#else
-	return false;
-#endif
 }
 
 }
@@ -23,10 +23,6 @@
 
 #include "../../../core/BookmarksImporter.h"
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-#include <QtWebKit/QWebElement>
-#endif
-
 namespace Otter
 {
 
@@ -51,16 +47,32 @@ public:
 public slots:
 	bool import(const QString &path) override;
 
-#ifdef OTTER_ENABLE_QTWEBKIT
 protected:
-	void processElement(const QWebElement &element);
-	static QDateTime getDateTime(const QWebElement &element, const QString &attribute);
-#endif
+	enum EntryContext
+	{
+		NoContext = 0,
+		FolderContext,
+		BookmarkContext,
+		DescriptionContext
+	};
+
+	void processTag(const QString &tag);
+	void processText(const QString &text);
+	void addPendingBookmark();
+	void finishDescription();
+	static QString decodeEntities(const QString &text);
+	static QDateTime getDateTime(const QHash<QString, QString> &attributes, const QString &attribute);
+	static QHash<QString, QString> parseAttributes(const QString &tag);
+	static int findTagEnd(const QString &buffer, int position);
 
 private:
 	BookmarksImporterWidget *m_optionsWidget;
-	int m_currentAmount;
-	int m_totalAmount;
+	BookmarksModel::Bookmark *m_lastBookmark;
+	BookmarksModel::Bookmark *m_pendingFolder;
+	QString m_text;
+	QHash<QString, QString> m_attributes;
+	QVector<bool> m_folders;
+	EntryContext m_context;
 };
 
 }
@@ -655,10 +655,14 @@ void AddressWidget::mouseReleaseEvent(QMouseEvent *event)
 						{
 							const QVector<BookmarksModel::Bookmark*> bookmarks(BookmarksManager::getModel()->findUrls(url));
 
+							BookmarksManager::getModel()->beginBulkEdit();
+
 							for (int i = 0; i < bookmarks.count(); ++i)
 							{
 								BookmarksManager::getModel()->trashBookmark(bookmarks.at(i));
 							}
+
+							BookmarksManager::getModel()->endBulkEdit();
 						}
 						else
 						{
@@ -800,6 +804,13 @@ void AddressWidget::showCompletion(bool isTypedHistory)
 
 				setText(index.data(AddressCompletionModel::TextRole).toString());
 			}
+
+			const QUrl url(index.data(AddressCompletionModel::UrlRole).toUrl());
+
+			if (m_window && !m_window->isPrivate() && url.isValid() && m_window->getWebWidget())
+			{
+				m_window->getWebWidget()->getBackend()->preconnect(url);
+			}
 		});
 
 		showPopup();
@@ -116,16 +116,11 @@ void ErrorConsoleWidget::showEvent(QShowEvent *event)
 		m_model = new QStandardItemModel(this);
 		m_model->setSortRole(TimeRole);
 
-		const QVector<Console::Message> messages(Console::getMessages());
-
-		for (int i = 0; i < messages.count(); ++i)
-		{
-			addMessage(messages.at(i));
-		}
+		addMessages(Console::getMessages());
 
 		m_ui->consoleView->setModel(m_model);
 
-		connect(Console::getInstance(), &Console::messageAdded, this, &ErrorConsoleWidget::addMessage);
+		connect(Console::getInstance(), &Console::messagesAdded, this, &ErrorConsoleWidget::addMessages);
 	}
 
 	QWidget::showEvent(event);
@@ -133,11 +128,6 @@ void ErrorConsoleWidget::showEvent(QShowEvent *event)
 
 void ErrorConsoleWidget::addMessage(const Console::Message &message)
 {
-	if (!m_model)
-	{
-		return;
-	}
-
 	QIcon icon;
 	QString category;
 
@@ -186,6 +176,11 @@ void ErrorConsoleWidget::addMessage(const Console::Message &message)
 		entry.append(QLatin1String(" - ") + source);
 	}
 
+	if (message.count > 1)
+	{
+		entry.append(QLatin1Char(' ') + tr("(repeated %n times)", "", message.count));
+	}
+
 	QStandardItem *messageItem(new QStandardItem(icon, entry));
 	messageItem->setData(entry, Qt::ToolTipRole);
 	messageItem->setData(message.time.toMSecsSinceEpoch(), TimeRole);
@@ -200,9 +195,23 @@ void ErrorConsoleWidget::addMessage(const Console::Message &message)
 	messageItem->appendRow(descriptionItem);
 
 	m_model->appendRow(messageItem);
+}
+
+void ErrorConsoleWidget::addMessages(const QVector<Console::Message> &messages)
+{
+	if (!m_model || messages.isEmpty())
+	{
+		return;
+	}
+
+	for (int i = 0; i < messages.count(); ++i)
+	{
+		addMessage(messages.at(i));
+	}
+
 	m_model->sort(0, Qt::DescendingOrder);
 
-	applyFilters(messageItem->index(), m_ui->filterLineEditWidget->text(), getCategories(), getCurrentWindow());
+	filterMessages(m_ui->filterLineEditWidget->text());
 }
 
 void ErrorConsoleWidget::filterCategories()
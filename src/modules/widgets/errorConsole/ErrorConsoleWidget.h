@@ -61,12 +61,13 @@ protected:
 	Q_DECLARE_FLAGS(MessagesScopes, MessagesScope)
 
 	void showEvent(QShowEvent *event) override;
+	void addMessage(const Console::Message &message);
 	void applyFilters(const QModelIndex &index, const QString &filter, const QVector<Console::MessageCategory> &categories, quint64 currentWindow);
 	QVector<Console::MessageCategory> getCategories() const;
 	quint64 getCurrentWindow();
 
 protected slots:
-	void addMessage(const Console::Message &message);
+	void addMessages(const QVector<Console::Message> &messages);
 	void filterCategories();
 	void filterMessages(const QString &filter);
 	void showContextMenu(const QPoint &position);
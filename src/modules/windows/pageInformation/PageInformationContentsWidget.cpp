@@ -18,6 +18,7 @@
 **************************************************************************/
 
 #include "PageInformationContentsWidget.h"
+#include "../../../core/Application.h"
 #include "../../../core/ThemesManager.h"
 #include "../../../ui/Action.h"
 #include "../../../ui/MainWindow.h"
@@ -25,11 +26,42 @@
 
 #include "ui_PageInformationContentsWidget.h"
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QUrlQuery>
 #include <QtGui/QClipboard>
+#include <QtGui/QPainter>
+#include <QtWidgets/QMessageBox>
 
 namespace Otter
 {
 
+RequestTimingDelegate::RequestTimingDelegate(QObject *parent) : ItemDelegate(parent)
+{
+}
+
+void RequestTimingDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	ItemDelegate::paint(painter, option, index);
+
+	if (!index.data(PageInformationContentsWidget::FinishedTimeRole).isValid())
+	{
+		return;
+	}
+
+	const QRect rectangle(option.rect.marginsRemoved(QMargins(3, (option.rect.height() - 4), 3, 1)));
+	const int queuedPosition(rectangle.left() + qRound(index.data(PageInformationContentsWidget::QueuedTimeRole).toReal() * rectangle.width()));
+	const int contentBlockingPosition(rectangle.left() + qRound(index.data(PageInformationContentsWidget::ContentBlockingTimeRole).toReal() * rectangle.width()));
+	const int firstBytePosition(rectangle.left() + qRound(index.data(PageInformationContentsWidget::FirstByteTimeRole).toReal() * rectangle.width()));
+	const int finishedPosition(qMax((queuedPosition + 1), (rectangle.left() + qRound(index.data(PageInformationContentsWidget::FinishedTimeRole).toReal() * rectangle.width()))));
+
+	painter->fillRect(QRect(queuedPosition, rectangle.top(), qMax(0, (contentBlockingPosition - queuedPosition)), rectangle.height()), QColor(255, 150, 50));
+	painter->fillRect(QRect(contentBlockingPosition, rectangle.top(), qMax(0, (firstBytePosition - contentBlockingPosition)), rectangle.height()), option.palette.color(QPalette::Mid));
+	painter->fillRect(QRect(firstBytePosition, rectangle.top(), qMax(0, (finishedPosition - firstBytePosition)), rectangle.height()), option.palette.color(option.state.testFlag(QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Highlight));
+}
+
 PageInformationContentsWidget::PageInformationContentsWidget(const QVariantMap &parameters, QWidget *parent) : ContentsWidget(parameters, nullptr, parent),
 	m_window(nullptr),
 	m_ui(new Ui::PageInformationContentsWidget)
@@ -37,7 +69,7 @@ PageInformationContentsWidget::PageInformationContentsWidget(const QVariantMap &
 	m_ui->setupUi(this);
 	m_ui->filterLineEditWidget->setClearOnEscape(true);
 
-	const QVector<SectionName> sections({GeneralSection, SecuritySection, PermissionsSection, MetaSection, HeadersSection});
+	const QVector<SectionName> sections({GeneralSection, SecuritySection, PermissionsSection, MetaSection, HeadersSection, NetworkSection});
 	QStandardItemModel *model(new QStandardItemModel(this));
 	model->setHorizontalHeaderLabels({tr("Name"), tr("Value")});
 
@@ -51,6 +83,7 @@ PageInformationContentsWidget::PageInformationContentsWidget(const QVariantMap &
 
 	m_ui->informationViewWidget->setViewMode(ItemViewWidget::TreeView);
 	m_ui->informationViewWidget->setModel(model);
+	m_ui->informationViewWidget->setItemDelegateForColumn(1, new RequestTimingDelegate(this));
 	m_ui->informationViewWidget->expandAll();
 
 	const MainWindow *mainWindow(MainWindow::findMainWindow(parentWidget()));
@@ -229,6 +262,77 @@ void PageInformationContentsWidget::updateSections()
 					}
 				}
 
+				break;
+			case NetworkSection:
+				m_ui->informationViewWidget->setData(index, tr("Network"), Qt::DisplayRole);
+
+				if (sectionItem && m_window && m_window->getWebWidget())
+				{
+					QVector<NetworkManager::RequestTimingInformation> timings(m_window->getWebWidget()->getRequestTimings());
+					qint64 totalTime(0);
+
+					std::stable_sort(timings.begin(), timings.end(), [&](const NetworkManager::RequestTimingInformation &first, const NetworkManager::RequestTimingInformation &second)
+					{
+						return (first.queuedTime < second.queuedTime);
+					});
+
+					for (int j = 0; j < timings.count(); ++j)
+					{
+						totalTime = qMax(totalTime, timings.at(j).finishedTime);
+					}
+
+					for (int j = 0; j < timings.count(); ++j)
+					{
+						const NetworkManager::RequestTimingInformation timing(timings.at(j));
+						const QString duration(QString::number(((timing.finishedTime - timing.queuedTime) / 1000000.0), 'f', 1));
+						QStringList details({tr("Queued: %1 ms").arg(QString::number((timing.queuedTime / 1000000.0), 'f', 1))});
+
+						if (timing.contentBlockingDuration >= 0)
+						{
+							details.append(tr("Content blocking: %1 ms").arg(QString::number((timing.contentBlockingDuration / 1000000.0), 'f', 2)));
+						}
+
+						if (timing.proxyResolutionDuration >= 0)
+						{
+							details.append(tr("Proxy resolution: %1 ms").arg(QString::number((timing.proxyResolutionDuration / 1000000.0), 'f', 2)));
+						}
+
+						if (timing.isBlocked)
+						{
+							addEntry(sectionItem, timing.url.toDisplayString(), tr("Blocked"));
+						}
+						else
+						{
+							details.append(tr("First byte: %1 ms").arg(QString::number(((timing.firstByteTime - timing.queuedTime) / 1000000.0), 'f', 1)));
+							details.append(tr("Finished: %1 ms").arg(duration));
+							details.append(tr("Size: %1").arg(Utils::formatUnit(timing.bytesReceived, false, 1, true)));
+
+							if (timing.statusCode > 0)
+							{
+								details.append(tr("Status: %1").arg(timing.statusCode));
+							}
+
+							addEntry(sectionItem, timing.url.toDisplayString(), (timing.isCached ? tr("%1 ms (cached)") : tr("%1 ms")).arg(duration));
+						}
+
+						QStandardItem *labelItem(sectionItem->child((sectionItem->rowCount() - 1), 0));
+						QStandardItem *valueItem(sectionItem->child((sectionItem->rowCount() - 1), 1));
+						const QString toolTip(timing.url.toDisplayString() + QLatin1Char('\n') + details.join(QLatin1Char('\n')));
+
+						labelItem->setToolTip(toolTip);
+
+						valueItem->setToolTip(toolTip);
+
+						if (totalTime > 0)
+						{
+							valueItem->setData((static_cast<qreal>(timing.queuedTime) / totalTime), QueuedTimeRole);
+							valueItem->setData((static_cast<qreal>(timing.queuedTime + qMax(qint64(0), timing.contentBlockingDuration)) / totalTime), ContentBlockingTimeRole);
+							valueItem->setData((static_cast<qreal>(timing.isBlocked ? timing.finishedTime : timing.firstByteTime) / totalTime), FirstByteTimeRole);
+							valueItem->setData((static_cast<qreal>(timing.finishedTime) / totalTime), FinishedTimeRole);
+						}
+					}
+				}
+
 				break;
 			case PermissionsSection:
 				m_ui->informationViewWidget->setData(index, tr("Permissions"), Qt::DisplayRole);
@@ -267,14 +371,96 @@ void PageInformationContentsWidget::handleWatchedDataChanged(WebWidget::ChangeWa
 	}
 }
 
+void PageInformationContentsWidget::exportNetworkLog()
+{
+	if (!m_window || !m_window->getWebWidget())
+	{
+		return;
+	}
+
+	const SaveInformation information(Utils::getSavePath(Utils::extractHost(m_window->getUrl()) + QLatin1String(".har"), {}, {tr("HTTP Archive files (*.har)")}));
+
+	if (!information.canSave)
+	{
+		return;
+	}
+
+	const QVector<NetworkManager::RequestTimingInformation> timings(m_window->getWebWidget()->getRequestTimings());
+	QDateTime startDateTime;
+	QJsonArray entriesArray;
+
+	for (int i = 0; i < timings.count(); ++i)
+	{
+		const NetworkManager::RequestTimingInformation timing(timings.at(i));
+		const qreal contentBlockingTime((timing.contentBlockingDuration >= 0) ? (timing.contentBlockingDuration / 1000000.0) : -1);
+		const qreal waitingTime(timing.isBlocked ? 0 : ((timing.firstByteTime - timing.queuedTime - qMax(qint64(0), timing.contentBlockingDuration)) / 1000000.0));
+		const qreal receivingTime(timing.isBlocked ? 0 : ((timing.finishedTime - timing.firstByteTime) / 1000000.0));
+		const QList<QPair<QString, QString> > queryItems(QUrlQuery(timing.url).queryItems(QUrl::FullyDecoded));
+		QJsonArray queryStringArray;
+
+		for (int j = 0; j < queryItems.count(); ++j)
+		{
+			queryStringArray.append(QJsonObject({{QLatin1String("name"), queryItems.at(j).first}, {QLatin1String("value"), queryItems.at(j).second}}));
+		}
+
+		if (!startDateTime.isValid() || timing.startDateTime < startDateTime)
+		{
+			startDateTime = timing.startDateTime;
+		}
+
+		QJsonObject timingsObject({{QLatin1String("blocked"), contentBlockingTime}, {QLatin1String("dns"), -1}, {QLatin1String("connect"), -1}, {QLatin1String("send"), 0}, {QLatin1String("wait"), waitingTime}, {QLatin1String("receive"), receivingTime}, {QLatin1String("ssl"), -1}});
+
+		if (timing.proxyResolutionDuration >= 0)
+		{
+			timingsObject.insert(QLatin1String("_proxyResolution"), (timing.proxyResolutionDuration / 1000000.0));
+		}
+
+		QJsonObject entryObject({{QLatin1String("pageref"), QLatin1String("page_1")}, {QLatin1String("startedDateTime"), timing.startDateTime.toString(QLatin1String("yyyy-MM-ddTHH:mm:ss.zzzZ"))}, {QLatin1String("time"), ((timing.finishedTime - timing.queuedTime) / 1000000.0)}, {QLatin1String("cache"), QJsonObject()}, {QLatin1String("timings"), timingsObject}});
+		entryObject.insert(QLatin1String("request"), QJsonObject({{QLatin1String("method"), timing.method}, {QLatin1String("url"), timing.url.toString()}, {QLatin1String("httpVersion"), QString()}, {QLatin1String("cookies"), QJsonArray()}, {QLatin1String("headers"), QJsonArray()}, {QLatin1String("queryString"), queryStringArray}, {QLatin1String("headersSize"), -1}, {QLatin1String("bodySize"), -1}}));
+		entryObject.insert(QLatin1String("response"), QJsonObject({{QLatin1String("status"), timing.statusCode}, {QLatin1String("statusText"), QString()}, {QLatin1String("httpVersion"), QString()}, {QLatin1String("cookies"), QJsonArray()}, {QLatin1String("headers"), QJsonArray()}, {QLatin1String("content"), QJsonObject({{QLatin1String("size"), timing.bytesReceived}, {QLatin1String("mimeType"), timing.mimeType}})}, {QLatin1String("redirectURL"), QString()}, {QLatin1String("headersSize"), -1}, {QLatin1String("bodySize"), (timing.isCached ? 0 : timing.bytesReceived)}}));
+
+		if (timing.isBlocked)
+		{
+			entryObject.insert(QLatin1String("_isBlocked"), true);
+		}
+
+		entriesArray.append(entryObject);
+	}
+
+	const QJsonObject pageObject({{QLatin1String("startedDateTime"), startDateTime.toString(QLatin1String("yyyy-MM-ddTHH:mm:ss.zzzZ"))}, {QLatin1String("id"), QLatin1String("page_1")}, {QLatin1String("title"), m_window->getTitle()}, {QLatin1String("pageTimings"), QJsonObject({{QLatin1String("onContentLoad"), -1}, {QLatin1String("onLoad"), -1}})}});
+	const QJsonObject logObject({{QLatin1String("version"), QLatin1String("1.2")}, {QLatin1String("creator"), QJsonObject({{QLatin1String("name"), QCoreApplication::applicationName()}, {QLatin1String("version"), Application::getFullVersion()}})}, {QLatin1String("pages"), QJsonArray({pageObject})}, {QLatin1String("entries"), entriesArray}});
+	QSaveFile file(information.path);
+
+	if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(QJsonObject({{QLatin1String("log"), logObject}})).toJson(QJsonDocument::Indented)) < 0 || !file.commit())
+	{
+		QMessageBox::critical(this, tr("Error"), tr("Failed to open file for writing."), QMessageBox::Close);
+	}
+}
+
 void PageInformationContentsWidget::showContextMenu(const QPoint &position)
 {
 	const QModelIndex index(m_ui->informationViewWidget->indexAt(position));
+	const bool hasRequestTimings(m_window && m_window->getWebWidget() && !m_window->getWebWidget()->getRequestTimings().isEmpty());
 
-	if (index.isValid())
+	if (index.isValid() || hasRequestTimings)
 	{
 		QMenu menu(this);
-		menu.addAction(new Action(ActionsManager::CopyAction, {}, ActionExecutor::Object(this, this), &menu));
+
+		if (index.isValid())
+		{
+			menu.addAction(new Action(ActionsManager::CopyAction, {}, ActionExecutor::Object(this, this), &menu));
+		}
+
+		if (hasRequestTimings)
+		{
+			if (index.isValid())
+			{
+				menu.addSeparator();
+			}
+
+			menu.addAction(tr("Export Network Log…"), this, &PageInformationContentsWidget::exportNetworkLog);
+		}
+
 		menu.exec(m_ui->informationViewWidget->mapToGlobal(position));
 	}
 }
@@ -21,6 +21,7 @@
 #define OTTER_PAGEINFORMATIONCONTENTSWIDGET_H
 
 #include "../../../ui/ContentsWidget.h"
+#include "../../../ui/ItemDelegate.h"
 
 #include <QtGui/QStandardItem>
 
@@ -34,6 +35,14 @@ namespace Ui
 
 class Window;
 
+class RequestTimingDelegate final : public ItemDelegate
+{
+public:
+	explicit RequestTimingDelegate(QObject *parent);
+
+	void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
 class PageInformationContentsWidget final : public ContentsWidget
 {
 	Q_OBJECT
@@ -45,10 +54,19 @@ public:
 		GeneralSection,
 		HeadersSection,
 		MetaSection,
+		NetworkSection,
 		PermissionsSection,
 		SecuritySection
 	};
 
+	enum DataRole
+	{
+		QueuedTimeRole = (Qt::UserRole + 1),
+		ContentBlockingTimeRole,
+		FirstByteTimeRole,
+		FinishedTimeRole
+	};
+
 	explicit PageInformationContentsWidget(const QVariantMap &parameters, QWidget *parent);
 	~PageInformationContentsWidget();
 
@@ -68,6 +86,7 @@ protected:
 
 protected slots:
 	void handleWatchedDataChanged(WebWidget::ChangeWatcher watcher);
+	void exportNetworkLog();
 	void showContextMenu(const QPoint &position);
 
 private:
@@ -0,0 +1,162 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "StartupContentsWidget.h"
+#include "../../../core/StartupManager.h"
+#include "../../../core/ThemesManager.h"
+#include "../../../ui/ItemViewWidget.h"
+
+#include "ui_StartupContentsWidget.h"
+
+#include <QtGui/QClipboard>
+#include <QtGui/QGuiApplication>
+
+namespace Otter
+{
+
+StartupContentsWidget::StartupContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent) : ContentsWidget(parameters, window, parent),
+	m_model(new QStandardItemModel(this)),
+	m_ui(new Ui::StartupContentsWidget)
+{
+	m_ui->setupUi(this);
+	m_ui->filterLineEditWidget->setClearOnEscape(true);
+	m_ui->timelineViewWidget->setViewMode(ItemViewWidget::ListView);
+	m_ui->timelineViewWidget->setModel(m_model);
+	m_ui->timelineViewWidget->setFilterRoles({Qt::DisplayRole});
+
+	populateTimeline();
+
+	connect(StartupManager::getInstance(), &StartupManager::timelineChanged, this, &StartupContentsWidget::populateTimeline);
+	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, m_ui->timelineViewWidget, &ItemViewWidget::setFilterString);
+}
+
+StartupContentsWidget::~StartupContentsWidget()
+{
+	delete m_ui;
+}
+
+void StartupContentsWidget::changeEvent(QEvent *event)
+{
+	ContentsWidget::changeEvent(event);
+
+	if (event->type() == QEvent::LanguageChange)
+	{
+		m_ui->retranslateUi(this);
+
+		populateTimeline();
+	}
+}
+
+void StartupContentsWidget::print(QPrinter *printer)
+{
+	m_ui->timelineViewWidget->render(printer);
+}
+
+void StartupContentsWidget::triggerAction(int identifier, const QVariantMap &parameters, ActionsManager::TriggerType trigger)
+{
+	switch (identifier)
+	{
+		case ActionsManager::CopyAction:
+			QGuiApplication::clipboard()->setText(StartupManager::createReport());
+
+			break;
+		case ActionsManager::SelectAllAction:
+			m_ui->timelineViewWidget->selectAll();
+
+			break;
+		case ActionsManager::FindAction:
+		case ActionsManager::QuickFindAction:
+			m_ui->filterLineEditWidget->setFocus();
+
+			break;
+		case ActionsManager::ActivateContentAction:
+			m_ui->timelineViewWidget->setFocus();
+
+			break;
+		default:
+			ContentsWidget::triggerAction(identifier, parameters, trigger);
+
+			break;
+	}
+}
+
+void StartupContentsWidget::populateTimeline()
+{
+	const QVector<StartupManager::PhaseInformation> timeline(StartupManager::getTimeline());
+
+	m_model->clear();
+	m_model->setHorizontalHeaderLabels({tr("Phase"), tr("Thread"), tr("Start"), tr("Duration")});
+	m_model->setHeaderData(0, Qt::Horizontal, 300, HeaderViewWidget::WidthRole);
+
+	for (int i = 0; i < timeline.count(); ++i)
+	{
+		const StartupManager::PhaseInformation phase(timeline.at(i));
+		QString type;
+
+		switch (phase.type)
+		{
+			case StartupManager::WorkerThreadPhase:
+				type = tr("Worker");
+
+				break;
+			case StartupManager::DeferredPhase:
+				type = tr("Deferred");
+
+				break;
+			case StartupManager::MilestonePhase:
+				type = tr("Milestone");
+
+				break;
+			default:
+				type = tr("Main");
+
+				break;
+		}
+
+		QList<QStandardItem*> items({new QStandardItem(phase.name), new QStandardItem(type), new QStandardItem(tr("%1 ms").arg(QString::number((phase.startTime / 1000000.0), 'f', 2))), new QStandardItem((phase.type == StartupManager::MilestonePhase) ? QString() : tr("%1 ms").arg(QString::number((phase.duration / 1000000.0), 'f', 2)))});
+		items[0]->setFlags(items[0]->flags() | Qt::ItemNeverHasChildren);
+		items[1]->setFlags(items[1]->flags() | Qt::ItemNeverHasChildren);
+		items[2]->setFlags(items[2]->flags() | Qt::ItemNeverHasChildren);
+		items[3]->setFlags(items[3]->flags() | Qt::ItemNeverHasChildren);
+
+		m_model->appendRow(items);
+	}
+}
+
+QString StartupContentsWidget::getTitle() const
+{
+	return tr("Startup Timeline");
+}
+
+QLatin1String StartupContentsWidget::getType() const
+{
+	return QLatin1String("startup");
+}
+
+QUrl StartupContentsWidget::getUrl() const
+{
+	return QUrl(QLatin1String("about:startup"));
+}
+
+QIcon StartupContentsWidget::getIcon() const
+{
+	return ThemesManager::createIcon(QLatin1String("view-information"), false);
+}
+
+}
@@ -0,0 +1,67 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2019 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_STARTUPCONTENTSWIDGET_H
+#define OTTER_STARTUPCONTENTSWIDGET_H
+
+#include "../../../ui/ContentsWidget.h"
+
+#include <QtGui/QStandardItemModel>
+
+namespace Otter
+{
+
+namespace Ui
+{
+	class StartupContentsWidget;
+}
+
+class Window;
+
+class StartupContentsWidget final : public ContentsWidget
+{
+	Q_OBJECT
+
+public:
+	explicit StartupContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent);
+	~StartupContentsWidget();
+
+	void print(QPrinter *printer) override;
+	QString getTitle() const override;
+	QLatin1String getType() const override;
+	QUrl getUrl() const override;
+	QIcon getIcon() const override;
+
+public slots:
+	void triggerAction(int identifier, const QVariantMap &parameters = {}, ActionsManager::TriggerType trigger = ActionsManager::UnknownTrigger) override;
+
+protected:
+	void changeEvent(QEvent *event) override;
+
+protected slots:
+	void populateTimeline();
+
+private:
+	QStandardItemModel *m_model;
+	Ui::StartupContentsWidget *m_ui;
+};
+
+}
+
+#endif
@@ -24,17 +24,25 @@
 #include "../../../core/SettingsManager.h"
 #include "../../../core/WebBackend.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeData>
+#include <QtCore/QTimer>
+#include <QtGui/QImage>
 #include <QtGui/QPainter>
 
+#define THUMBNAILS_CACHE_LIMIT 65536
+
 namespace Otter
 {
 
 StartPageModel::StartPageModel(QObject *parent) : QStandardItemModel(parent),
 	m_bookmark(nullptr)
 {
+	m_thumbnails.setMaxCost(THUMBNAILS_CACHE_LIMIT);
+
 	handleOptionChanged(SettingsManager::Backends_WebOption);
 	reloadModel();
 
@@ -59,37 +67,9 @@ void StartPageModel::reloadModel()
 		{
 			const BookmarksModel::Bookmark *bookmark(static_cast<BookmarksModel::Bookmark*>(m_bookmark->child(i)));
 
-			if (bookmark)
+			if (isTile(bookmark))
 			{
-				const BookmarksModel::BookmarkType type(bookmark->getType());
-
-				if (type != BookmarksModel::UrlBookmark && type != BookmarksModel::FolderBookmark)
-				{
-					continue;
-				}
-
-				const quint64 identifier(bookmark->getIdentifier());
-				const QUrl url(bookmark->getUrl());
-				QStandardItem *item(bookmark->clone());
-				item->setData(identifier, BookmarksModel::IdentifierRole);
-				item->setData(bookmark->getTitle(), Qt::ToolTipRole);
-				item->setFlags(item->flags() | Qt::ItemNeverHasChildren);
-
-				if (type == BookmarksModel::FolderBookmark && bookmark->rowCount() == 0)
-				{
-					item->setEnabled(false);
-				}
-				else if (url.isValid() && SettingsManager::getOption(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail") && !QFile::exists(getThumbnailPath(identifier)))
-				{
-					ThumbnailRequestInformation thumbnailRequestInformation;
-					thumbnailRequestInformation.bookmarkIdentifier = identifier;
-
-					m_reloads[url] = thumbnailRequestInformation;
-
-					AddonsManager::getWebBackend()->requestThumbnail(url, QSize(SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt()));
-				}
-
-				appendRow(item);
+				appendRow(createTile(bookmark));
 			}
 		}
 	}
@@ -208,6 +188,139 @@ void StartPageModel::reloadTile(const QModelIndex &index, bool needsTitleUpdate)
 	}
 }
 
+void StartPageModel::loadThumbnail(quint64 identifier)
+{
+	if (identifier == 0 || m_thumbnailLoads.contains(identifier))
+	{
+		return;
+	}
+
+	const QString path(getThumbnailPath(identifier));
+	const QSize size(getTileSize());
+
+	m_thumbnailLoads.insert(identifier);
+
+	QFutureWatcher<QImage> *watcher(new QFutureWatcher<QImage>(this));
+
+	connect(watcher, &QFutureWatcher<QImage>::finished, this, [=]()
+	{
+		m_thumbnailLoads.remove(identifier);
+
+		if (!m_thumbnails.contains(identifier))
+		{
+			cacheThumbnail(identifier, QPixmap::fromImage(watcher->result()));
+		}
+
+		watcher->deleteLater();
+	});
+
+	watcher->setFuture(QtConcurrent::run([=]() -> QImage
+	{
+		QImage image(path);
+
+		if (!image.isNull() && !size.isEmpty() && image.size() != size)
+		{
+			image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+		}
+
+		return image;
+	}));
+}
+
+void StartPageModel::loadRequestedThumbnails()
+{
+	const QSet<quint64> identifiers(m_requestedThumbnails);
+
+	m_requestedThumbnails.clear();
+
+	QSet<quint64>::const_iterator iterator;
+
+	for (iterator = identifiers.constBegin(); iterator != identifiers.constEnd(); ++iterator)
+	{
+		if (!m_thumbnails.contains(*iterator))
+		{
+			loadThumbnail(*iterator);
+		}
+	}
+}
+
+void StartPageModel::cacheThumbnail(quint64 identifier, const QPixmap &thumbnail)
+{
+	m_thumbnails.insert(identifier, new QPixmap(thumbnail), qMax(1, ((thumbnail.width() * thumbnail.height() * 4) / 1024)));
+
+	const int row(findTile(identifier));
+
+	if (row >= 0)
+	{
+		emit dataChanged(index(row, 0), index(row, 0), {ThumbnailRole});
+	}
+}
+
+void StartPageModel::insertTile(BookmarksModel::Bookmark *bookmark)
+{
+	if (findTile(bookmark->getIdentifier()) >= 0)
+	{
+		updateTile(bookmark);
+
+		return;
+	}
+
+	if (!isTile(bookmark))
+	{
+		return;
+	}
+
+	int row(0);
+
+	for (int i = 0; i < bookmark->row(); ++i)
+	{
+		if (isTile(static_cast<BookmarksModel::Bookmark*>(m_bookmark->child(i))))
+		{
+			++row;
+		}
+	}
+
+	insertRow(row, createTile(bookmark));
+
+	emit modelModified();
+}
+
+void StartPageModel::removeTile(quint64 identifier)
+{
+	const int row(findTile(identifier));
+
+	if (row >= 0)
+	{
+		removeRow(row);
+
+		emit modelModified();
+	}
+}
+
+void StartPageModel::updateTile(BookmarksModel::Bookmark *bookmark)
+{
+	if (!bookmark)
+	{
+		return;
+	}
+
+	const int row(findTile(bookmark->getIdentifier()));
+
+	if (row < 0)
+	{
+		return;
+	}
+
+	if (isTile(bookmark))
+	{
+		setItem(row, createTile(bookmark));
+	}
+	else
+	{
+		removeTile(bookmark->getIdentifier());
+	}
+}
+
 void StartPageModel::handleOptionChanged(int identifier)
 {
 	switch (identifier)
@@ -220,6 +333,11 @@ void StartPageModel::handleOptionChanged(int identifier)
 		case SettingsManager::StartPage_ShowAddTileOption:
 			reloadModel();
 
+			break;
+		case SettingsManager::StartPage_TileHeightOption:
+		case SettingsManager::StartPage_TileWidthOption:
+			m_thumbnails.clear();
+
 			break;
 		default:
 			break;
@@ -245,44 +363,41 @@ void StartPageModel::handleBookmarkModified(BookmarksModel::Bookmark *bookmark)
 {
 	if (!m_bookmark)
 	{
-		m_bookmark = BookmarksManager::getModel()->getBookmarkByPath(SettingsManager::getOption(SettingsManager::StartPage_BookmarksFolderOption).toString());
+		if (BookmarksManager::getModel()->getBookmarkByPath(SettingsManager::getOption(SettingsManager::StartPage_BookmarksFolderOption).toString()))
+		{
+			reloadModel();
+		}
+
+		return;
 	}
 
-	if (m_bookmark && (bookmark == m_bookmark || m_bookmark->isAncestorOf(bookmark)))
+	if (bookmark == m_bookmark)
 	{
 		reloadModel();
 	}
+	else if (bookmark->parent() == m_bookmark)
+	{
+		insertTile(bookmark);
+	}
+	else if (m_bookmark->isAncestorOf(bookmark))
+	{
+		updateTile(getTileBookmark(bookmark));
+	}
 }
 
 void StartPageModel::handleBookmarkMoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent)
 {
 	if (!m_bookmark)
 	{
-		m_bookmark = BookmarksManager::getModel()->getBookmarkByPath(SettingsManager::getOption(SettingsManager::StartPage_BookmarksFolderOption).toString());
-	}
-
-	if (m_bookmark)
-	{
-		if (bookmark->parent() != m_bookmark)
-		{
-			const QString path(getThumbnailPath(bookmark->getIdentifier()));
-
-			if (QFile::exists(path))
-			{
-				QFile::remove(path);
-			}
-		}
-
-		if (bookmark == m_bookmark || previousParent == m_bookmark || m_bookmark->isAncestorOf(bookmark) || m_bookmark->isAncestorOf(previousParent))
+		if (BookmarksManager::getModel()->getBookmarkByPath(SettingsManager::getOption(SettingsManager::StartPage_BookmarksFolderOption).toString()))
 		{
 			reloadModel();
 		}
+
+		return;
 	}
-}
 
-void StartPageModel::handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent)
-{
-	if (m_bookmark && (bookmark == m_bookmark || previousParent == m_bookmark || m_bookmark->isAncestorOf(previousParent)))
+	if (bookmark->parent() != m_bookmark)
 	{
 		const QString path(getThumbnailPath(bookmark->getIdentifier()));
 
@@ -291,7 +406,77 @@ void StartPageModel::handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, B
 			QFile::remove(path);
 		}
 
+		m_thumbnails.remove(bookmark->getIdentifier());
+	}
+
+	if (bookmark == m_bookmark)
+	{
 		reloadModel();
+
+		return;
+	}
+
+	if (previousParent == m_bookmark)
+	{
+		removeTile(bookmark->getIdentifier());
+	}
+	else if (m_bookmark->isAncestorOf(previousParent))
+	{
+		updateTile(getTileBookmark(previousParent));
+	}
+
+	if (bookmark->parent() == m_bookmark)
+	{
+		insertTile(bookmark);
+	}
+	else if (m_bookmark->isAncestorOf(bookmark))
+	{
+		updateTile(getTileBookmark(bookmark));
+	}
+}
+
+void StartPageModel::handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent)
+{
+	if (!m_bookmark)
+	{
+		return;
+	}
+
+	if (bookmark == m_bookmark || bookmark->isAncestorOf(m_bookmark))
+	{
+		m_bookmark = nullptr;
+
+		QTimer::singleShot(0, this, &StartPageModel::reloadModel);
+
+		return;
+	}
+
+	if (previousParent != m_bookmark && !m_bookmark->isAncestorOf(previousParent))
+	{
+		return;
+	}
+
+	const QString path(getThumbnailPath(bookmark->getIdentifier()));
+
+	if (QFile::exists(path))
+	{
+		QFile::remove(path);
+	}
+
+	m_thumbnails.remove(bookmark->getIdentifier());
+
+	if (previousParent == m_bookmark)
+	{
+		removeTile(bookmark->getIdentifier());
+	}
+	else
+	{
+		const quint64 identifier(getTileBookmark(previousParent)->getIdentifier());
+
+		QTimer::singleShot(0, this, [=]()
+		{
+			updateTile(BookmarksManager::getModel()->getBookmark(identifier));
+		});
 	}
 }
 
@@ -312,6 +497,8 @@ void StartPageModel::handleThumbnailCreated(const QUrl &url, const QPixmap &thum
 		QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
 
 		thumbnail.save(getThumbnailPath(information.bookmarkIdentifier), "png");
+
+		cacheThumbnail(information.bookmarkIdentifier, thumbnail);
 	}
 
 	if (bookmark)
@@ -325,6 +512,33 @@ void StartPageModel::handleThumbnailCreated(const QUrl &url, const QPixmap &thum
 	}
 }
 
+QStandardItem* StartPageModel::createTile(const BookmarksModel::Bookmark *bookmark)
+{
+	const BookmarksModel::BookmarkType type(bookmark->getType());
+	const quint64 identifier(bookmark->getIdentifier());
+	const QUrl url(bookmark->getUrl());
+	QStandardItem *item(bookmark->clone());
+	item->setData(identifier, BookmarksModel::IdentifierRole);
+	item->setData(bookmark->getTitle(), Qt::ToolTipRole);
+	item->setFlags(item->flags() | Qt::ItemNeverHasChildren);
+
+	if (type == BookmarksModel::FolderBookmark && bookmark->rowCount() == 0)
+	{
+		item->setEnabled(false);
+	}
+	else if (url.isValid() && SettingsManager::getOption(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail") && !QFile::exists(getThumbnailPath(identifier)))
+	{
+		ThumbnailRequestInformation thumbnailRequestInformation;
+		thumbnailRequestInformation.bookmarkIdentifier = identifier;
+
+		m_reloads[url] = thumbnailRequestInformation;
+
+		AddonsManager::getWebBackend()->requestThumbnail(url, getTileSize());
+	}
+
+	return item;
+}
+
 QMimeData* StartPageModel::mimeData(const QModelIndexList &indexes) const
 {
 	QMimeData *mimeData(new QMimeData());
@@ -358,6 +572,16 @@ QMimeData* StartPageModel::mimeData(const QModelIndexList &indexes) const
 	return mimeData;
 }
 
+BookmarksModel::Bookmark* StartPageModel::getTileBookmark(BookmarksModel::Bookmark *bookmark) const
+{
+	while (bookmark && bookmark->parent() != m_bookmark)
+	{
+		bookmark = static_cast<BookmarksModel::Bookmark*>(bookmark->parent());
+	}
+
+	return bookmark;
+}
+
 QString StartPageModel::getThumbnailPath(quint64 identifier)
 {
 	return SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + QLatin1String(".png");
@@ -370,6 +594,29 @@ QVariant StartPageModel::data(const QModelIndex &index, int role) const
 		return m_reloads.contains(index.data(BookmarksModel::UrlRole).toUrl());
 	}
 
+	if (role == ThumbnailRole)
+	{
+		const quint64 identifier(index.data(BookmarksModel::IdentifierRole).toULongLong());
+		const QPixmap *thumbnail(m_thumbnails.object(identifier));
+
+		if (thumbnail)
+		{
+			return *thumbnail;
+		}
+
+		if (identifier > 0 && !m_thumbnailLoads.contains(identifier))
+		{
+			if (m_requestedThumbnails.isEmpty())
+			{
+				QTimer::singleShot(0, this, &StartPageModel::loadRequestedThumbnails);
+			}
+
+			m_requestedThumbnails.insert(identifier);
+		}
+
+		return {};
+	}
+
 	return QStandardItemModel::data(index, role);
 }
 
@@ -378,6 +625,36 @@ QStringList StartPageModel::mimeTypes() const
 	return {QLatin1String("text/uri-list")};
 }
 
+QSize StartPageModel::getTileSize()
+{
+	return QSize(SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt());
+}
+
+int StartPageModel::findTile(quint64 identifier) const
+{
+	for (int i = 0; i < rowCount(); ++i)
+	{
+		if (item(i)->data(BookmarksModel::IdentifierRole).toULongLong() == identifier)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool StartPageModel::isTile(const BookmarksModel::Bookmark *bookmark)
+{
+	if (!bookmark)
+	{
+		return false;
+	}
+
+	const BookmarksModel::BookmarkType type(bookmark->getType());
+
+	return (type == BookmarksModel::UrlBookmark || type == BookmarksModel::FolderBookmark);
+}
+
 bool StartPageModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent)
 {
 	Q_UNUSED(action)
@@ -22,6 +22,10 @@
 
 #include "../../../core/BookmarksModel.h"
 
+#include <QtCore/QCache>
+#include <QtCore/QSet>
+#include <QtGui/QPixmap>
+
 namespace Otter
 {
 
@@ -33,7 +37,8 @@ public:
 	enum
 	{
 		IsDraggedRole = BookmarksModel::UserRole,
-		IsReloadingRole
+		IsReloadingRole,
+		ThumbnailRole
 	};
 
 	explicit StartPageModel(QObject *parent = nullptr);
@@ -57,6 +62,17 @@ protected:
 		bool needsTitleUpdate = false;
 	};
 
+	void loadThumbnail(quint64 identifier);
+	void cacheThumbnail(quint64 identifier, const QPixmap &thumbnail);
+	void insertTile(BookmarksModel::Bookmark *bookmark);
+	void removeTile(quint64 identifier);
+	void updateTile(BookmarksModel::Bookmark *bookmark);
+	QStandardItem* createTile(const BookmarksModel::Bookmark *bookmark);
+	BookmarksModel::Bookmark* getTileBookmark(BookmarksModel::Bookmark *bookmark) const;
+	static QSize getTileSize();
+	int findTile(quint64 identifier) const;
+	static bool isTile(const BookmarksModel::Bookmark *bookmark);
+
 protected slots:
 	void handleOptionChanged(int identifier);
 	void handleDragEnded();
@@ -64,10 +80,14 @@ protected slots:
 	void handleBookmarkMoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent);
 	void handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent);
 	void handleThumbnailCreated(const QUrl &url, const QPixmap &thumbnail, const QString &title);
+	void loadRequestedThumbnails();
 
 private:
 	BookmarksModel::Bookmark *m_bookmark;
 	QHash<QUrl, ThumbnailRequestInformation> m_reloads;
+	QCache<quint64, QPixmap> m_thumbnails;
+	QSet<quint64> m_thumbnailLoads;
+	mutable QSet<quint64> m_requestedThumbnails;
 
 signals:
 	void modelModified();
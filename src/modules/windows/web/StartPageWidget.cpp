@@ -136,7 +136,7 @@ void TileDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 				painter->setBrush(Qt::white);
 				painter->setPen(Qt::transparent);
 				painter->drawRect(rectangle);
-				painter->drawPixmap(rectangle, QPixmap(StartPageModel::getThumbnailPath(index.data(BookmarksModel::IdentifierRole).toULongLong())), QRect(0, 0, rectangle.width(), rectangle.height()));
+				painter->drawPixmap(rectangle, index.data(StartPageModel::ThumbnailRole).value<QPixmap>(), QRect(0, 0, rectangle.width(), rectangle.height()));
 
 				break;
 			default:
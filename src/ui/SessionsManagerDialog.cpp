@@ -21,6 +21,7 @@
 #include "MainWindow.h"
 #include "../core/Application.h"
 #include "../core/SessionsManager.h"
+#include "../core/Utils.h"
 
 #include "ui_SessionsManagerDialog.h"
 
@@ -78,6 +79,7 @@ SessionsManagerDialog::SessionsManagerDialog(QWidget *parent) : Dialog(parent),
 
 	connect(m_ui->openButton, &QPushButton::clicked, this, &SessionsManagerDialog::openSession);
 	connect(m_ui->deleteButton, &QPushButton::clicked, this, &SessionsManagerDialog::deleteSession);
+	connect(m_ui->exportButton, &QPushButton::clicked, this, &SessionsManagerDialog::exportSession);
 	connect(m_ui->sessionsViewWidget, &ItemViewWidget::needsActionsUpdate, this, &SessionsManagerDialog::updateActions);
 
 	m_ui->sessionsViewWidget->setCurrentIndex(m_ui->sessionsViewWidget->getIndex(row, 0));
@@ -133,6 +135,17 @@ void SessionsManagerDialog::deleteSession()
 	}
 }
 
+void SessionsManagerDialog::exportSession()
+{
+	const QString identifier(m_ui->sessionsViewWidget->getIndex(m_ui->sessionsViewWidget->getCurrentRow(), 1).data(Qt::DisplayRole).toString());
+	const SaveInformation information(Utils::getSavePath(identifier + QLatin1String(".json"), {}, {tr("JSON files (*.json)")}));
+
+	if (information.canSave && !SessionsManager::exportSession(SessionsManager::getSession(identifier), information.path))
+	{
+		QMessageBox::critical(this, tr("Error"), tr("Failed to export session."), QMessageBox::Close);
+	}
+}
+
 void SessionsManagerDialog::updateActions()
 {
 	m_ui->deleteButton->setEnabled(m_ui->sessionsViewWidget->getIndex(m_ui->sessionsViewWidget->getCurrentRow(), 1).data(Qt::DisplayRole).toString() != QLatin1String("default"));
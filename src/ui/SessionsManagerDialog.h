@@ -44,6 +44,7 @@ protected:
 protected slots:
 	void openSession();
 	void deleteSession();
+	void exportSession();
 	void updateActions();
 
 private:
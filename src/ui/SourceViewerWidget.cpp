@@ -24,16 +24,21 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QStringMatcher>
 #include <QtGui/QPainter>
 #include <QtGui/QTextBlock>
 #include <QtWidgets/QScrollBar>
 
+#define MAXIMUM_HIGHLIGHTED_LENGTH 50000
+
 namespace Otter
 {
 
 QMap<SyntaxHighlighter::HighlightingSyntax, QMap<SyntaxHighlighter::HighlightingState, QTextCharFormat> > SyntaxHighlighter::m_formats;
 
-SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter(parent)
+SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter(parent),
+	m_firstHighlightedBlock(0),
+	m_lastHighlightedBlock(100)
 {
 	if (m_formats[HtmlSyntax].isEmpty())
 	{
@@ -95,12 +100,24 @@ SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter
 
 void SyntaxHighlighter::highlightBlock(const QString &text)
 {
-	QString buffer;
+	const int blockNumber(currentBlock().blockNumber());
+	const int previousBlockState(this->previousBlockState());
+
+	if (blockNumber > m_lastHighlightedBlock || (blockNumber > 0 && previousBlockState < 0))
+	{
+		setCurrentBlockState(PendingBlockState);
+
+		return;
+	}
+
+	const bool needsFormatting(blockNumber >= m_firstHighlightedBlock);
+	const int length(qMin(text.length(), MAXIMUM_HIGHLIGHTED_LENGTH));
 	BlockData currentData;
-	HighlightingState previousState(static_cast<HighlightingState>(qMax(previousBlockState(), 0)));
+	HighlightingState previousState(static_cast<HighlightingState>(qMax(previousBlockState, 0)));
 	HighlightingState currentState(previousState);
 	int previousStateBegin(0);
 	int currentStateBegin(0);
+	int bufferBegin(0);
 	int position(0);
 
 	if (currentBlock().previous().userData())
@@ -108,13 +125,12 @@ void SyntaxHighlighter::highlightBlock(const QString &text)
 		currentData = *static_cast<BlockData*>(currentBlock().previous().userData());
 	}
 
-	while (position < text.length())
+	while (position < length)
 	{
-		buffer.append(text.at(position));
-
 		++position;
 
-		const bool isEndOfLine(position == text.length());
+		const QStringRef buffer(text.midRef(bufferBegin, (position - bufferBegin)));
+		const bool isEndOfLine(position == length);
 
 		if (currentState == NoState && text.at(position - 1) == QLatin1Char('<'))
 		{
@@ -126,7 +142,7 @@ void SyntaxHighlighter::highlightBlock(const QString &text)
 			currentState = NoState;
 			currentStateBegin = position;
 		}
-		else if (currentState == AttributeState && text.length() > position && text.at(position) == QLatin1Char('>'))
+		else if (currentState == AttributeState && length > position && text.at(position) == QLatin1Char('>'))
 		{
 			currentState = KeywordState;
 			currentStateBegin = position;
@@ -180,31 +196,85 @@ void SyntaxHighlighter::highlightBlock(const QString &text)
 
 		if (previousState != currentState || isEndOfLine)
 		{
-			setFormat(previousStateBegin, (position - previousStateBegin), m_formats[HtmlSyntax][previousState]);
-
-			if (isEndOfLine)
+			if (needsFormatting)
 			{
-				setFormat(currentStateBegin, (position - currentStateBegin), m_formats[HtmlSyntax][currentState]);
+				setFormat(previousStateBegin, (position - previousStateBegin), m_formats[HtmlSyntax][previousState]);
+
+				if (isEndOfLine)
+				{
+					setFormat(currentStateBegin, (position - currentStateBegin), m_formats[HtmlSyntax][currentState]);
+				}
 			}
 
-			buffer.clear();
+			bufferBegin = position;
 			previousState = currentState;
 			previousStateBegin = currentStateBegin;
 		}
 	}
 
-	if (!currentData.context.isEmpty())
+	if (text.length() > MAXIMUM_HIGHLIGHTED_LENGTH)
+	{
+		currentState = NoState;
+		currentData.context.clear();
+		currentData.state = NoState;
+	}
+
+	if (!currentData.context.isEmpty() || !needsFormatting)
 	{
 		BlockData *nextBlockData(new BlockData());
 		nextBlockData->context = currentData.context;
 		nextBlockData->state = currentData.state;
+		nextBlockData->isFormatted = needsFormatting;
 
 		setCurrentBlockUserData(nextBlockData);
 	}
+	else
+	{
+		setCurrentBlockUserData(nullptr);
+	}
 
 	setCurrentBlockState(currentState);
 }
 
+void SyntaxHighlighter::setHighlightingRange(int firstBlock, int lastBlock)
+{
+	m_firstHighlightedBlock = firstBlock;
+	m_lastHighlightedBlock = lastBlock;
+
+	const QTextDocument *document(this->document());
+	int pendingBlock(0);
+	int lastPendingBlock(document->blockCount());
+
+	while (pendingBlock < lastPendingBlock)
+	{
+		const int middleBlock((pendingBlock + lastPendingBlock) / 2);
+
+		if (document->findBlockByNumber(middleBlock).userState() < 0)
+		{
+			lastPendingBlock = middleBlock;
+		}
+		else
+		{
+			pendingBlock = (middleBlock + 1);
+		}
+	}
+
+	if (pendingBlock <= lastBlock && pendingBlock < document->blockCount())
+	{
+		rehighlightBlock(document->findBlockByNumber(pendingBlock));
+	}
+
+	for (QTextBlock block(document->findBlockByNumber(qMax(0, firstBlock))); block.isValid() && block.blockNumber() <= lastBlock; block = block.next())
+	{
+		const BlockData *blockData(static_cast<BlockData*>(block.userData()));
+
+		if (block.userState() >= 0 && blockData && !blockData->isFormatted)
+		{
+			rehighlightBlock(block);
+		}
+	}
+}
+
 MarginWidget::MarginWidget(SourceViewerWidget *parent) : QWidget(parent),
 	m_sourceViewer(parent),
 	m_lastClickedLine(-1)
@@ -329,19 +399,22 @@ bool MarginWidget::event(QEvent *event)
 
 SourceViewerWidget::SourceViewerWidget(QWidget *parent) : QPlainTextEdit(parent),
 	m_marginWidget(nullptr),
+	m_syntaxHighlighter(new SyntaxHighlighter(document())),
 	m_findFlags(WebWidget::NoFlagsFind),
+	m_findResultsCaseSensitivity(Qt::CaseInsensitive),
+	m_findResultsRevision(-1),
 	m_findTextResultsAmount(0),
-	m_zoom(100)
+	m_zoom(100),
+	m_isUpdatingVisibleRange(false)
 {
-	new SyntaxHighlighter(document());
-
 	setZoom(SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
 	handleOptionChanged(SettingsManager::Interface_ShowScrollBarsOption, SettingsManager::getOption(SettingsManager::Interface_ShowScrollBarsOption));
 	handleOptionChanged(SettingsManager::SourceViewer_ShowLineNumbersOption, SettingsManager::getOption(SettingsManager::SourceViewer_ShowLineNumbersOption));
 	handleOptionChanged(SettingsManager::SourceViewer_WrapLinesOption, SettingsManager::getOption(SettingsManager::SourceViewer_WrapLinesOption));
 
-	connect(this, &SourceViewerWidget::textChanged, this, &SourceViewerWidget::updateSelection);
+	connect(this, &SourceViewerWidget::textChanged, this, &SourceViewerWidget::updateVisibleRange);
 	connect(this, &SourceViewerWidget::cursorPositionChanged, this, &SourceViewerWidget::updateTextCursor);
+	connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &SourceViewerWidget::updateVisibleRange);
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &SourceViewerWidget::handleOptionChanged);
 }
 
@@ -353,6 +426,8 @@ void SourceViewerWidget::resizeEvent(QResizeEvent *event)
 	{
 		m_marginWidget->setGeometry(QRect(contentsRect().left(), contentsRect().top(), m_marginWidget->width(), contentsRect().height()));
 	}
+
+	updateVisibleRange();
 }
 
 void SourceViewerWidget::focusInEvent(QFocusEvent *event)
@@ -379,6 +454,37 @@ void SourceViewerWidget::wheelEvent(QWheelEvent *event)
 	QPlainTextEdit::wheelEvent(event);
 }
 
+void SourceViewerWidget::updateFindResults()
+{
+	const Qt::CaseSensitivity caseSensitivity(m_findFlags.testFlag(WebWidget::CaseSensitiveFind) ? Qt::CaseSensitive : Qt::CaseInsensitive);
+
+	if (m_findResultsRevision == document()->revision() && m_findResultsText == m_findText && m_findResultsCaseSensitivity == caseSensitivity)
+	{
+		return;
+	}
+
+	m_findResults.clear();
+	m_findResultsText = m_findText;
+	m_findResultsCaseSensitivity = caseSensitivity;
+	m_findResultsRevision = document()->revision();
+
+	if (m_findText.isEmpty())
+	{
+		return;
+	}
+
+	const QString text(toPlainText());
+	const QStringMatcher matcher(m_findText, caseSensitivity);
+	int position(matcher.indexIn(text));
+
+	while (position >= 0)
+	{
+		m_findResults.append(position);
+
+		position = matcher.indexIn(text, (position + m_findText.length()));
+	}
+}
+
 void SourceViewerWidget::handleOptionChanged(int identifier, const QVariant &value)
 {
 	switch (identifier)
@@ -406,6 +512,7 @@ void SourceViewerWidget::handleOptionChanged(int identifier, const QVariant &val
 			break;
 		case SettingsManager::SourceViewer_WrapLinesOption:
 			setLineWrapMode(value.toBool() ? QPlainTextEdit::WidgetWidth : QPlainTextEdit::NoWrap);
+			updateVisibleRange();
 
 			break;
 		default:
@@ -418,6 +525,26 @@ void SourceViewerWidget::updateTextCursor()
 	m_findTextAnchor = textCursor();
 }
 
+void SourceViewerWidget::updateVisibleRange()
+{
+	if (m_isUpdatingVisibleRange)
+	{
+		return;
+	}
+
+	m_isUpdatingVisibleRange = true;
+
+	const int firstBlock(firstVisibleBlock().blockNumber());
+	const int lastBlock(getLastVisibleBlock().blockNumber());
+	const int blocksAmount(qMax(1, (lastBlock - firstBlock + 1)));
+
+	m_syntaxHighlighter->setHighlightingRange(qMax(0, (firstBlock - blocksAmount)), (lastBlock + (blocksAmount * 2)));
+
+	updateSelection();
+
+	m_isUpdatingVisibleRange = false;
+}
+
 void SourceViewerWidget::updateSelection()
 {
 	QList<QTextEdit::ExtraSelection> extraSelections;
@@ -431,7 +558,6 @@ void SourceViewerWidget::updateSelection()
 		return;
 	}
 
-	int findTextResultsAmount(0);
 	QTextEdit::ExtraSelection currentResultSelection;
 	currentResultSelection.format.setBackground(QColor(255, 150, 50));
 	currentResultSelection.format.setProperty(QTextFormat::FullWidthSelection, true);
@@ -439,39 +565,38 @@ void SourceViewerWidget::updateSelection()
 
 	extraSelections.append(currentResultSelection);
 
-	QTextCursor textCursor(this->textCursor());
-	textCursor.setPosition(0);
-
 	if (m_findFlags.testFlag(WebWidget::HighlightAllFind))
 	{
-		QTextDocument::FindFlags nativeFlags;
+		updateFindResults();
 
-		if (m_findFlags.testFlag(WebWidget::CaseSensitiveFind))
-		{
-			nativeFlags |= QTextDocument::FindCaseSensitively;
-		}
+		const QTextBlock lastBlock(getLastVisibleBlock());
+		const int lastPosition(lastBlock.position() + lastBlock.length());
+		QVector<int>::const_iterator iterator(std::lower_bound(m_findResults.constBegin(), m_findResults.constEnd(), firstVisibleBlock().position()));
 
-		while (!textCursor.isNull())
+		while (iterator != m_findResults.constEnd() && *iterator < lastPosition)
 		{
-			textCursor = document()->find(m_findText, textCursor, nativeFlags);
+			QTextCursor textCursor(document());
+			textCursor.setPosition(*iterator);
+			textCursor.setPosition((*iterator + m_findText.length()), QTextCursor::KeepAnchor);
 
-			if (!textCursor.isNull())
+			if (textCursor != m_findTextSelection)
 			{
-				if (textCursor != m_findTextSelection)
-				{
-					QTextEdit::ExtraSelection extraResultSelection;
-					extraResultSelection.format.setBackground(QColor(255, 255, 0));
-					extraResultSelection.cursor = textCursor;
-
-					extraSelections.append(extraResultSelection);
-				}
+				QTextEdit::ExtraSelection extraResultSelection;
+				extraResultSelection.format.setBackground(QColor(255, 255, 0));
+				extraResultSelection.cursor = textCursor;
 
-				++findTextResultsAmount;
+				extraSelections.append(extraResultSelection);
 			}
+
+			++iterator;
 		}
-	}
 
-	m_findTextResultsAmount = findTextResultsAmount;
+		m_findTextResultsAmount = m_findResults.count();
+	}
+	else
+	{
+		m_findTextResultsAmount = 0;
+	}
 
 	setExtraSelections(extraSelections);
 }
@@ -492,10 +617,17 @@ void SourceViewerWidget::setZoom(int zoom)
 			m_marginWidget->setFont(font);
 		}
 
+		updateVisibleRange();
+
 		emit zoomChanged(zoom);
 	}
 }
 
+QTextBlock SourceViewerWidget::getLastVisibleBlock() const
+{
+	return cursorForPosition(QPoint((viewport()->width() - 1), (viewport()->height() - 1))).block();
+}
+
 int SourceViewerWidget::getZoom() const
 {
 	return m_zoom;
@@ -510,36 +642,34 @@ int SourceViewerWidget::findText(const QString &text, WebWidget::FindFlags flags
 
 	if (!text.isEmpty())
 	{
-		QTextDocument::FindFlags nativeFlags;
-
-		if (flags.testFlag(WebWidget::BackwardFind))
-		{
-			nativeFlags |= QTextDocument::FindBackward;
-		}
-
-		if (flags.testFlag(WebWidget::CaseSensitiveFind))
-		{
-			nativeFlags |= QTextDocument::FindCaseSensitively;
-		}
+		updateFindResults();
 
+		const bool isBackward(flags.testFlag(WebWidget::BackwardFind));
 		QTextCursor findTextCursor(m_findTextAnchor);
 
-		if (!isTheSame)
+		if (!isTheSame || findTextCursor.isNull())
 		{
 			findTextCursor = textCursor();
 		}
-		else if (!flags.testFlag(WebWidget::BackwardFind))
-		{
-			findTextCursor.setPosition(findTextCursor.selectionEnd(), QTextCursor::MoveAnchor);
-		}
 
-		m_findTextAnchor = document()->find(text, findTextCursor, nativeFlags);
+		m_findTextAnchor = QTextCursor();
 
-		if (m_findTextAnchor.isNull())
+		if (!m_findResults.isEmpty())
 		{
+			QVector<int>::const_iterator iterator(std::lower_bound(m_findResults.constBegin(), m_findResults.constEnd(), (isBackward ? findTextCursor.selectionStart() : findTextCursor.selectionEnd())));
+
+			if (isBackward)
+			{
+				iterator = ((iterator == m_findResults.constBegin()) ? m_findResults.constEnd() : iterator) - 1;
+			}
+			else if (iterator == m_findResults.constEnd())
+			{
+				iterator = m_findResults.constBegin();
+			}
+
 			m_findTextAnchor = textCursor();
-			m_findTextAnchor.setPosition((flags.testFlag(WebWidget::BackwardFind) ? (document()->characterCount() - 1) : 0), QTextCursor::MoveAnchor);
-			m_findTextAnchor = document()->find(text, m_findTextAnchor, nativeFlags);
+			m_findTextAnchor.setPosition(*iterator);
+			m_findTextAnchor.setPosition((*iterator + text.length()), QTextCursor::KeepAnchor);
 		}
 
 		if (!m_findTextAnchor.isNull())
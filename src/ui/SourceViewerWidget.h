@@ -23,6 +23,7 @@
 #include "WebWidget.h"
 
 #include <QtGui/QSyntaxHighlighter>
+#include <QtGui/QTextBlock>
 #include <QtWidgets/QPlainTextEdit>
 
 namespace Otter
@@ -53,20 +54,31 @@ public:
 		CommentState
 	};
 
+	enum BlockState
+	{
+		PendingBlockState = -2
+	};
+
 	struct BlockData final : public QTextBlockUserData
 	{
 		QString context;
 		HighlightingSyntax currentSyntax = HtmlSyntax;
 		HighlightingSyntax previousSyntax = HtmlSyntax;
 		HighlightingState state = NoState;
+		bool isFormatted = true;
 	};
 
 	explicit SyntaxHighlighter(QTextDocument *parent);
 
+	void setHighlightingRange(int firstBlock, int lastBlock);
+
 protected:
 	void highlightBlock(const QString &text) override;
 
 private:
+	int m_firstHighlightedBlock;
+	int m_lastHighlightedBlock;
+
 	static QMap<HighlightingSyntax, QMap<HighlightingState, QTextCharFormat> > m_formats;
 };
 
@@ -110,20 +122,29 @@ protected:
 	void resizeEvent(QResizeEvent *event) override;
 	void focusInEvent(QFocusEvent *event) override;
 	void wheelEvent(QWheelEvent *event) override;
+	void updateFindResults();
+	QTextBlock getLastVisibleBlock() const;
 
 protected slots:
 	void handleOptionChanged(int identifier, const QVariant &value);
 	void updateTextCursor();
+	void updateVisibleRange();
 	void updateSelection();
 
 private:
 	MarginWidget *m_marginWidget;
+	SyntaxHighlighter *m_syntaxHighlighter;
 	QString m_findText;
+	QString m_findResultsText;
 	QTextCursor m_findTextAnchor;
 	QTextCursor m_findTextSelection;
+	QVector<int> m_findResults;
 	WebWidget::FindFlags m_findFlags;
+	Qt::CaseSensitivity m_findResultsCaseSensitivity;
+	int m_findResultsRevision;
 	int m_findTextResultsAmount;
 	int m_zoom;
+	bool m_isUpdatingVisibleRange;
 
 signals:
 	void zoomChanged(int zoom);
@@ -78,6 +78,7 @@ QVariant TextBrowserWidget::loadResource(int type, const QUrl &url)
 	m_resources.insert(url);
 
 	DataFetchJob *job(new DataFetchJob(url, this));
+	job->setPriority(FetchJob::UserPriority);
 
 	connect(job, &DataFetchJob::jobFinished, [=](bool isSuccess)
 	{
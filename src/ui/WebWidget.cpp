@@ -1436,6 +1436,11 @@ QVector<NetworkManager::ResourceInformation> WebWidget::getBlockedRequests() con
 	return {};
 }
 
+QVector<NetworkManager::RequestTimingInformation> WebWidget::getRequestTimings() const
+{
+	return {};
+}
+
 QHash<int, QVariant> WebWidget::getOptions() const
 {
 	return m_options;
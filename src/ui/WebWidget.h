@@ -237,6 +237,7 @@ public:
 	virtual QVector<LinkUrl> getLinks() const;
 	virtual QVector<LinkUrl> getSearchEngines() const;
 	virtual QVector<NetworkManager::ResourceInformation> getBlockedRequests() const;
+	virtual QVector<NetworkManager::RequestTimingInformation> getRequestTimings() const;
 	QHash<int, QVariant> getOptions() const;
 	virtual QMap<QByteArray, QByteArray> getHeaders() const;
 	virtual QMultiMap<QString, QString> getMetaData() const;
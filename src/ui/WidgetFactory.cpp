@@ -49,6 +49,7 @@
 #include "../modules/windows/pageInformation/PageInformationContentsWidget.h"
 #include "../modules/windows/passwords/PasswordsContentsWidget.h"
 #include "../modules/windows/preferences/PreferencesContentsWidget.h"
+#include "../modules/windows/startup/StartupContentsWidget.h"
 #include "../modules/windows/tabHistory/TabHistoryContentsWidget.h"
 #include "../modules/windows/transfers/TransfersContentsWidget.h"
 #include "../modules/windows/web/WebContentsWidget.h"
@@ -253,6 +254,11 @@ ContentsWidget* createContentsWidget(const QString &identifier, const QVariantMa
 		return new PreferencesContentsWidget(parameters, window, parent);
 	}
 
+	if (identifier == QLatin1String("startup"))
+	{
+		return new StartupContentsWidget(parameters, window, parent);
+	}
+
 	if (identifier == QLatin1String("transfers"))
 	{
 		return new TransfersContentsWidget(parameters, window, parent);
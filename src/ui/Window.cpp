@@ -252,6 +252,8 @@ void Window::markAsActive(bool updateLastActivity)
 
 	if (!m_contentsWidget)
 	{
+		m_session.decodeHistory();
+
 		setUrl(m_session.getUrl(), false);
 	}
 
@@ -410,6 +412,10 @@ void Window::setZoom(int zoom)
 	{
 		m_contentsWidget->setZoom(zoom);
 	}
+	else if (!m_session.encodedHistory.isEmpty())
+	{
+		m_session.encodedEntry.zoom = zoom;
+	}
 	else if (m_session.historyIndex >= 0 && m_session.historyIndex < m_session.history.count())
 	{
 		m_session.history[m_session.historyIndex].zoom = zoom;
@@ -472,6 +478,8 @@ void Window::setContentsWidget(ContentsWidget *widget)
 
 		if (m_session.historyIndex >= 0)
 		{
+			m_session.decodeHistory();
+
 			history.index = m_session.historyIndex;
 			history.entries = m_session.history;
 		}
@@ -681,7 +689,7 @@ WindowHistoryInformation Window::getHistory() const
 	}
 
 	WindowHistoryInformation history;
-	history.entries = m_session.history;
+	history.entries = m_session.getHistory();
 	history.index = m_session.historyIndex;
 
 	return history;
@@ -214,6 +214,26 @@ ContentBlockingDialog::ContentBlockingDialog(QWidget *parent) : Dialog(parent),
 	}
 
 	m_ui->customRulesViewWidget->setModel(customRulesModel);
+
+	const QVector<ContentFiltersProfile*> fraudCheckingProfiles(ContentFiltersManager::getFraudCheckingProfiles());
+	QStandardItemModel *fraudCheckingModel(new QStandardItemModel(this));
+	fraudCheckingModel->setHorizontalHeaderLabels({tr("Title"), tr("Update Interval"), tr("Last Update")});
+
+	for (int i = 0; i < fraudCheckingProfiles.count(); ++i)
+	{
+		const ContentFiltersProfile *profile(fraudCheckingProfiles.at(i));
+		QList<QStandardItem*> profileItems({new QStandardItem(profile->getTitle()), new QStandardItem(QString::number(profile->getUpdateInterval())), new QStandardItem(Utils::formatDateTime(profile->getLastUpdate()))});
+		profileItems[0]->setData(profile->getName(), ContentFiltersManager::NameRole);
+		profileItems[0]->setData(profile->getUpdateUrl(), ContentFiltersManager::UpdateUrlRole);
+		profileItems[0]->setFlags(Qt::ItemNeverHasChildren | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+		profileItems[1]->setFlags(Qt::ItemNeverHasChildren | Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable);
+		profileItems[2]->setFlags(Qt::ItemNeverHasChildren | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+
+		fraudCheckingModel->appendRow(profileItems);
+	}
+
+	m_ui->fraudCheckingViewWidget->setModel(fraudCheckingModel);
+	m_ui->fraudCheckingViewWidget->setItemDelegateForColumn(1, new ContentBlockingIntervalDelegate(this));
 	m_ui->enableWildcardsCheckBox->setChecked(SettingsManager::getOption(SettingsManager::ContentBlocking_EnableWildcardsOption).toBool());
 
 	connect(ContentFiltersManager::getInstance(), &ContentFiltersManager::profileModified, this, &ContentBlockingDialog::handleProfileModified);
@@ -222,6 +242,9 @@ ContentBlockingDialog::ContentBlockingDialog(QWidget *parent) : Dialog(parent),
 	connect(m_ui->editProfileButton, &QPushButton::clicked, this, &ContentBlockingDialog::editProfile);
 	connect(m_ui->updateProfileButton, &QPushButton::clicked, this, &ContentBlockingDialog::updateProfile);
 	connect(m_ui->removeProfileButton, &QPushButton::clicked, this, &ContentBlockingDialog::removeProfile);
+	connect(m_ui->fraudCheckingViewWidget->selectionModel(), &QItemSelectionModel::currentChanged, this, &ContentBlockingDialog::updateFraudCheckingActions);
+	connect(m_ui->editFraudCheckingProfileButton, &QPushButton::clicked, this, &ContentBlockingDialog::editFraudCheckingProfile);
+	connect(m_ui->updateFraudCheckingProfileButton, &QPushButton::clicked, this, &ContentBlockingDialog::updateFraudCheckingProfile);
 	connect(m_ui->confirmButtonBox, &QDialogButtonBox::accepted, this, &ContentBlockingDialog::save);
 	connect(m_ui->confirmButtonBox, &QDialogButtonBox::rejected, this, &ContentBlockingDialog::close);
 	connect(m_ui->enableCustomRulesCheckBox, &QCheckBox::toggled, this, &ContentBlockingDialog::updateRulesActions);
@@ -231,6 +254,7 @@ ContentBlockingDialog::ContentBlockingDialog(QWidget *parent) : Dialog(parent),
 	connect(m_ui->removeRuleButton, &QPushButton::clicked, this, &ContentBlockingDialog::removeRule);
 
 	updateRulesActions();
+	updateDecisionCacheStatistics();
 }
 
 ContentBlockingDialog::~ContentBlockingDialog()
@@ -245,6 +269,8 @@ void ContentBlockingDialog::changeEvent(QEvent *event)
 	if (event->type() == QEvent::LanguageChange)
 	{
 		m_ui->retranslateUi(this);
+
+		updateDecisionCacheStatistics();
 	}
 }
 
@@ -341,6 +367,47 @@ void ContentBlockingDialog::updateProfilesActions()
 	m_ui->updateProfileButton->setEnabled(index.isValid() && index.data(ContentFiltersManager::UpdateUrlRole).toUrl().isValid());
 }
 
+void ContentBlockingDialog::editFraudCheckingProfile()
+{
+	const QModelIndex index(m_ui->fraudCheckingViewWidget->currentIndex().sibling(m_ui->fraudCheckingViewWidget->currentIndex().row(), 0));
+	ContentFiltersProfile *profile(getFraudCheckingProfile(index));
+
+	if (!profile)
+	{
+		return;
+	}
+
+	ContentBlockingProfileDialog dialog(this, profile);
+
+	if (dialog.exec() == QDialog::Accepted)
+	{
+		m_ui->fraudCheckingViewWidget->setData(index, profile->getTitle(), Qt::DisplayRole);
+		m_ui->fraudCheckingViewWidget->setData(index, profile->getUpdateUrl(), ContentFiltersManager::UpdateUrlRole);
+		m_ui->fraudCheckingViewWidget->setData(index.sibling(index.row(), 1), profile->getUpdateInterval(), Qt::DisplayRole);
+
+		updateFraudCheckingActions();
+	}
+}
+
+void ContentBlockingDialog::updateFraudCheckingProfile()
+{
+	ContentFiltersProfile *profile(getFraudCheckingProfile(m_ui->fraudCheckingViewWidget->currentIndex()));
+
+	if (profile && profile->update())
+	{
+		m_ui->updateFraudCheckingProfileButton->setEnabled(false);
+	}
+}
+
+void ContentBlockingDialog::updateFraudCheckingActions()
+{
+	const QModelIndex index(m_ui->fraudCheckingViewWidget->currentIndex().sibling(m_ui->fraudCheckingViewWidget->currentIndex().row(), 0));
+	const ContentFiltersProfile *profile(getFraudCheckingProfile(index));
+
+	m_ui->editFraudCheckingProfileButton->setEnabled(profile != nullptr);
+	m_ui->updateFraudCheckingProfileButton->setEnabled(profile && !profile->isUpdating() && index.data(ContentFiltersManager::UpdateUrlRole).toUrl().isValid());
+}
+
 void ContentBlockingDialog::addRule()
 {
 	m_ui->customRulesViewWidget->insertRow();
@@ -411,12 +478,46 @@ void ContentBlockingDialog::updateModel(ContentFiltersProfile *profile, bool isN
 	m_ui->profilesViewWidget->setData(currentIndex.sibling(currentIndex.row(), 2), Utils::formatDateTime(profile->getLastUpdate()), Qt::DisplayRole);
 }
 
+void ContentBlockingDialog::updateDecisionCacheStatistics()
+{
+	const ContentFiltersManager::DecisionCacheStatistics statistics(ContentFiltersManager::getDecisionCacheStatistics());
+
+	if (statistics.lookupsAmount == 0)
+	{
+		m_ui->decisionCacheLabel->setText(tr("Decisions cache: no lookups yet"));
+
+		return;
+	}
+
+	m_ui->decisionCacheLabel->setText(tr("Decisions cache: %1 of %2 lookups answered from cache (%3%), %4 entries").arg(statistics.hitsAmount).arg(statistics.lookupsAmount).arg(((statistics.hitsAmount * 100.0) / statistics.lookupsAmount), 0, 'f', 1).arg(statistics.entriesAmount));
+}
+
 void ContentBlockingDialog::handleProfileModified(const QString &name)
 {
 	const ContentFiltersProfile *profile(ContentFiltersManager::getProfile(name));
 
 	if (!profile)
 	{
+		for (int i = 0; i < m_ui->fraudCheckingViewWidget->getRowCount(); ++i)
+		{
+			const QModelIndex entryIndex(m_ui->fraudCheckingViewWidget->getIndex(i, 0));
+
+			if (entryIndex.data(ContentFiltersManager::NameRole).toString() == name)
+			{
+				profile = getFraudCheckingProfile(entryIndex);
+
+				if (profile)
+				{
+					m_ui->fraudCheckingViewWidget->setData(entryIndex, profile->getTitle(), Qt::DisplayRole);
+					m_ui->fraudCheckingViewWidget->setData(entryIndex.sibling(i, 2), Utils::formatDateTime(profile->getLastUpdate()), Qt::DisplayRole);
+				}
+
+				break;
+			}
+		}
+
+		updateFraudCheckingActions();
+
 		return;
 	}
 
@@ -532,6 +633,17 @@ void ContentBlockingDialog::save()
 		}
 	}
 
+	for (int i = 0; i < m_ui->fraudCheckingViewWidget->getRowCount(); ++i)
+	{
+		const QModelIndex intervalIndex(m_ui->fraudCheckingViewWidget->getIndex(i, 1));
+		ContentFiltersProfile *profile(getFraudCheckingProfile(intervalIndex));
+
+		if (profile && intervalIndex.data(Qt::EditRole).toInt() != profile->getUpdateInterval())
+		{
+			profile->setUpdateInterval(intervalIndex.data(Qt::EditRole).toInt());
+		}
+	}
+
 	if (m_ui->enableCustomRulesCheckBox->isChecked())
 	{
 		QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("contentBlocking")));
@@ -577,6 +689,22 @@ void ContentBlockingDialog::save()
 	close();
 }
 
+ContentFiltersProfile* ContentBlockingDialog::getFraudCheckingProfile(const QModelIndex &index) const
+{
+	const QString name(index.sibling(index.row(), 0).data(ContentFiltersManager::NameRole).toString());
+	const QVector<ContentFiltersProfile*> profiles(ContentFiltersManager::getFraudCheckingProfiles());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		if (profiles.at(i)->getName() == name)
+		{
+			return profiles.at(i);
+		}
+	}
+
+	return nullptr;
+}
+
 Animation* ContentBlockingDialog::getUpdateAnimation()
 {
 	return m_updateAnimation;
@@ -69,6 +69,8 @@ public:
 protected:
 	void changeEvent(QEvent *event) override;
 	void updateModel(ContentFiltersProfile *profile, bool isNewOrMoved);
+	void updateDecisionCacheStatistics();
+	ContentFiltersProfile* getFraudCheckingProfile(const QModelIndex &index) const;
 
 protected slots:
 	void addProfile();
@@ -76,6 +78,9 @@ protected slots:
 	void removeProfile();
 	void updateProfile();
 	void updateProfilesActions();
+	void editFraudCheckingProfile();
+	void updateFraudCheckingProfile();
+	void updateFraudCheckingActions();
 	void addRule();
 	void editRule();
 	void removeRule();